@@ -0,0 +1,96 @@
+/*
+ * Allocator.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_ALLOCATOR_HH
+#define _LOG4CPP_ALLOCATOR_HH
+
+#include <log4cpp/Portability.hh>
+#include <cstddef>
+
+namespace log4cpp {
+
+    /**
+     * Where log4cpp gets the memory of short lived objects from, like
+     * LoggingEvents on the heap and the shared strings of messages.
+     *
+     * <p>By default blocks come from slabs kept per thread, so that
+     * logging does not contend on malloc(3). A block freed by another
+     * thread, e.g. by an asynchronous appender, goes back to the slabs of
+     * the thread which allocated it. Applications can install their own
+     * Allocator instead, e.g. one using a jemalloc arena.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT Allocator {
+        public:
+
+        /**
+         * Counters of all threads since the program started.
+         **/
+        struct Statistics {
+            /**
+             * The blocks allocated and freed, and their bytes.
+             **/
+            unsigned long allocations;
+            unsigned long deallocations;
+            unsigned long bytesAllocated;
+            unsigned long bytesFreed;
+
+            /**
+             * How often memory was taken from the system or from the
+             * installed Allocator, and how much. These stop growing once
+             * logging reached its steady state. Memory appenders take
+             * for themselves, e.g. for the text their layout formats, is
+             * not counted.
+             **/
+            unsigned long systemAllocations;
+            unsigned long systemBytes;
+        };
+
+        virtual ~Allocator();
+
+        /**
+         * Allocates size bytes, aligned for any type, or throws
+         * std::bad_alloc.
+         **/
+        virtual void* allocate(size_t size) = 0;
+
+        /**
+         * Frees a block allocate() returned, possibly from another thread.
+         **/
+        virtual void deallocate(void* block, size_t size) throw() = 0;
+
+        /**
+         * Installs the Allocator to allocate blocks from. Blocks are always
+         * freed by the Allocator which allocated them, so it must outlive
+         * them.
+         * @param allocator the Allocator, or NULL for the per-thread slabs.
+         **/
+        static void setAllocator(Allocator* allocator);
+
+        /**
+         * @returns the installed Allocator, NULL for the per-thread slabs.
+         **/
+        static Allocator* getAllocator();
+
+        /**
+         * Allocates a block of size bytes from the installed Allocator.
+         **/
+        static void* allocateBlock(size_t size);
+
+        /**
+         * Frees a block allocateBlock() returned.
+         * @param size the size the block was allocated with.
+         **/
+        static void deallocateBlock(void* block, size_t size) throw();
+
+        static Statistics getStatistics();
+    };
+}
+
+#endif // _LOG4CPP_ALLOCATOR_HH
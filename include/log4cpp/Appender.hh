@@ -74,6 +74,15 @@ namespace log4cpp {
          * @param event  The LoggingEvent to log.
          **/
         virtual void doAppend(const LoggingEvent& event) = 0;
+
+        /**
+         * Log a batch of events in Appender specific way. By default, each
+         * event is passed to doAppend().
+         * @param events The LoggingEvents to log, oldest first.
+         * @param count The number of events.
+         * @since 1.1
+         **/
+        virtual void doAppendBatch(const LoggingEvent* const* events, size_t count);
         
         /**
          * Reopens the output destination of this Appender, e.g. the logfile
@@ -131,6 +140,16 @@ namespace log4cpp {
          * @returns the filter, or NULL if no filter has been set.
          **/
         virtual Filter* getFilter() = 0;
+
+        /**
+         * Returns the fields of LoggingEvent, see LoggingEvent::Field,
+         * which this appender uses. Events do not capture fields none of
+         * the appenders they reach need. By default all of them; an
+         * appender whose needs change should call
+         * Category::requiredFieldsChanged().
+         * @since 1.1
+         **/
+        virtual unsigned int getRequiredFields();
         
 		private:
         typedef std::map<std::string, Appender*> AppenderMap;
@@ -13,6 +13,7 @@
 #include <log4cpp/Portability.hh>
 #include <log4cpp/Appender.hh>
 #include <log4cpp/Filter.hh>
+#include <log4cpp/threading/Threading.hh>
 
 namespace log4cpp {
 
@@ -20,6 +21,11 @@ namespace log4cpp {
      * AppenderSkeleton is a helper class, simplifying implementation of
      * Appenders: it already takes care of handling of Thresholds and 
      * Filters. 
+     *
+     * <p>doAppend() serializes the calls to _append() with a mutex of the
+     * appender itself, so an appender attached to several categories is
+     * never entered concurrently, while appenders of unrelated categories
+     * do not contend.
      **/
     class LOG4CPP_EXPORT AppenderSkeleton : public Appender {
         protected:
@@ -42,6 +48,14 @@ namespace log4cpp {
          **/
         virtual void doAppend(const LoggingEvent& event);
 
+        /**
+         * Log a batch of events, applying threshold and filter to each and
+         * passing those accepted to _appendBatch() under a single lock.
+         * @param events The LoggingEvents to log, oldest first.
+         * @param count The number of events.
+         **/
+        virtual void doAppendBatch(const LoggingEvent* const* events, size_t count);
+
         /**
          * Reopens the output destination of this Appender, e.g. the logfile 
          * or TCP socket.
@@ -101,8 +115,24 @@ namespace log4cpp {
          **/
         virtual void _append(const LoggingEvent& event) = 0;
 
-        
+        /**
+         * Log a batch of events in Appender specific way. By default, each
+         * event is passed to _append(). Subclasses may override this
+         * method to write a batch at once.
+         * @param events The LoggingEvents to log, oldest first.
+         * @param count The number of events, at least one.
+         **/
+        virtual void _appendBatch(const LoggingEvent* const* events, size_t count);
+
+        /**
+         * Serializes _append(); subclasses may hold it to exclude logging,
+         * e.g. while reopening their destination.
+         **/
+        threading::Mutex _appendMutex;
+
         private:
+        bool _accepts(const LoggingEvent& event);
+
         Priority::Value _threshold;
         Filter* _filter;
     };
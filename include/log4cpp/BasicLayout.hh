@@ -28,6 +28,8 @@ namespace log4cpp {
          * "timeStamp priority category ndc: message"
          **/
         virtual std::string format(const LoggingEvent& event);
+
+        virtual unsigned int getRequiredFields() const;
     };        
 }
 
@@ -10,35 +10,65 @@
 
 #include <log4cpp/LayoutAppender.hh>
 #include <log4cpp/TriggeringEventEvaluator.hh>
-#include <list>
+#include <vector>
 #include <memory>
 
 namespace log4cpp
 {
-   class LOG4CPP_EXPORT BufferingAppender : public LayoutAppender 
+   /**
+    * BufferingAppender keeps the last max_size events in a ring and passes
+    * them, oldest first, to its sink as one batch when the evaluator
+    * triggers or, unless lossy, when the ring is full. Lossy, the oldest
+    * event gives way to a new one instead.
+    *
+    * <p>The events reach the sink unchanged, to be formatted by the sink's
+    * own layout; the layout of the BufferingAppender is not used.
+    *
+    * <p>Evaluators firing on their own, like an IntervalEvaluator, flush
+    * the buffer without waiting for an event.
+    **/
+   class LOG4CPP_EXPORT BufferingAppender : public LayoutAppender, private TriggeringEventEvaluator::Trigger
    {
       public:
          BufferingAppender(const std::string name, unsigned long max_size, std::auto_ptr<Appender> sink,
                            std::auto_ptr<TriggeringEventEvaluator> evaluator);
+         virtual ~BufferingAppender();
       
          virtual void close() { sink_->close(); }
+
+         // the buffered events go to the sink and the evaluator
+         virtual unsigned int getRequiredFields() { return LoggingEvent::ALL_FIELDS; }
          
          bool getLossy() const { return lossy_; }
          void setLossy(bool lossy) { lossy_ = lossy; }
 
+         /**
+          * Passes the buffered events on to the sink.
+          * @since 1.1
+          **/
+         void flush();
+
       protected:
          virtual void _append(const LoggingEvent& event);
 
       private:
-         typedef std::list<LoggingEvent> queue_t;
-         
-         queue_t queue_;
+         BufferingAppender(const BufferingAppender&);
+         BufferingAppender& operator=(const BufferingAppender&);
+
+         // storage for max_size_ events, of which the size_ starting at
+         // first_ are constructed
+         LoggingEvent* ring_;
+         unsigned long first_;
+         unsigned long size_;
+         std::vector<const LoggingEvent*> batch_;
          unsigned long max_size_;
          std::auto_ptr<Appender> sink_;
          std::auto_ptr<TriggeringEventEvaluator> evaluator_;
          bool lossy_;
 
          void dump();
+         void clear();
+         virtual void trigger();
    };
 }
 
@@ -15,7 +15,10 @@
 #include <log4cpp/LoggingEvent.hh>
 #include <log4cpp/Priority.hh>
 #include <log4cpp/CategoryStream.hh>
+#include <log4cpp/Format.hh>
+#include <log4cpp/PrintfFormat.hh>
 #include <log4cpp/threading/Threading.hh>
+#include <log4cpp/threading/Atomic.hh>
 #include <log4cpp/convenience.h>
 
 #include <map>
@@ -212,11 +215,23 @@ namespace log4cpp {
 
         /**
          * Removes all appenders for this Category.
+         * Owned appenders are deleted once the last concurrent logging
+         * call using them returns, without waiting for it. If the
+         * Category does not own some of them, this returns only once
+         * other threads' logging calls have finished with them, so
+         * such a removal from within an appender must not wait for
+         * the logging thread, e.g. on another appender removing it in
+         * turn.
          **/
         virtual void removeAllAppenders();
 
         /**
          * Removes specified appender for this Category.
+         * An owned appender is deleted once the last concurrent logging
+         * call using it returns, without waiting for it. Otherwise this
+         * returns once other threads' logging calls have finished with
+         * it, so that the caller may delete it; see removeAllAppenders()
+         * for removing it from within an appender.
          * @since 0.2.7
          **/
         virtual void removeAppender(Appender* appender);
@@ -250,6 +265,36 @@ namespace log4cpp {
          * @param event the LogginEvent to log.
          **/
         virtual void callAppenders(const LoggingEvent& event) throw();
+
+        /**
+         * Call the appenders in the hierarchy starting at
+         * <code>this</code> with a batch of events, taking the lock on
+         * the appender set once and passing the batch to each
+         * Appender::doAppendBatch().
+         * @since 1.1
+         * @param events the LoggingEvents to log, oldest first.
+         * @param count the number of events.
+         **/
+        virtual void callAppenders(const LoggingEvent* const* events,
+                                   size_t count) throw();
+
+        /**
+         * Returns the fields of LoggingEvent, see LoggingEvent::Field,
+         * which the appenders in the hierarchy starting at
+         * <code>this</code> use, so that the events of this category
+         * capture only those. The fields are collected again after
+         * requiredFieldsChanged() was called.
+         * @since 1.1
+         **/
+        virtual unsigned int getRequiredFields() throw();
+
+        /**
+         * Tells all categories the fields their appenders require may have
+         * changed, e.g. because an appender got another layout. Categories,
+         * appenders and layouts of log4cpp call it themselves.
+         * @since 1.1
+         **/
+        static void requiredFieldsChanged() throw();
         
         /**
          * Set the additivity flag for this Category instance.
@@ -304,6 +349,68 @@ namespace log4cpp {
         virtual void logva(Priority::Value priority, 
                            const char* stringFormat,
                            va_list va) throw();
+
+        /** 
+         * Log a message with the specified priority, formatted by a
+         * PrintfFormat which was parsed beforehand, usually once per call
+         * site by LOG4CPP_PRINTF.
+         * @since 1.1
+         * @param priority The priority of this log message.
+         * @param format The parsed format.
+         * @param ... The arguments for format.
+         **/  
+        void logPrintf(Priority::Value priority, const PrintfFormat* format,
+                       ...) throw();
+
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+        /** 
+         * Log a message with the specified priority, formatted like
+         * <code>logf(Priority::INFO, "{} took {}ms", name, millis)</code>:
+         * each {} is replaced by the next argument, "{{" and "}}" stand
+         * for single braces. Nothing is formatted unless the priority is
+         * enabled, and messages are formatted on the stack up to
+         * FormatBuffer::stackSize characters. The LOG4CPP_LOGF macro also
+         * checks the arguments against a literal format at compile time.
+         * @since 1.1
+         * @param priority The priority of this log message.
+         * @param format The message with {} placeholders.
+         * @param arguments The arguments for the placeholders.
+         **/  
+        template<typename... Arguments>
+        void logf(Priority::Value priority, const char* format,
+                  const Arguments&... arguments) throw() {
+            if (isPriorityEnabled(priority)) {
+                FormatBuffer buffer;
+                formatTo(buffer, format, arguments...);
+                _logUnconditionally2(priority, buffer.share().str());
+            }
+        }
+#endif
+
+        /** 
+         * Log a batch of messages with the specified priority, e.g. a
+         * dump of a cache. The priority is checked once, the events are
+         * built in an array the calling thread reuses, and each appender
+         * gets the whole batch by Appender::doAppendBatch().
+         * @since 1.1
+         * @param priority The priority of the log messages.
+         * @param begin The first message, a std::string or anything
+         * converting to one, like a const char*.
+         * @param end The end of the messages.
+         **/  
+        template<typename InputIterator>
+        void logBatch(Priority::Value priority, InputIterator begin,
+                      InputIterator end) throw() {
+            if (isPriorityEnabled(priority)) {
+                Batch* batch = _acquireBatch();
+                std::vector<SharedString>& messages = _getBatchMessages(batch);
+                for (; begin != end; ++begin) {
+                    messages.push_back(SharedString(*begin));
+                }
+                _logBatch(priority, batch);
+            }
+        }
+
         
         /** 
          * Log a message with debug priority.
@@ -616,20 +723,72 @@ namespace log4cpp {
         
         /** 
          * Unconditionally log a message with the specified priority.
+         * All the logging methods but logBatch() go through here, so
+         * overriding it still sees every message.
          * @param priority The priority of this log message.
          * @param message string to write in the log file
          **/  
         virtual void _logUnconditionally2(Priority::Value priority, 
                                           const std::string& message) throw();
 
+        /** 
+         * Unconditionally log a shared message with the specified
+         * priority. By default the overload for std::string ends up here,
+         * so this is the one to override to change the events a Category
+         * makes.
+         * @param priority The priority of this log message.
+         * @param message string to write in the log file
+         * @since 1.1
+         **/  
+        virtual void _logUnconditionally2(Priority::Value priority, 
+                                          const SharedString& message) throw();
+
+        /**
+         * Returns the name of this Category, shared by all its events.
+         * @since 1.1
+         **/
+        inline const SharedString& _getSharedName() const throw() {
+            return _name;
+        }
+
+        /**
+         * The messages of a logBatch() call and the events made of
+         * them. Each thread keeps its Batches for reuse.
+         * @since 1.1
+         **/
+        class Batch;
+
+        static Batch* _acquireBatch();
+        static std::vector<SharedString>& _getBatchMessages(Batch* batch);
+
+        /**
+         * Logs the messages of batch, and releases it. Like
+         * _logUnconditionally2(), this is the one to override to change
+         * the events a Category makes.
+         * @since 1.1
+         **/
+        virtual void _logBatch(Priority::Value priority, Batch* batch) throw();
+
+        /**
+         * Makes the events of batch with the given context, calls the
+         * appenders with them, and releases the batch.
+         * @since 1.1
+         **/
+        void _dispatchBatch(Priority::Value priority, Batch* batch,
+                            const NDC::ContextStack& ndc) throw();
+
         private:
 
         /* prevent copying and assignment */
         Category(const Category& other);
         Category& operator=(const Category& other);
 
-        /** The name of this category. */
-        const std::string _name;
+        /**
+         * The name of this category. Categories are unique per name in
+         * their hierarchy, so this is the one copy of the name which all
+         * events of the category share.
+         **/
+        const SharedString _name;
 
         /**
          * The parent of this category. All categories have al least one
@@ -656,6 +815,62 @@ namespace log4cpp {
         AppenderSet _appender;
         mutable threading::Mutex _appenderSetMutex;
 
+        typedef std::vector<Appender*> AppenderList;
+
+        /**
+         * A list of the appenders to call, never modified while published,
+         * and the number of calls iterating over it.
+         **/
+        class Dispatch;
+
+        /**
+         * Publishes the current _appender set for callAppenders(), which
+         * iterates over it without holding _appenderSetMutex. Assumes the
+         * lock is held.
+         * @returns the previous list, for _retireDispatch().
+         **/
+        Dispatch* _updateDispatch();
+
+        /**
+         * Removes all appenders, waiting for the calls using them if
+         * wait is set, as the destructor must.
+         **/
+        void _removeAllAppenders(bool wait);
+
+        /**
+         * Unpublishes a list replaced by _updateDispatch(). The last call
+         * iterating over it keeps it for reuse and deletes the owned
+         * appenders removed with it. Called without the lock.
+         * @param wait whether to wait until no other thread iterates
+         * over the list anymore.
+         **/
+        void _retireDispatch(Dispatch* dispatch, const AppenderList& removed, bool wait);
+
+        /**
+         * Takes the current dispatch list for iterating over it without
+         * the lock, until _releaseDispatch().
+         **/
+        Dispatch* _acquireDispatch() throw();
+        void _releaseDispatch(Dispatch* dispatch) throw();
+        void _dropDispatch(Dispatch* dispatch) throw();
+        void _recycleDispatch(Dispatch* dispatch) throw();
+
+        /**
+         * The fields the appenders in the hierarchy require as of a
+         * generation of requiredFieldsChanged() calls, packed into
+         * generation << 8 | fields.
+         **/
+        threading::Atomic<unsigned long> _requiredFields;
+
+        threading::Atomic<Dispatch*> _dispatch;
+
+        /**
+         * Lists replaced before. Threads may still increment the count of a
+         * list they found published a moment ago, so lists are reused
+         * rather than deleted.
+         **/
+        std::vector<Dispatch*> _spareDispatch;
+
         /**
          * Whether the category holds the ownership of the appender. If so,
          * it deletes the appender in its destructor.
@@ -35,6 +35,13 @@ namespace log4cpp {
     /**
      * This class enables streaming simple types and objects to a category.
      * Use category.errorStream(), etc. to obtain a CategoryStream class.
+     *
+     * <p>Messages are built in a buffer taken from a pool of the calling
+     * thread, which keeps its capacity for the next message, and with
+     * the classic "C" locale. Numbers are converted by NumberFormat
+     * unless the stream was told otherwise, e.g. by std::hex or
+     * std::setprecision(), so doubles come out as the shortest text
+     * which reads back as the same value.
      **/
     class LOG4CPP_EXPORT CategoryStream {
         public:
@@ -80,29 +87,26 @@ namespace log4cpp {
 		  template<typename T> 
         CategoryStream& operator<<(const T& t) {
             if (getPriority() != Priority::NOTSET) {
-                if (!_buffer) {
-					if (!(_buffer = new std::ostringstream)) {
-                        // XXX help help help
-                    }
-                }
-                (*_buffer) << t;
+                _getStream() << t;
             }
             return *this;
         }
 	   
         CategoryStream& operator<<(const char* t);
+        CategoryStream& operator<<(const std::string& t);
+
+        CategoryStream& operator<<(short t);
+        CategoryStream& operator<<(unsigned short t);
+        CategoryStream& operator<<(int t);
+        CategoryStream& operator<<(unsigned int t);
+        CategoryStream& operator<<(long t);
+        CategoryStream& operator<<(unsigned long t);
+        CategoryStream& operator<<(float t);
+        CategoryStream& operator<<(double t);
 
 	     template<typename T> 
  	     CategoryStream& operator<<(const std::string& t) {
-            if (getPriority() != Priority::NOTSET) {
-                if (!_buffer) {
-                    if (!(_buffer = new std::ostringstream)) {
-                        // XXX help help help
-                    }
-                }
-                (*_buffer) << t;
-            }
-            return *this;
+            return (*this) << t;
         }
 #if LOG4CPP_HAS_WCHAR_T != 0
         template<typename T> 
@@ -125,14 +129,26 @@ namespace log4cpp {
 
 
         private:
+        class Stream;
+
+        inline std::ostream& _getStream() {
+            return _out ? *_out : _acquireStream();
+        }
+
+        std::ostream& _acquireStream();
+
+        /**
+         * Appends a converted number, padded to the width of the stream.
+         **/
+        void _appendNumber(const char* number, size_t length);
+
         Category& _category;
         Priority::Value _priority;
-	     union {
-	         std::ostringstream* _buffer;
+        Stream* _stream;
+        std::ostream* _out;
 #if LOG4CPP_HAS_WCHAR_T != 0
-            std::wostringstream* _wbuffer;
+        std::wostringstream* _wbuffer;
 #endif
-        };
 
 	     public:
 	     typedef CategoryStream& (*cspf) (CategoryStream&);
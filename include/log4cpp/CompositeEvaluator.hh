@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#if !defined(h_870e579b_8ac1_45da_b8fe_c902c2d84800)
+#define h_870e579b_8ac1_45da_b8fe_c902c2d84800
+
+#include <log4cpp/TriggeringEventEvaluator.hh>
+#include <vector>
+#include <memory>
+
+namespace log4cpp
+{
+   /**
+    * Combines evaluators, which it owns. Each event is passed to all of
+    * them, so that counting evaluators see every event. Triggers fired
+    * by the evaluators on their own pass through unconditionally.
+    * @since 1.1
+    **/
+   class LOG4CPP_EXPORT CompositeEvaluator : public TriggeringEventEvaluator
+   {
+      public:
+         virtual ~CompositeEvaluator();
+
+         void add(std::auto_ptr<TriggeringEventEvaluator> evaluator);
+
+         virtual void attach(Trigger* trigger);
+         virtual void reset() const;
+
+      protected:
+         CompositeEvaluator() {}
+
+         typedef std::vector<TriggeringEventEvaluator*> evaluators_t;
+         evaluators_t evaluators_;
+
+      private:
+         CompositeEvaluator(const CompositeEvaluator&);
+         CompositeEvaluator& operator=(const CompositeEvaluator&);
+   };
+
+   /**
+    * Triggers when all of its evaluators do.
+    * @since 1.1
+    **/
+   class LOG4CPP_EXPORT AndEvaluator : public CompositeEvaluator
+   {
+      public:
+         virtual bool eval(const LoggingEvent& event) const;
+   };
+
+   /**
+    * Triggers when any of its evaluators does.
+    * @since 1.1
+    **/
+   class LOG4CPP_EXPORT OrEvaluator : public CompositeEvaluator
+   {
+      public:
+         virtual bool eval(const LoggingEvent& event) const;
+   };
+}
+
+#endif // h_870e579b_8ac1_45da_b8fe_c902c2d84800
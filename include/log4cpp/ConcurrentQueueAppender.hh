@@ -0,0 +1,120 @@
+/*
+ * ConcurrentQueueAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_CONCURRENTQUEUEAPPENDER_HH
+#define _LOG4CPP_CONCURRENTQUEUEAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+#include <string>
+#include <vector>
+#include <log4cpp/LayoutAppender.hh>
+#include <log4cpp/threading/Atomic.hh>
+
+namespace log4cpp {
+
+    /**
+     * ConcurrentQueueAppender puts formatted messages into a bounded
+     * in-memory queue which any number of threads may append to and consume
+     * from concurrently, without locks.
+     *
+     * <p>Unlike StringQueueAppender, messages are moved rather than copied
+     * in and out of the queue and consumers may take them in batches. When
+     * the queue is full, messages are dropped and counted as overflows.
+     * Optionally, an eventfd becomes readable when messages arrive, so that
+     * consumers can wait for them in poll or epoll.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT ConcurrentQueueAppender : public LayoutAppender {
+        public:
+
+        static const size_t DEFAULT_CAPACITY;
+
+        /**
+         * Instantiate a ConcurrentQueueAppender.
+         * @param name The name of the Appender.
+         * @param capacity The maximum number of queued messages, rounded up
+         * to a power of two.
+         * @param eventFd Whether to signal arrivals through an eventfd;
+         * ignored where eventfd is not available.
+         **/
+        ConcurrentQueueAppender(const std::string& name,
+                                size_t capacity = DEFAULT_CAPACITY,
+                                bool eventFd = false);
+        virtual ~ConcurrentQueueAppender();
+
+        virtual bool reopen();
+        virtual void close();
+
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
+        /**
+         * Appends without taking the appender lock unless a filter is set;
+         * the layout must be safe to use from several threads, as the
+         * layouts of log4cpp are.
+         **/
+        virtual void doAppend(const LoggingEvent& event);
+
+        /**
+         * Moves the oldest message into message.
+         * @returns false if the queue was empty.
+         **/
+        bool popMessage(std::string& message);
+
+        /**
+         * Moves up to max of the oldest messages to the end of messages.
+         * @returns the number of messages moved.
+         **/
+        size_t drain(std::vector<std::string>& messages, size_t max);
+
+        /**
+         * Returns the approximate number of queued messages.
+         **/
+        size_t queueSize() const;
+
+        size_t getCapacity() const;
+
+        /**
+         * Returns the number of messages dropped because the queue was full.
+         **/
+        unsigned long getOverflows() const;
+
+        /**
+         * Returns the eventfd which becomes readable when messages arrive,
+         * or -1. A consumer woken by it must drain the queue until empty,
+         * as it is signalled again only after that.
+         **/
+        int getEventFd() const;
+
+        protected:
+        virtual void _append(const LoggingEvent& event);
+        bool _pop(std::string& message);
+
+        struct Cell {
+            threading::Atomic<size_t> sequence;
+            std::string message;
+        };
+
+        const size_t _mask;
+        Cell* _cells;
+        threading::Atomic<size_t> _enqueuePosition;
+        threading::Atomic<size_t> _dequeuePosition;
+        threading::Atomic<unsigned long> _overflows;
+        threading::Atomic<bool> _signalled;
+        int _eventFd;
+
+        private:
+        ConcurrentQueueAppender(const ConcurrentQueueAppender& other);
+        ConcurrentQueueAppender& operator=(const ConcurrentQueueAppender& other);
+    };
+}
+
+#endif // _LOG4CPP_CONCURRENTQUEUEAPPENDER_HH
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#if !defined(h_f845df63_c430_4b29_af5b_cbf5b3443705)
+#define h_f845df63_c430_4b29_af5b_cbf5b3443705
+
+#include <log4cpp/TriggeringEventEvaluator.hh>
+
+namespace log4cpp
+{
+   /**
+    * Triggers on every count-th event since the last batch.
+    * @since 1.1
+    **/
+   class LOG4CPP_EXPORT CountEvaluator : public TriggeringEventEvaluator
+   {
+      public:
+         CountEvaluator(unsigned long count) : count_(count ? count : 1), seen_(0) {}
+         virtual bool eval(const LoggingEvent&) const { return ++seen_ >= count_; }
+         virtual void reset() const { seen_ = 0; }
+
+      private:
+         unsigned long count_;
+         mutable unsigned long seen_;
+   };
+}
+
+#endif // h_f845df63_c430_4b29_af5b_cbf5b3443705
@@ -35,6 +35,8 @@ namespace log4cpp {
         static unsigned int maxDaysToKeepDefault;
         protected:
         virtual void _append(const LoggingEvent& event);
+        virtual void _appendBatch(const LoggingEvent* const* events, size_t count);
+        void _rollOverIfNewDay();
 
         unsigned int _maxDaysToKeep;
         // last log's file creation time (or last modification if appender just created)
@@ -0,0 +1,121 @@
+/*
+ * EventCodec.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_EVENTCODEC_HH
+#define _LOG4CPP_EVENTCODEC_HH
+
+#include <log4cpp/Portability.hh>
+#include <string>
+#include <memory>
+#include <log4cpp/LoggingEvent.hh>
+
+namespace log4cpp {
+
+    /**
+     * EventCodec defines the binary representation of LoggingEvents used
+     * to forward them to another process, e.g. by the SocketEventAppender.
+     *
+     * <p>A stream consists of blocks. Each block starts with a 16 byte
+     * header: the magic "L4EB", a version byte, a compression byte, two
+     * reserved bytes, the uncompressed and the stored length of the block
+     * contents as 32 bit little endian integers. The contents are a
+     * sequence of event records, each a 32 bit length followed by the
+     * priority (32 bit), the seconds (64 bit) and nanoseconds (32 bit) of
+     * the time stamp and the category name, thread name, NDC and message
+     * as length prefixed strings. Since version 2 the message is followed
+     * by the number of MDC entries (32 bit) and the key and value of each
+     * as length prefixed strings. All integers are little endian.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT EventCodec {
+        public:
+
+        typedef enum {
+            NONE = 0,
+            ZLIB = 1
+        } Compression;
+
+        static const size_t BLOCK_HEADER_SIZE;
+
+        /**
+         * Returns whether the given compression is available in this
+         * build.
+         **/
+        static bool isSupported(Compression compression);
+
+        /**
+         * Appends the record for the given event to the buffer.
+         **/
+        static void encode(const LoggingEvent& event, std::string& buffer);
+
+        /**
+         * Appends a block holding the given records to the output. Falls
+         * back to storing the records uncompressed if compression is
+         * unavailable or does not pay off.
+         **/
+        static void encodeBlock(const std::string& records, Compression compression,
+                                std::string& output);
+    };
+
+    /**
+     * EventStreamDecoder reconstructs LoggingEvents from a stream of blocks
+     * written by EventCodec. The stream may be fed in arbitrary pieces, e.g.
+     * as read from a socket.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT EventStreamDecoder {
+        public:
+        EventStreamDecoder();
+
+        /**
+         * Adds received bytes to the decoder.
+         **/
+        void feed(const char* data, size_t length);
+
+        /**
+         * Decodes the next complete event.
+         * @returns false if no complete event is available or the stream
+         * is corrupt.
+         **/
+        bool next(std::auto_ptr<LoggingEvent>& event);
+
+        /**
+         * Decodes all complete events and passes each to the appenders of
+         * the Category of the same name in the local hierarchy, honoring
+         * its priority.
+         * @returns the number of events decoded.
+         **/
+        size_t dispatch();
+
+        /**
+         * Returns whether the stream was found to be corrupt. A corrupt
+         * decoder does not decode any further events; the connection it
+         * reads from should be closed.
+         **/
+        bool isCorrupt() const;
+
+        private:
+        EventStreamDecoder(const EventStreamDecoder&);
+        EventStreamDecoder& operator=(const EventStreamDecoder&);
+
+        bool _nextBlock();
+
+        std::string _input;
+        size_t _inputPosition;
+        std::string _uncompressed;
+        const std::string* _records;    // _input or _uncompressed
+        size_t _recordPosition;
+        size_t _recordEnd;
+        char _blockVersion;
+        bool _corrupt;
+    };
+}
+
+#endif // _LOG4CPP_EVENTCODEC_HH
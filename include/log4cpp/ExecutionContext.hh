@@ -0,0 +1,95 @@
+/*
+ * ExecutionContext.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_EXECUTIONCONTEXT_HH
+#define _LOG4CPP_EXECUTIONCONTEXT_HH
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/MDC.hh>
+
+namespace log4cpp {
+
+    /**
+     * The diagnostic contexts, NDC and MDC, of a unit of execution. By
+     * default each thread has its own, but coroutines and fibers, which
+     * share threads, can keep their own ExecutionContext and make it
+     * current whenever they run, either by swapping it in and out on
+     * resume and suspend, or by installing a Storage that finds the
+     * context of whatever is running.
+     *
+     * <p>For example, a coroutine's promise can own an ExecutionContext,
+     * call <code>previous = ExecutionContext::swap(&context)</code> when
+     * resumed and <code>ExecutionContext::swap(previous)</code> when
+     * suspended, which costs a pointer swap each.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT ExecutionContext {
+        public:
+
+        /**
+         * Finds the ExecutionContext of the fiber or coroutine running on
+         * the calling thread.
+         **/
+        class LOG4CPP_EXPORT Storage {
+            public:
+            virtual ~Storage();
+
+            /**
+             * Returns the current ExecutionContext, or NULL to use the one
+             * of the calling thread.
+             **/
+            virtual ExecutionContext* get() = 0;
+        };
+
+        ExecutionContext();
+        virtual ~ExecutionContext();
+
+        inline NDC& getNDC() {
+            return _ndc;
+        }
+
+        inline MDC& getMDC() {
+            return _mdc;
+        }
+
+        /**
+         * Returns the ExecutionContext of the calling fiber, coroutine or
+         * thread.
+         **/
+        static ExecutionContext& getCurrent();
+
+        /**
+         * Makes context the current one of the calling thread, until
+         * swapped out again. A Storage takes precedence over it.
+         * @param context the ExecutionContext to make current, or NULL
+         * for the thread's own one.
+         * @returns the previously current ExecutionContext, NULL if it
+         * was the thread's own.
+         **/
+        static ExecutionContext* swap(ExecutionContext* context);
+
+        /**
+         * Installs the Storage finding the current ExecutionContext,
+         * e.g. a fiber-local pointer. The storage is not owned and must
+         * outlive its use.
+         * @param storage the Storage, or NULL for thread-local contexts.
+         **/
+        static void setStorage(Storage* storage);
+
+        private:
+        ExecutionContext(const ExecutionContext& other);
+        ExecutionContext& operator=(const ExecutionContext& other);
+
+        NDC _ndc;
+        MDC _mdc;
+    };
+}
+
+#endif // _LOG4CPP_EXECUTIONCONTEXT_HH
@@ -54,6 +54,11 @@ namespace log4cpp {
         **/
         virtual void close();
 
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
         /**
            Sets the append vs truncate flag.
            NB. currently the FileAppender opens the logfile in the 
@@ -82,6 +87,11 @@ namespace log4cpp {
         protected:
         virtual void _append(const LoggingEvent& event);
 
+        /**
+         * Writes the formatted batch with a single write.
+         **/
+        virtual void _appendBatch(const LoggingEvent* const* events, size_t count);
+
         const std::string _fileName;
         int _fd;
         int _flags;
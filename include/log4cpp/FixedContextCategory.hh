@@ -137,6 +137,20 @@ namespace log4cpp {
          * @param event The LoggingEvent to log.
          **/
         virtual void callAppenders(const LoggingEvent& event) throw();
+
+        /**
+         * Call the appenders of the delegate category with a batch of
+         * events.
+         * @since 1.1
+         **/
+        virtual void callAppenders(const LoggingEvent* const* events,
+                                   size_t count) throw();
+
+        /**
+         * Returns the fields the appenders of the delegate category use.
+         * @since 1.1
+         **/
+        virtual unsigned int getRequiredFields() throw();
         
         /**
          * Set the additivity flag for this Category instance.
@@ -156,7 +170,13 @@ namespace log4cpp {
          * @param message string to write in the log file
          **/  
         virtual void _logUnconditionally2(Priority::Value priority, 
-                                          const std::string& message) throw();
+                                          const SharedString& message) throw();
+
+        /**
+         * Logs the messages of batch with the fixed context.
+         * @since 1.1
+         **/
+        virtual void _logBatch(Priority::Value priority, Batch* batch) throw();
 
         private:
 
@@ -166,7 +186,7 @@ namespace log4cpp {
         Category& _delegate;
 
         /** The context of this FixedContextCategory. */
-         std::string _context;
+         NDC::ContextStack _context;
 
     };
 
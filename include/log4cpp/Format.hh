@@ -0,0 +1,327 @@
+/*
+ * Format.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_FORMAT_HH
+#define _LOG4CPP_FORMAT_HH
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/SharedString.hh>
+#include <string>
+#include <cstring>
+#include <cstdarg>
+#include <stdint.h>
+
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+#include <sstream>
+#endif
+
+namespace log4cpp {
+
+    /**
+     * Conversions of numbers to characters, which unlike iostreams and
+     * printf(3) do not depend on the locale. They write at most
+     * maxLength characters, without terminating them.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT NumberFormat {
+        public:
+        static const size_t maxLength = 32;
+
+        /**
+         * @returns the number of characters written.
+         **/
+        static size_t formatInteger(char* out, int64_t value);
+        static size_t formatUnsigned(char* out, uint64_t value);
+
+        /**
+         * Formats value with at least the given number of digits,
+         * padded with leading zeros, e.g. for milliseconds.
+         **/
+        static size_t formatUnsigned(char* out, uint64_t value,
+                                     unsigned int minDigits);
+
+        /**
+         * Formats the shortest decimal representation which reads back
+         * as value, without exponent for integral values below 1e15.
+         **/
+        static size_t formatDouble(char* out, double value);
+        static size_t formatFloat(char* out, float value);
+    };
+
+    /**
+     * A buffer to format a message into. Messages up to stackSize
+     * characters stay in the buffer itself, which usually lives on the
+     * stack; only longer ones go to the heap.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT FormatBuffer {
+        public:
+        static const size_t stackSize = 512;
+
+        FormatBuffer();
+        ~FormatBuffer();
+
+        inline void append(char c) {
+            _reserve(1);
+            _data[_size++] = c;
+        }
+
+        inline void append(const char* characters, size_t length) {
+            _reserve(length);
+            std::memcpy(_data + _size, characters, length);
+            _size += length;
+        }
+
+        inline void append(const std::string& value) {
+            append(value.data(), value.size());
+        }
+
+        /**
+         * Appends a C string, or "(null)".
+         **/
+        void append(const char* value);
+
+        /**
+         * Append numbers as NumberFormat formats them.
+         **/
+        inline void appendInteger(int64_t value) {
+            _reserve(NumberFormat::maxLength);
+            _size += NumberFormat::formatInteger(_data + _size, value);
+        }
+
+        inline void appendUnsigned(uint64_t value) {
+            _reserve(NumberFormat::maxLength);
+            _size += NumberFormat::formatUnsigned(_data + _size, value);
+        }
+
+        inline void appendDouble(double value) {
+            _reserve(NumberFormat::maxLength);
+            _size += NumberFormat::formatDouble(_data + _size, value);
+        }
+
+        inline void appendFloat(float value) {
+            _reserve(NumberFormat::maxLength);
+            _size += NumberFormat::formatFloat(_data + _size, value);
+        }
+
+        /**
+         * Appends value in hexadecimal, prefixed by "0x".
+         **/
+        void appendPointer(const void* value);
+
+        /**
+         * Appends the format with the given arguments, like vsprintf(3).
+         **/
+        void appendVprintf(const char* format, va_list arguments);
+
+        /**
+         * Appends the literal characters of format up to its next {}
+         * placeholder, where "{{" and "}}" stand for single braces.
+         * @returns the rest of format after the placeholder, or NULL if
+         * format had no more placeholders.
+         **/
+        const char* appendUntilPlaceholder(const char* format);
+
+        inline const char* data() const {
+            return _data;
+        }
+
+        inline size_t size() const {
+            return _size;
+        }
+
+        inline void clear() {
+            _size = 0;
+        }
+
+        inline std::string str() const {
+            return std::string(_data, _size);
+        }
+
+        inline SharedString share() const {
+            return SharedString(_data, _size);
+        }
+
+        private:
+        FormatBuffer(const FormatBuffer& other);
+        FormatBuffer& operator=(const FormatBuffer& other);
+
+        inline void _reserve(size_t length) {
+            if (_capacity - _size < length)
+                _grow(length);
+        }
+
+        void _grow(size_t length);
+
+        char* _data;
+        size_t _size;
+        size_t _capacity;
+        char _stack[stackSize];
+    };
+
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+
+    /**
+     * The formatArgument() overloads append one argument of
+     * Category::logf() to the message. Overloads for further types can
+     * be declared in the namespace of the type. Types without one are
+     * formatted with their operator<<.
+     **/
+    inline void formatArgument(FormatBuffer& buffer, bool value) {
+        if (value)
+            buffer.append("true", 4);
+        else
+            buffer.append("false", 5);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, char value) {
+        buffer.append(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, signed char value) {
+        buffer.appendInteger(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, unsigned char value) {
+        buffer.appendUnsigned(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, short value) {
+        buffer.appendInteger(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, unsigned short value) {
+        buffer.appendUnsigned(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, int value) {
+        buffer.appendInteger(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, unsigned int value) {
+        buffer.appendUnsigned(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, long value) {
+        buffer.appendInteger(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, unsigned long value) {
+        buffer.appendUnsigned(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, long long value) {
+        buffer.appendInteger(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, unsigned long long value) {
+        buffer.appendUnsigned(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, float value) {
+        buffer.appendFloat(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, double value) {
+        buffer.appendDouble(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, long double value) {
+        buffer.appendDouble(static_cast<double>(value));
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, const char* value) {
+        buffer.append(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, char* value) {
+        buffer.append(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, const std::string& value) {
+        buffer.append(value);
+    }
+
+    inline void formatArgument(FormatBuffer& buffer, const SharedString& value) {
+        buffer.append(value.str());
+    }
+
+    template<typename T> inline void formatArgument(FormatBuffer& buffer, T* value) {
+        buffer.appendPointer(value);
+    }
+
+    template<typename T> void formatArgument(FormatBuffer& buffer, const T& value) {
+        std::ostringstream out;
+        out << value;
+        buffer.append(out.str());
+    }
+
+    /**
+     * Appends format to buffer, with its placeholders left as they are
+     * for want of arguments.
+     **/
+    inline void formatTo(FormatBuffer& buffer, const char* format) {
+        while (format && (format = buffer.appendUntilPlaceholder(format)))
+            buffer.append("{}", 2);
+    }
+
+    /**
+     * Appends format to buffer, with each {} placeholder replaced by the
+     * next argument. Arguments beyond the placeholders are appended,
+     * separated by spaces.
+     **/
+    template<typename T, typename... Arguments>
+    void formatTo(FormatBuffer& buffer, const char* format, const T& argument,
+                  const Arguments&... arguments) {
+        if (format)
+            format = buffer.appendUntilPlaceholder(format);
+        if (!format)
+            buffer.append(' ');
+        formatArgument(buffer, argument);
+        formatTo(buffer, format, arguments...);
+    }
+
+    /**
+     * Counts the {} placeholders of format, at compile time for literals.
+     **/
+    constexpr unsigned int countPlaceholders(const char* format,
+                                             unsigned int count = 0) {
+        return (*format == '\0') ? count :
+            ((format[0] == '{' || format[0] == '}') && format[1] == format[0]) ?
+                countPlaceholders(format + 2, count) :
+            (format[0] == '{' && format[1] == '}') ?
+                countPlaceholders(format + 2, count + 1) :
+                countPlaceholders(format + 1, count);
+    }
+
+    /**
+     * Never defined: its size is one more than the number of arguments.
+     **/
+    template<typename... Arguments>
+    char (&countArguments(const char* format, const Arguments&... arguments))[sizeof...(Arguments) + 1];
+
+#endif // LOG4CPP_HAVE_VARIADIC_TEMPLATES
+}
+
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+/**
+ * Calls category.logf() after checking at compile time that the literal
+ * format has as many placeholders as there are arguments.
+ **/
+#define LOG4CPP_LOGF(category, priority, format, ...) \
+    do { \
+        static_assert(::log4cpp::countPlaceholders(format) + 1 == \
+                      sizeof(::log4cpp::countArguments(format, ##__VA_ARGS__)), \
+                      "placeholders and arguments of " #format " do not match"); \
+        (category).logf(priority, format, ##__VA_ARGS__); \
+    } while (0)
+#endif
+
+#endif // _LOG4CPP_FORMAT_HH
@@ -0,0 +1,138 @@
+/*
+ * GelfAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_GELFAPPENDER_HH
+#define _LOG4CPP_GELFAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <string>
+#include <vector>
+#include <log4cpp/LayoutAppender.hh>
+
+namespace log4cpp {
+
+    class SenderThread;
+
+    /**
+     * GelfAppender sends events to a Graylog server in the Graylog Extended
+     * Log Format.
+     *
+     * <p>Each event is a GELF 1.1 JSON message: the layout formats the
+     * short_message, a PassThroughLayout by default, and the category,
+     * priority name, thread, NDC and each MDC entry are additional fields.
+     * The timestamp has microsecond precision.
+     *
+     * <p>Over UDP, messages are optionally zlib or gzip compressed and split
+     * into GELF chunks when they exceed the chunk size; messages needing
+     * more than 128 chunks are dropped. Over TCP, messages are terminated by
+     * a null byte and never compressed, as GELF TCP does not allow it.
+     * The socket and the message buffers are reused across events.
+     *
+     * <p>Connecting, compressing and sending happen on a background thread
+     * (synchronously where threads are not available), so logging never
+     * waits for the network. Messages beyond 1MB waiting to be sent are
+     * dropped; reconnecting is retried with an exponential backoff.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT GelfAppender : public LayoutAppender {
+        public:
+
+        typedef enum {
+            UDP,
+            TCP
+        } Transport;
+
+        typedef enum {
+            NONE,
+            ZLIB,
+            GZIP
+        } Compression;
+
+        static const unsigned short DEFAULT_PORT;
+
+        /**
+         * The default size of a UDP datagram, suitable for local networks.
+         * Use 1420 across the internet.
+         **/
+        static const size_t DEFAULT_CHUNK_SIZE;
+
+        /**
+         * Instantiate a GelfAppender.
+         * @param name The name of the Appender.
+         * @param host The host name or address of the Graylog server.
+         * @param port The port of the GELF input.
+         * @param transport UDP or TCP.
+         * @param compression The compression of UDP messages.
+         * @param chunkSize The maximum size of a UDP datagram.
+         **/
+        GelfAppender(const std::string& name, const std::string& host,
+                     unsigned short port = DEFAULT_PORT,
+                     Transport transport = UDP,
+                     Compression compression = NONE,
+                     size_t chunkSize = DEFAULT_CHUNK_SIZE);
+        virtual ~GelfAppender();
+
+        virtual bool reopen();
+        virtual void close();
+
+        /**
+         * @returns all fields, which the messages carry.
+         **/
+        virtual unsigned int getRequiredFields();
+
+        /**
+         * Sets the value of the host field, the local host name by default.
+         **/
+        void setSource(const std::string& source);
+
+        /**
+         * Sends the queued messages and waits until they are sent.
+         * @returns false if messages were dropped.
+         **/
+        bool flush();
+
+        /**
+         * Returns the number of events which could not be sent.
+         **/
+        unsigned long getDropped() const;
+
+        protected:
+        virtual void _append(const LoggingEvent& event);
+        bool _connect();
+        void _disconnect();
+        bool _send(const char* data, size_t length);
+        bool _sendChunked(const char* message, size_t length);
+
+        static bool _connectSender(void* appender);
+        static size_t _sendBatch(void* appender, const std::string& messages,
+                                 const std::vector<size_t>& sizes, bool& connected);
+
+        const std::string _host;
+        const unsigned short _port;
+        const Transport _transport;
+        const Compression _compression;
+        const size_t _chunkSize;
+        std::string _source;
+        std::string _message;
+
+        // used by the sending thread only
+        int _socket;
+        unsigned long long _messageId;
+        std::string _compressed;
+        std::string _chunk;
+
+        SenderThread* _sender;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
+#endif // _LOG4CPP_GELFAPPENDER_HH
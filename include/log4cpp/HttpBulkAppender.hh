@@ -0,0 +1,141 @@
+/*
+ * HttpBulkAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_HTTPBULKAPPENDER_HH
+#define _LOG4CPP_HTTPBULKAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <string>
+#include <vector>
+#include <log4cpp/LayoutAppender.hh>
+
+namespace log4cpp {
+
+    class SenderThread;
+
+    /**
+     * HttpBulkAppender ships events as JSON documents to the HTTP bulk
+     * ingest API of a log indexing backend.
+     *
+     * <p>Each event becomes a JSON object with the fields timestamp,
+     * priority, category, thread, ndc, mdc if not empty, and message; the
+     * message is formatted by the layout, a PassThroughLayout by default. Documents are
+     * collected into batches, either as newline delimited JSON, optionally
+     * preceded by an action line such as <code>{"index":{}}</code>, or as a
+     * JSON array. A batch is sent once it reaches the batch size or its
+     * oldest event the batch delay.
+     *
+     * <p>Batches are POSTed, gzip compressed if enabled, over a persistent
+     * HTTP/1.1 connection from a background thread (synchronously where
+     * threads are not available). Failed requests are retried with an
+     * exponential backoff. Events waiting to be sent are bounded by a
+     * memory budget: when it is exceeded, events of the lowest priority
+     * are dropped first.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT HttpBulkAppender : public LayoutAppender {
+        public:
+
+        typedef enum {
+            NDJSON,
+            JSON_ARRAY
+        } Format;
+
+        static const size_t DEFAULT_BATCH_SIZE;
+        static const unsigned int DEFAULT_BATCH_DELAY;
+        static const size_t DEFAULT_BUDGET;
+
+        /**
+         * Instantiate a HttpBulkAppender.
+         * @param name The name of the Appender.
+         * @param url The URL to POST batches to, "http://host[:port]/path".
+         * @param format The format of a batch.
+         * @param batchSize The batch size in bytes of uncompressed JSON.
+         * @param batchDelay The maximum time in milliseconds an event
+         * waits for its batch to fill up.
+         * @param budget The maximum number of bytes of JSON kept waiting.
+         **/
+        HttpBulkAppender(const std::string& name, const std::string& url,
+                         Format format = NDJSON,
+                         size_t batchSize = DEFAULT_BATCH_SIZE,
+                         unsigned int batchDelay = DEFAULT_BATCH_DELAY,
+                         size_t budget = DEFAULT_BUDGET);
+        virtual ~HttpBulkAppender();
+
+        /**
+         * Sends the pending events and stops the background thread.
+         **/
+        virtual void close();
+        virtual bool reopen();
+
+        /**
+         * @returns all fields, which the documents carry.
+         **/
+        virtual unsigned int getRequiredFields();
+
+        /**
+         * Sets the line preceding each document in NDJSON batches, e.g.
+         * <code>{"index":{}}</code> for an Elasticsearch bulk request.
+         **/
+        void setActionLine(const std::string& actionLine);
+
+        /**
+         * Enables gzip compression of the batches, if available.
+         **/
+        void setGzip(bool gzip);
+
+        /**
+         * Sets the number of times a failed request is retried before its
+         * batch is dropped. Defaults to 5.
+         **/
+        void setMaxRetries(unsigned int maxRetries);
+
+        /**
+         * Returns the number of events dropped because of the budget or
+         * because their batch could not be delivered.
+         **/
+        unsigned long getDropped();
+
+        protected:
+        virtual void _append(const LoggingEvent& event);
+
+        bool _deliver(const std::string& body);
+        int _post(const std::string& payload);
+        bool _readResponse(int& status);
+        bool _receive();
+        bool _connect();
+        void _disconnect();
+
+        static bool _connectSender(void* appender);
+        static size_t _sendBatch(void* appender, const std::string& documents,
+                                 const std::vector<size_t>& sizes, bool& connected);
+
+        std::string _host;
+        std::string _port;
+        std::string _path;
+        const Format _format;
+        const size_t _batchSize;
+        std::string _actionLine;
+        bool _gzip;
+        unsigned int _maxRetries;
+        std::string _document;
+
+        // used by the sending thread only
+        int _socket;
+        std::string _response;
+
+        SenderThread* _sender;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
+#endif // _LOG4CPP_HTTPBULKAPPENDER_HH
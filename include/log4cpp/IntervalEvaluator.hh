@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#if !defined(h_3a3f5031_11f0_4aa9_a254_d1a86932cc4a)
+#define h_3a3f5031_11f0_4aa9_a254_d1a86932cc4a
+
+#include <log4cpp/TriggeringEventEvaluator.hh>
+#include <log4cpp/threading/Atomic.hh>
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace log4cpp
+{
+   /**
+    * Triggers once the first event of a batch is interval milliseconds old.
+    * When attached to a trigger, a timer thread fires it without waiting
+    * for the next event, which bounds the time events stay buffered.
+    * Without threads, the age is only checked when an event arrives.
+    * @since 1.1
+    **/
+   class LOG4CPP_EXPORT IntervalEvaluator : public TriggeringEventEvaluator
+   {
+      public:
+         IntervalEvaluator(unsigned long interval);
+         virtual ~IntervalEvaluator();
+
+         virtual bool eval(const LoggingEvent& event) const;
+         virtual void attach(Trigger* trigger);
+         virtual void reset() const;
+
+      private:
+         IntervalEvaluator(const IntervalEvaluator&);
+         IntervalEvaluator& operator=(const IntervalEvaluator&);
+
+         static long long now();
+
+         unsigned long interval_;
+         // milliseconds since the epoch of the first event of the batch,
+         // 0 while there is none
+         mutable threading::Atomic<long long> started_;
+         Trigger* trigger_;
+
+#ifdef LOG4CPP_USE_PTHREADS
+         static void* run(void* evaluator);
+
+         mutable pthread_mutex_t mutex_;
+         mutable pthread_cond_t condition_;
+         pthread_t thread_;
+         bool running_;
+#endif
+   };
+}
+
+#endif // h_3a3f5031_11f0_4aa9_a254_d1a86932cc4a
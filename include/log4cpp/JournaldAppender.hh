@@ -0,0 +1,128 @@
+/*
+ * JournaldAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_JOURNALDAPPENDER_HH
+#define _LOG4CPP_JOURNALDAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <string>
+#include <log4cpp/LayoutAppender.hh>
+#include <log4cpp/Priority.hh>
+
+namespace log4cpp {
+
+    /**
+     * JournaldAppender sends LoggingEvents to systemd-journald using the
+     * journal native protocol. Instead of a single preformatted syslog line
+     * each event is sent as a set of separate journal fields:
+     * <ul>
+     * <li><b>MESSAGE</b> - the event formatted by the Layout (by default
+     * only the message itself)</li>
+     * <li><b>PRIORITY</b> - the syslog priority of the event</li>
+     * <li><b>SYSLOG_IDENTIFIER</b> - the identifier given at construction</li>
+     * <li><b>LOG4CPP_CATEGORY</b> - the category name</li>
+     * <li><b>LOG4CPP_NDC</b> - the NDC, if not empty</li>
+     * <li><b>LOG4CPP_THREAD</b> - the thread name</li>
+     * <li><b>LOG4CPP_MDC_<i>KEY</i></b> - each MDC entry, the key upper
+     * cased and characters other than letters and digits replaced by
+     * '_'</li>
+     * </ul>
+     * Events that do not fit in a single datagram are passed to the journal
+     * in a sealed memfd, as sd_journal_send() does.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT JournaldAppender : public LayoutAppender {
+        public:
+
+        /**
+         * The path of the socket journald listens on for native protocol
+         * messages.
+         **/
+        static const char* DEFAULT_SOCKET_PATH;
+
+        /**
+         * Translates a log4cpp priority to a syslog priority
+         * @param priority The log4cpp priority.
+         * @returns the syslog priority.
+         **/
+        static int toSyslogPriority(Priority::Value priority);
+
+        /**
+         * Instantiate a JournaldAppender.
+         * @param name The name of the Appender
+         * @param syslogIdentifier The value of the SYSLOG_IDENTIFIER field.
+         * @param socketPath The path of the journald socket. Tests may
+         * point this to a local receiver.
+         **/
+        JournaldAppender(const std::string& name,
+                         const std::string& syslogIdentifier,
+                         const std::string& socketPath = DEFAULT_SOCKET_PATH);
+        virtual ~JournaldAppender();
+
+        /**
+         * Closes and reopens the socket.
+         **/
+        virtual bool reopen();
+
+        /**
+         * Closes the socket.
+         **/
+        virtual void close();
+
+        /**
+         * @returns the fields of the layout, and the thread, NDC and MDC,
+         * which are fields of the journal entries.
+         **/
+        virtual unsigned int getRequiredFields();
+
+        protected:
+
+        /**
+         * Opens the datagram socket.
+         **/
+        virtual void open();
+
+        /**
+         * Sends a LoggingEvent to the journal.
+         * @param event the LoggingEvent to log.
+         **/
+        virtual void _append(const LoggingEvent& event);
+
+        /**
+         * Appends a field in the native protocol encoding to the
+         * datagram buffer.
+         **/
+        void _appendField(const char* name, const std::string& value);
+
+        /**
+         * Returns the journal field name for an MDC key.
+         **/
+        const std::string& _mdcFieldName(const std::string& key);
+
+        /**
+         * Passes the datagram buffer to the journal in a sealed memfd.
+         * @returns false if memfds are not available or sending failed.
+         **/
+        bool _sendMemfd();
+
+        const std::string _syslogIdentifier;
+        const std::string _socketPath;
+        int _socket;
+
+        private:
+        std::string _buffer;
+        std::string _fieldName;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
+#endif // _LOG4CPP_JOURNALDAPPENDER_HH
@@ -12,6 +12,7 @@
 
 #include <log4cpp/Portability.hh>
 #include <log4cpp/LoggingEvent.hh>
+#include <log4cpp/threading/Atomic.hh>
 #include <string>
 
 namespace log4cpp {
@@ -21,11 +22,48 @@ namespace log4cpp {
  **/
     class LOG4CPP_EXPORT Layout {
         public:
+        Layout() : _references(1) { };
+
+        Layout(const Layout&) : _references(1) { };
+
+        Layout& operator=(const Layout&) { return *this; };
+
         /**
          * Destructor for Layout.
          **/
         virtual ~Layout() { };
 
+        /**
+         * Takes another reference to the layout, e.g. to hand the same
+         * layout to several appenders: <code>b->setLayout(layout->share())</code>.
+         * Appenders sharing a layout format each event only once per
+         * dispatch, the others reuse the text.
+         * @returns this layout.
+         * @since 1.1
+         **/
+        Layout* share() {
+            _references.fetchAdd(1);
+            return this;
+        };
+
+        /**
+         * Drops a reference to the layout, deleting it with the last one.
+         * Appenders release their layout instead of deleting it.
+         * @since 1.1
+         **/
+        void release() {
+            if (_references.fetchAdd(-1) == 1)
+                delete this;
+        };
+
+        /**
+         * @returns whether more than one reference to the layout exists.
+         * @since 1.1
+         **/
+        bool isShared() const {
+            return _references.load() > 1;
+        };
+
         /**
          * Formats the LoggingEvent data to a string that appenders can log.
          * Implement this method to create your own layout format.
@@ -33,6 +71,21 @@ namespace log4cpp {
          * @returns an appendable string.
          **/
         virtual std::string format(const LoggingEvent& event) = 0;
+
+        /**
+         * Returns the fields of LoggingEvent, see LoggingEvent::Field,
+         * which format() uses. Events do not capture fields none of the
+         * layouts and appenders they reach need. By default all of them;
+         * a layout whose needs change should call
+         * Category::requiredFieldsChanged().
+         * @since 1.1
+         **/
+        virtual unsigned int getRequiredFields() const {
+            return LoggingEvent::ALL_FIELDS;
+        }
+
+        private:
+        threading::Atomic<int> _references;
     };        
 }
 
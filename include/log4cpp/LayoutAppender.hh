@@ -19,7 +19,8 @@ namespace log4cpp {
 
     /**
      * LayoutAppender is a common superclass for all Appenders that require
-     * a Layout. 
+     * a Layout. Several LayoutAppenders may share a Layout, see
+     * Layout::share().
      **/
     class LOG4CPP_EXPORT LayoutAppender : public AppenderSkeleton {
         public:
@@ -36,18 +37,55 @@ namespace log4cpp {
          * @returns true.
          **/
         virtual bool requiresLayout() const;
+
+        /**
+         * Set the Layout for this appender, releasing the previous one.
+         * @param layout The layout to use, which the appender takes a
+         * reference of, or NULL for a default one.
+         **/
         virtual void setLayout(Layout* layout = NULL);
 
+        /**
+         * @returns all fields, as subclasses may read any of them in
+         * _append(). Appenders which only format the event with the layout
+         * return _getLayoutFields() instead.
+         **/
+        virtual unsigned int getRequiredFields();
+
         protected:
         /**
          * Return the layout of the appender.
          * This method is the Layout accessor for subclasses of LayoutAppender.
+         * While the layout is shared, it formats each event of a dispatch
+         * only once for all appenders sharing it.
          * @returns the Layout.
          **/
         Layout& _getLayout();
 
+        /**
+         * @returns the fields the layout needs, or all of them if the
+         * appender has a Filter.
+         * @since 1.1
+         **/
+        unsigned int _getLayoutFields();
+
         private:
+        /**
+         * Formats with the shared layout of the appender through the
+         * FormatMemo of the dispatch.
+         **/
+        class SharedLayout : public Layout {
+            public:
+            SharedLayout(Layout* const& layout);
+            virtual std::string format(const LoggingEvent& event);
+            virtual unsigned int getRequiredFields() const;
+
+            private:
+            Layout* const& _layout;
+        };
+
         Layout* _layout;
+        SharedLayout _sharedLayout;
     };
 }
 
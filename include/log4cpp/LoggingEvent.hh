@@ -12,9 +12,13 @@
 
 #include <log4cpp/Portability.hh>
 #include <string>
+#include <new>
 
 #include <log4cpp/Priority.hh>
 #include <log4cpp/TimeStamp.hh>
+#include <log4cpp/SharedString.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/MDC.hh>
 
 /**
  * The top level namespace for all 'Log for C++' types and classes.
@@ -28,8 +32,17 @@ namespace log4cpp {
      * components.
      *
      * <p>This class is of concern to those wishing to extend log4cpp. 
+     *
+     * <p>The string fields refer to reference counted SharedStrings and
+     * the NDC and MDC are shared snapshots, so copying an event does not
+     * copy its strings.
      **/
     struct LOG4CPP_EXPORT LoggingEvent {
+    private:
+        SharedString _categoryName;
+        SharedString _message;
+        SharedString _threadName;
+
     public:
         /**
          * Instantiate a LoggingEvent from the supplied parameters.
@@ -45,15 +58,109 @@ namespace log4cpp {
         LoggingEvent(const std::string& category, const std::string& message, 
                      const std::string& ndc, Priority::Value priority);
 
+        /**
+         * Instantiate a LoggingEvent that was created elsewhere, e.g. in
+         * another process, keeping its original thread name and time.
+         *
+         * @param category The category of this event.
+         * @param message  The message of this event.
+         * @param ndc The nested diagnostic context of this event. 
+         * @param priority The priority of this event.
+         * @param threadName The name of the thread the event was created in.
+         * @param timeStamp The time the event was created at.
+         * @param mdc The mapped diagnostic context of this event.
+         * @since 1.1
+         **/
+        LoggingEvent(const std::string& category, const std::string& message, 
+                     const std::string& ndc, Priority::Value priority,
+                     const std::string& threadName, const TimeStamp& timeStamp,
+                     const MDC::Snapshot& mdc = MDC::Snapshot());
+
+        /**
+         * The fields of a LoggingEvent which need not be captured if no
+         * Layout or Appender uses them, see Layout::getRequiredFields().
+         * Fields which are not captured are left empty, zero, or the
+         * epoch.
+         * @since 1.1
+         **/
+        enum Field {
+            /** timeStamp */
+            FIELD_TIMESTAMP = 1,
+            /** threadName and systemThreadId */
+            FIELD_THREAD = 2,
+            /** ndc */
+            FIELD_NDC = 4,
+            /** mdc */
+            FIELD_MDC = 8,
+            ALL_FIELDS = FIELD_TIMESTAMP | FIELD_THREAD | FIELD_NDC | FIELD_MDC
+        };
+
+        /**
+         * Instantiate a LoggingEvent sharing the supplied strings, which
+         * saves copying them.
+         *
+         * @param category The category of this event.
+         * @param message  The message of this event.
+         * @param ndc The nested diagnostic context of this event. 
+         * @param priority The priority of this event.
+         * @param fields The Fields to capture, e.g.
+         * Category::getRequiredFields().
+         * @since 1.1
+         **/
+        LoggingEvent(const SharedString& category, const SharedString& message, 
+                     const NDC::ContextStack& ndc, Priority::Value priority,
+                     unsigned int fields = ALL_FIELDS);
+
+        /**
+         * Instantiate a LoggingEvent that was created elsewhere, keeping
+         * its original thread name and time, and sharing the supplied
+         * strings.
+         *
+         * @param category The category of this event.
+         * @param message  The message of this event.
+         * @param ndc The nested diagnostic context of this event. 
+         * @param priority The priority of this event.
+         * @param threadName The name of the thread the event was created in.
+         * @param timeStamp The time the event was created at.
+         * @param mdc The mapped diagnostic context of this event.
+         * @since 1.1
+         **/
+        LoggingEvent(const SharedString& category, const SharedString& message, 
+                     const NDC::ContextStack& ndc, Priority::Value priority,
+                     const SharedString& threadName, const TimeStamp& timeStamp,
+                     const MDC::Snapshot& mdc = MDC::Snapshot());
+
+        /**
+         * LoggingEvents on the heap, e.g. queued for another thread, are
+         * allocated from the log4cpp Allocator.
+         * @since 1.1
+         **/
+        static void* operator new(size_t size);
+        static void operator delete(void* event, size_t size);
+
+        inline static void* operator new(size_t, void* place) {
+            return place;
+        }
+
+        inline static void operator delete(void*, void*) {
+        }
 
         /** The category name. */
-        const std::string categoryName;
+        const std::string& categoryName;
 
         /** The application supplied message of logging event. */
-        const std::string message;
+        const std::string& message;
 
-        /** The nested diagnostic context (NDC) of logging event. */
-        const std::string ndc;
+        /** The nested diagnostic context (NDC) of logging event. Its
+            string is only put together when asked for.
+            @since 1.1 a shared context stack rather than a string
+        */
+        const NDC::ContextStack ndc;
+
+        /** The mapped diagnostic context (MDC) of logging event.
+            @since 1.1
+        */
+        const MDC::Snapshot mdc;
 
         /** Priority of logging event. */
         Priority::Value priority;
@@ -61,7 +168,13 @@ namespace log4cpp {
         /** The name of thread in which this logging event was generated,
             e.g. the PID. 
         */
-        const std::string threadName;
+        const std::string& threadName;
+
+        /** The id the operating system knows the thread in which this
+            logging event was generated by, or 0 if unknown.
+            @since 1.1
+        */
+        unsigned long systemThreadId;
 
         /** The number of seconds elapsed since the epoch 
             (1/1/1970 00:00:00 UTC) until logging event was created. */
@@ -0,0 +1,162 @@
+/*
+ * MDC.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_MDC_HH
+#define _LOG4CPP_MDC_HH
+
+#include <log4cpp/Portability.hh>
+#include <string>
+#include <vector>
+#include <log4cpp/threading/Atomic.hh>
+
+namespace log4cpp {
+
+    /**
+       The MDC class implements <i>mapped diagnostic contexts</i>: values
+       like request or tenant ids which are put once for the current
+       thread (or its ExecutionContext) and then accompany every logging
+       event made there, without being formatted into the messages.
+
+       <p>Keys are interned, so that looking them up compares pointers.
+       Logging events keep a Snapshot of the map, which they share with
+       the MDC until it is changed again.
+
+       @since 1.1
+    **/
+    class LOG4CPP_EXPORT MDC {
+        public:
+
+        /**
+           An interned key: keys with equal names are the same pointer.
+        **/
+        typedef const std::string* Key;
+
+        /**
+           Returns the interned key with the given name. Keeping the key
+           saves interning it on every put.
+        **/
+        static Key key(const std::string& name);
+
+        /**
+           An immutable copy of a mapped diagnostic context, in the order
+           its entries were first put.
+        **/
+        class LOG4CPP_EXPORT Snapshot {
+            public:
+            struct Entry {
+                Key key;
+                std::string value;
+            };
+
+            typedef std::vector<Entry> Entries;
+            typedef Entries::const_iterator const_iterator;
+
+            inline Snapshot() :
+                _rep(NULL) {
+            }
+
+            /**
+               A snapshot of the given entries, e.g. of an event made in
+               another process.
+            **/
+            explicit Snapshot(const Entries& entries);
+
+            Snapshot(const Snapshot& other);
+            Snapshot& operator=(const Snapshot& other);
+            ~Snapshot();
+
+            /**
+               Returns the value for key, or the empty string.
+            **/
+            const std::string& get(Key key) const;
+            const std::string& get(const std::string& name) const;
+
+            bool contains(Key key) const;
+
+            inline bool empty() const {
+                return !_rep || _rep->entries.empty();
+            }
+
+            inline size_t size() const {
+                return _rep ? _rep->entries.size() : 0;
+            }
+
+            const_iterator begin() const;
+            const_iterator end() const;
+
+            private:
+            friend class MDC;
+
+            struct Rep {
+                inline Rep() :
+                    references(1) {
+                }
+
+                threading::Atomic<unsigned long> references;
+                Entries entries;
+            };
+
+            Entry* _find(Key key) const;
+            void _release();
+
+            Rep* _rep;
+        };
+
+        /**
+           Puts value for key into the MDC of the current thread.
+        **/
+        static void put(Key key, const std::string& value);
+        static void put(const std::string& name, const std::string& value);
+
+        /**
+           Returns the value for key in the MDC of the current thread, or
+           the empty string.
+        **/
+        static const std::string& get(const std::string& name);
+
+        static void remove(Key key);
+        static void remove(const std::string& name);
+
+        static void clear();
+
+        /**
+           Returns the MDC of the current thread as a Snapshot.
+        **/
+        static const Snapshot& getSnapshot();
+
+        /**
+           Return the MDC for the current thread, or rather its current
+           ExecutionContext.
+           @return the MDC for the current thread
+        **/
+        static MDC& getMDC();
+
+        MDC();
+        ~MDC();
+
+        void _put(Key key, const std::string& value);
+        void _remove(Key key);
+        void _clear();
+
+        Snapshot _snapshot;
+
+        private:
+        /**
+           Whether the MDC was ever used, which saves looking for it
+           until then.
+        **/
+        static bool isUsedMDC;
+
+        /**
+           Makes _snapshot the only one referring to its entries.
+        **/
+        void _detach();
+    };
+}
+
+#endif // _LOG4CPP_MDC_HH
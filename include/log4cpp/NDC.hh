@@ -12,7 +12,8 @@
 
 #include <log4cpp/Portability.hh>
 #include <string>
-#include <vector>
+#include <iosfwd>
+#include <log4cpp/threading/Atomic.hh>
 
 namespace log4cpp {
     /**
@@ -75,16 +76,121 @@ namespace log4cpp {
     	static const std::string emptyString;
         public:
 
-        struct DiagnosticContext {
-            DiagnosticContext(const std::string& message);
-            DiagnosticContext(const std::string& message, 
-                              const DiagnosticContext& parent);
+        class ContextStack;
 
-            std::string message;
-            std::string fullMessage;
+        /**
+           One level of a diagnostic context. Contexts are immutable and
+           shared by reference count between the stacks, threads and
+           logging events which contain them, so pushing, cloning and
+           inheriting never copy them.
+           @since 1.1 a shared, immutable node rather than a copied struct
+        **/
+        class LOG4CPP_EXPORT DiagnosticContext {
+            public:
+            /** The message pushed for this level. */
+            const std::string message;
+
+            /** The enclosing context, or NULL for the outermost one. */
+            const DiagnosticContext* const parent;
+
+            /** The number of levels up to and including this one. */
+            const size_t depth;
+
+            /**
+               Returns the messages of all levels, outermost first and
+               separated by spaces. It is put together on first use only.
+            **/
+            const std::string& fullMessage() const;
+
+            private:
+            friend class ContextStack;
+
+            DiagnosticContext(const std::string& message,
+                              const DiagnosticContext* parent);
+            ~DiagnosticContext();
+            DiagnosticContext(const DiagnosticContext&);
+            DiagnosticContext& operator=(const DiagnosticContext&);
+
+            mutable threading::Atomic<unsigned long> _references;
+            mutable threading::Atomic<std::string*> _fullMessage;
         };
 
-        typedef std::vector<DiagnosticContext> ContextStack;
+        /**
+           A stack of diagnostic contexts, held by its innermost context.
+           Copies share the contexts, which makes a ContextStack cheap to
+           copy, clone and keep in logging events.
+           @since 1.1 a handle to shared contexts rather than a vector
+        **/
+        class LOG4CPP_EXPORT ContextStack {
+            public:
+            inline ContextStack() :
+                _top(NULL) {
+            }
+
+            /**
+               Makes a stack of one context, or an empty one if message
+               is empty.
+            **/
+            explicit ContextStack(const std::string& message);
+
+            ContextStack(const ContextStack& other);
+            ContextStack& operator=(const ContextStack& other);
+            ~ContextStack();
+
+            /**
+               Returns this stack with message pushed on top of it.
+            **/
+            ContextStack push(const std::string& message) const;
+
+            /**
+               Returns this stack without its innermost context.
+            **/
+            ContextStack pop() const;
+
+            /**
+               Returns the innermost context, or NULL if empty.
+            **/
+            inline const DiagnosticContext* top() const {
+                return _top;
+            }
+
+            inline bool empty() const {
+                return !_top;
+            }
+
+            /**
+               Returns the number of contexts on the stack.
+            **/
+            inline size_t depth() const {
+                return _top ? _top->depth : 0;
+            }
+
+            /**
+               Returns the length of the full message, as for the
+               std::string the NDC of an event used to be.
+            **/
+            inline size_t size() const {
+                return str().size();
+            }
+
+            /**
+               Returns the full message of the innermost context.
+            **/
+            const std::string& str() const;
+
+            inline operator const std::string&() const {
+                return str();
+            }
+
+            inline const char* c_str() const {
+                return str().c_str();
+            }
+
+            private:
+            static void _release(const DiagnosticContext* context);
+
+            const DiagnosticContext* _top;
+        };
 
         /**
            Clear any nested disgnostic information if any. This method is
@@ -117,6 +223,14 @@ namespace log4cpp {
         **/
         static const std::string& get();
 
+        /**
+           Get the current diagnostic context as a stack, which logging
+           events keep without copying it.
+           @return the context stack.
+           @since 1.1
+        **/
+        static const ContextStack& getStack();
+
         /**
            Get the current nesting depth of this diagnostic context.
            @return the nesting depth
@@ -156,7 +270,8 @@ namespace log4cpp {
         static void setMaxDepth(int maxDepth);
 
         /**
-           Return the NDC for the current thread.
+           Return the NDC for the current thread, or rather its current
+           ExecutionContext, which coroutines and fibers may replace.
            @return the NDC for the current thread
         **/
         static NDC& getNDC();
@@ -168,6 +283,7 @@ namespace log4cpp {
         virtual void _clear();
         virtual ContextStack* _cloneStack();
         virtual const std::string& _get() const;
+        virtual const ContextStack& _getStack() const;
         virtual size_t _getDepth() const;
         virtual void _inherit(ContextStack* stack);
         virtual std::string _pop();
@@ -176,6 +292,10 @@ namespace log4cpp {
 
         ContextStack _stack;
     };        
+
+    LOG4CPP_EXPORT bool operator==(const NDC::ContextStack& stack, const std::string& message);
+    LOG4CPP_EXPORT bool operator==(const NDC::ContextStack& stack, const char* message);
+    LOG4CPP_EXPORT std::ostream& operator<<(std::ostream& out, const NDC::ContextStack& stack);
 }
 
 #endif // _LOG4CPP_NDC_HH
@@ -28,6 +28,11 @@ namespace log4cpp {
         virtual bool reopen();
         virtual void close();
 
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
         protected:
         virtual void _append(const LoggingEvent& event);
 
@@ -16,6 +16,7 @@ namespace log4cpp
    {
       public:
          virtual std::string format(const LoggingEvent& event) { return event.message; }
+         virtual unsigned int getRequiredFields() const { return 0; }
    };
 }
 
@@ -70,14 +70,21 @@ namespace log4cpp {
          *  If no date format specifier is given then the following format is used:
          *  "Wed Jan 02 02:03:55 1980". The date format specifier admits the same syntax 
          *  as the ANSI C function strftime, with 1 addition. The addition is the specifier
-         *  %%l for milliseconds, padded with zeros to make 3 digits.</li>
+         *  %%l for milliseconds, padded with zeros to make 3 digits, or %%us and
+         *  %%ns for micro- and nanoseconds, padded to 6 and 9 digits.</li>
          * <li><b>%%m</b> - the message</li>
          * <li><b>%%n</b> - the platform specific line separator</li>
          * <li><b>%%p</b> - the priority</li>
-         * <li><b>%%r</b> - milliseconds since this layout was created.</li>
+         * <li><b>%%r</b> - milliseconds since the application started;
+         *  %%r{us} and %%r{ns} give micro- and nanoseconds.</li>
          * <li><b>%%R</b> - seconds since Jan 1, 1970</li>
+         * <li><b>%%t</b> - the thread name, which is the thread id unless
+         *  set by threading::setThreadName(). %%t{tid} gives the id the
+         *  operating system knows the thread by instead, e.g. its Linux TID.</li>
          * <li><b>%%u</b> - clock ticks since process start</li>
          * <li><b>%%x</b> - the NDC</li>
+         * <li><b>%%X{key}</b> - the value for key in the MDC; %%X alone gives
+         *  all of it, as {key=value, ...}</li>
          * @param conversionPattern the conversion pattern
          * @exception ConfigureFailure if the pattern is invalid
          **/
@@ -87,6 +94,12 @@ namespace log4cpp {
 
         virtual void clearConversionPattern();
 
+        /**
+         * @returns the fields the components of the conversion pattern
+         * use.
+         **/
+        virtual unsigned int getRequiredFields() const;
+
         class LOG4CPP_EXPORT PatternComponent {
             public:
             inline virtual ~PatternComponent() {};
@@ -98,6 +111,7 @@ namespace log4cpp {
         ComponentVector _components;
 
         std::string _conversionPattern;
+        unsigned int _requiredFields;
     };        
 }
 
@@ -51,6 +51,16 @@
 #    pragma warning( disable : 4251 ) // "class XXX should be exported"
 #endif
 
+#if !defined(LOG4CPP_HAVE_VARIADIC_TEMPLATES) && \
+    (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800))
+#    define LOG4CPP_HAVE_VARIADIC_TEMPLATES 1
+#endif
+
+#if !defined(LOG4CPP_HAVE_VARIADIC_MACROS) && \
+    (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1400))
+#    define LOG4CPP_HAVE_VARIADIC_MACROS 1
+#endif
+
 #ifdef __APPLE__
 #  include <sstream>
 #else
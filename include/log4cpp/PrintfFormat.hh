@@ -0,0 +1,114 @@
+/*
+ * PrintfFormat.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_PRINTFFORMAT_HH
+#define _LOG4CPP_PRINTFFORMAT_HH
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Format.hh>
+#include <string>
+#include <vector>
+#include <cstdarg>
+
+namespace log4cpp {
+
+    /**
+     * A printf(3) format, parsed once into its literal text and
+     * conversions, so that it can render arguments without parsing the
+     * format again. Plain %d, %i, %u, %s and %c conversions are rendered
+     * directly into the buffer; conversions with flags, width or
+     * precision and floating point ones are each handed to snprintf(3),
+     * which gives the same output as vsnprintf(3) on the whole format.
+     *
+     * <p>Formats with conversions that cannot be rendered one by one,
+     * like positional arguments, %n or wide characters, are not
+     * compiled and go to vsnprintf(3) as a whole.
+     *
+     * <p>Usually a PrintfFormat is a static at the call site, see
+     * LOG4CPP_PRINTF.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT PrintfFormat {
+        public:
+        explicit PrintfFormat(const char* format);
+        ~PrintfFormat();
+
+        inline const std::string& getFormat() const {
+            return _format;
+        }
+
+        /**
+         * Returns whether the format could be compiled, rather than
+         * being handed to vsnprintf(3) as a whole.
+         **/
+        inline bool isCompiled() const {
+            return _compiled;
+        }
+
+        /**
+         * Appends the format with the given arguments to buffer.
+         **/
+        void format(FormatBuffer& buffer, va_list arguments) const;
+
+        private:
+        enum Length {
+            DEFAULT, CHAR, SHORT, LONG, LONG_LONG, INTMAX, SIZE, PTRDIFF,
+            LONG_DOUBLE
+        };
+
+        struct Segment {
+            /**
+             * The literal text, or the specification of the conversion.
+             **/
+            std::string text;
+
+            /**
+             * The conversion character, or '\0' for literal text.
+             **/
+            char conversion;
+            Length length;
+
+            /**
+             * Whether the conversion has no flags, width or precision.
+             **/
+            bool plain;
+            bool variableWidth;
+            bool variablePrecision;
+        };
+
+        PrintfFormat(const PrintfFormat& other);
+        PrintfFormat& operator=(const PrintfFormat& other);
+
+        void _appendLiteral(std::string& text);
+        const char* _parseConversion(const char* format);
+
+        std::string _format;
+        std::vector<Segment> _segments;
+        bool _compiled;
+    };
+}
+
+#ifdef LOG4CPP_HAVE_VARIADIC_MACROS
+/**
+ * Logs a printf(3) style message like Category::log() does, but parses
+ * the format only the first time the call site is reached. As the parsed
+ * format is kept for the call site, format must be a string literal;
+ * anything else does not compile. Use Category::log() for formats only
+ * known at run time.
+ **/
+#define LOG4CPP_PRINTF(logger, priority, format, ...) \
+   do { \
+      if ((logger).isPriorityEnabled(priority)) { \
+         static const ::log4cpp::PrintfFormat log4cppFormat("" format ""); \
+         (logger).logPrintf(priority, &log4cppFormat, ##__VA_ARGS__); \
+      } \
+   } while (0)
+#endif
+
+#endif // _LOG4CPP_PRINTFFORMAT_HH
@@ -40,6 +40,8 @@ namespace log4cpp {
        log4j.appender.A2.layout=org.apache.log4j.PatternLayout
        log4j.appender.A2.layout.ConversionPattern=The message %%m at time %%d%%n
        </PRE>
+       <P>Appenders configured with the same layout, i.e. the same type
+       and ConversionPattern, share one Layout, see Layout::share().
        
        @since 0.3.2
     **/
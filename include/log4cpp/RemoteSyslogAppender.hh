@@ -108,6 +108,11 @@ namespace log4cpp {
          **/
         virtual void close();
 
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
         protected:
         
         /**
@@ -37,6 +37,8 @@ namespace log4cpp {
 
         protected:
         virtual void _append(const LoggingEvent& event);
+        virtual void _appendBatch(const LoggingEvent* const* events, size_t count);
+        void _rollOverIfFull();
 
         unsigned int _maxBackupIndex;
         unsigned short int _maxBackupIndexWidth;	// keep constant index width by zeroing leading positions
@@ -0,0 +1,115 @@
+/*
+ * SharedString.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SHAREDSTRING_HH
+#define _LOG4CPP_SHAREDSTRING_HH
+
+#include <log4cpp/Portability.hh>
+#include <string>
+#include <log4cpp/threading/Atomic.hh>
+
+namespace log4cpp {
+
+    /**
+     * An immutable, reference counted string. Copies share the same
+     * characters, so that strings which are the same for many logging
+     * events, like category names and diagnostic contexts, are copied
+     * without allocating. The empty string is not allocated at all.
+     *
+     * <p>Released strings of up to a few kilobytes keep their characters'
+     * capacity in a cache per thread, so that new strings of similar
+     * length allocate nothing. A string released by another thread goes back to
+     * the thread which made it.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT SharedString {
+        public:
+        inline SharedString() :
+            _rep(0) {
+        }
+
+        /**
+         * Shares a copy of value.
+         **/
+        explicit SharedString(const std::string& value);
+
+        /**
+         * Shares a copy of a C string, or the empty string for NULL.
+         **/
+        explicit SharedString(const char* value);
+
+        /**
+         * Shares a copy of the given characters.
+         **/
+        SharedString(const char* characters, size_t length);
+
+        inline SharedString(const SharedString& other) :
+            _rep(other._rep) {
+            if (_rep)
+                _rep->references.fetchAdd(1);
+        }
+
+        inline ~SharedString() {
+            _release();
+        }
+
+        SharedString& operator=(const SharedString& other);
+
+        /**
+         * Shares the characters of value without copying them, leaving
+         * value empty.
+         **/
+        static SharedString adopt(std::string& value);
+
+        inline const std::string& str() const {
+            return _rep ? _rep->value : emptyString();
+        }
+
+        inline bool empty() const {
+            return !_rep;
+        }
+
+        static const std::string& emptyString();
+
+        private:
+        struct Rep {
+            inline Rep() :
+                references(1),
+                next(0),
+                cache(0) {
+            }
+
+            static void* operator new(size_t size);
+            static void operator delete(void* rep, size_t size);
+
+            threading::Atomic<unsigned long> references;
+            std::string value;
+
+            /**
+             * The next released Rep, and the RepCache it is released to.
+             **/
+            Rep* next;
+            void* cache;
+        };
+
+        class RepCache;
+
+        inline void _release() {
+            if (_rep && _rep->references.fetchAdd(static_cast<unsigned long>(-1)) == 1)
+                _recycle(_rep);
+        }
+
+        static Rep* _acquire(size_t length);
+        static void _recycle(Rep* rep);
+
+        Rep* _rep;
+    };
+}
+
+#endif // _LOG4CPP_SHAREDSTRING_HH
@@ -0,0 +1,100 @@
+/*
+ * ShmRingAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SHMRINGAPPENDER_HH
+#define _LOG4CPP_SHMRINGAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#include <string>
+#include <log4cpp/LayoutAppender.hh>
+
+namespace log4cpp {
+
+    namespace shmring {
+        struct Header;
+    }
+
+    /**
+     * ShmRingAppender hands formatted log messages to another process,
+     * typically a log shipping sidecar, through a ring buffer in shared
+     * memory. The consumer side is implemented by ShmRingReader.
+     *
+     * <p>Each message is written as a single frame directly into the shared
+     * segment, along with its priority, category, thread name and time;
+     * the consumer reads it in place. With a PassThroughLayout the message is copied
+     * straight from the event; other layouts format it first. A stalled
+     * consumer never blocks the producer: when the ring is full the
+     * message is dropped and counted, see getDropped().
+     *
+     * <p>The segment is either a file, e.g. below /dev/shm, or an anonymous
+     * memfd whose descriptor (getFd()) is handed to the consumer by the
+     * application. A ring has a single producing appender.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT ShmRingAppender : public LayoutAppender {
+        public:
+
+        /**
+         * The default size in bytes of the frame data area.
+         **/
+        static const size_t DEFAULT_CAPACITY;
+
+        /**
+         * Instantiate a ShmRingAppender.
+         * @param name The name of the Appender.
+         * @param path The file backing the ring, or the empty string for
+         * an anonymous memfd.
+         * @param capacity The size of the frame data area, rounded up to a
+         * power of two.
+         **/
+        ShmRingAppender(const std::string& name, const std::string& path,
+                        size_t capacity = DEFAULT_CAPACITY);
+        virtual ~ShmRingAppender();
+
+        virtual bool reopen();
+        virtual void close();
+
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
+        virtual void setLayout(Layout* layout = NULL);
+
+        /**
+         * Returns the descriptor of the shared segment, or -1 if it could
+         * not be opened.
+         **/
+        int getFd() const;
+
+        /**
+         * Returns the number of messages dropped by this appender because
+         * the consumer did not keep up.
+         **/
+        unsigned long getDropped() const;
+
+        protected:
+        virtual void open();
+        virtual void _append(const LoggingEvent& event);
+        void _write(const LoggingEvent& event, const std::string& message);
+
+        const std::string _path;
+        size_t _capacity;
+        int _fd;
+        shmring::Header* _header;
+        unsigned long _dropped;
+        bool _passThrough;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
+#endif // _LOG4CPP_SHMRINGAPPENDER_HH
@@ -0,0 +1,151 @@
+/*
+ * ShmRingReader.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SHMRINGREADER_HH
+#define _LOG4CPP_SHMRINGREADER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#include <string>
+#include <log4cpp/Appender.hh>
+#include <log4cpp/Priority.hh>
+#include <log4cpp/SharedString.hh>
+
+namespace log4cpp {
+
+    namespace shmring {
+        struct Header;
+    }
+
+    /**
+     * ShmRingReader is the consuming side of a ShmRingAppender ring. It is
+     * meant to be used by a log shipping sidecar, e.g.
+     * <pre>
+     *   ShmRingReader reader("/dev/shm/myapp.ring");
+     *   RollingFileAppender file("file", "myapp.log");
+     *   file.setLayout(new PassThroughLayout());
+     *   while (running) {
+     *       reader.wait(1000);
+     *       reader.drainTo(file);
+     *   }
+     * </pre>
+     * Frames are read in place from shared memory. A ring has a single
+     * consumer.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT ShmRingReader {
+        public:
+
+        /**
+         * Opens the ring backed by the given file.
+         **/
+        ShmRingReader(const std::string& path);
+
+        /**
+         * Opens the ring in the given shared memory descriptor, e.g. one
+         * obtained from ShmRingAppender::getFd(). The descriptor is
+         * duplicated.
+         **/
+        ShmRingReader(int fd);
+
+        virtual ~ShmRingReader();
+
+        /**
+         * Returns whether the ring could be opened and is initialized by
+         * a producer.
+         **/
+        bool isOpen();
+
+        /**
+         * Returns the next frame without consuming it. The data pointer
+         * refers to the shared segment and stays valid until release().
+         * @returns false if no frame is available, or if the ring is
+         * corrupt, see isCorrupt().
+         **/
+        bool next(const char*& data, size_t& length, Priority::Value& priority);
+
+        /**
+         * Returns the next frame like next() above, along with the name
+         * of the category the message was logged to, which is not null
+         * terminated.
+         **/
+        bool next(const char*& data, size_t& length, Priority::Value& priority,
+                  const char*& category, size_t& categoryLength);
+
+        /**
+         * Returns whether a frame did not fit the ring, e.g. written by a
+         * foreign or broken producer. Nothing is read from a corrupt ring
+         * anymore; reopen it once the producer recreated it.
+         **/
+        bool isCorrupt() const;
+
+        /**
+         * Consumes the frame returned by the last successful next().
+         **/
+        void release();
+
+        /**
+         * Waits until frames are available.
+         * @param timeoutMilliseconds The maximum time to wait.
+         * @returns true if frames are available, false at once if the
+         * ring is corrupt.
+         **/
+        bool wait(int timeoutMilliseconds);
+
+        /**
+         * Appends the pending frames as LoggingEvents with their original
+         * priority, category, thread name and time to the given appender. Give the appender a
+         * PassThroughLayout to write the messages as formatted by the
+         * producer.
+         * @param maxFrames The maximum number of frames to consume.
+         * @returns the number of frames consumed.
+         **/
+        size_t drainTo(Appender& appender, size_t maxFrames = 1024);
+
+        /**
+         * Returns the number of messages dropped by the producer.
+         **/
+        unsigned long getDropped();
+
+        private:
+        ShmRingReader(const ShmRingReader&);
+        ShmRingReader& operator=(const ShmRingReader&);
+
+        /**
+         * A frame checked to lie within the ring.
+         **/
+        struct Frame {
+            const char* data;
+            size_t length;
+            Priority::Value priority;
+            const char* category;
+            size_t categoryLength;
+            const char* thread;
+            size_t threadLength;
+            long long timeStamp;
+        };
+
+        bool _attach();
+        bool _nextFrame(Frame& frame);
+        bool _setCorrupt();
+
+        int _fd;
+        shmring::Header* _header;
+        unsigned long long _capacity;
+        unsigned long long _pending;
+        bool _corrupt;
+        SharedString _category;
+        SharedString _threadName;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
+#endif // _LOG4CPP_SHMRINGREADER_HH
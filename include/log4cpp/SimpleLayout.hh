@@ -28,6 +28,12 @@ namespace log4cpp {
          * "priority - message"
          **/
         virtual std::string format(const LoggingEvent& event);
+
+        /**
+         * @returns no fields, SimpleLayout prints only the priority and
+         * the message.
+         **/
+        virtual unsigned int getRequiredFields() const;
     };        
 }
 
@@ -14,24 +14,65 @@
 
 #include "Portability.hh"
 #include "LayoutAppender.hh"
+#include <boost/shared_ptr.hpp>
 
 namespace log4cpp
 {
+   /**
+    * SmptAppender mails formatted events from a background thread shared by
+    * all SMTP appenders.
+    *
+    * <p>Events may be collected into digests: a digest is mailed once it
+    * holds a number of events or once its first event is a number of seconds
+    * old, whichever comes first. Connections to the SMTP server are kept
+    * open between mails, and commands are pipelined if the server supports
+    * it. The number of events waiting to be mailed is bounded; events beyond
+    * that bound, and events of mails that could not be delivered, are
+    * dropped and counted.
+    **/
    class LOG4CPP_EXPORT SmptAppender : public LayoutAppender
    {
       public:
          struct mail_params;
 
-         SmptAppender(const std::string& name, const std::string& host, const std::string& from, 
-                      const std::string& to, const std::string& subject);
+         SmptAppender(const std::string& name, const std::string& host, const std::string& from,
+                      const std::string& to, const std::string& subject, unsigned short port = 25);
          virtual ~SmptAppender();
          virtual void close() { }
-      
+
+         /**
+          * @returns the fields the layout needs.
+          **/
+         virtual unsigned int getRequiredFields();
+
+         /**
+          * Sets the digest window. The defaults, 1 event and 0 seconds,
+          * mail every event on its own.
+          * @param max_events The number of events after which a digest
+          * is mailed.
+          * @param max_seconds The age of its first event after which a
+          * digest is mailed. With 0, a digest collects the events logged
+          * while the previous mail was being sent.
+          **/
+         void setDigest(size_t max_events, unsigned int max_seconds);
+
+         /**
+          * Sets the maximum number of events of this appender waiting to be
+          * mailed. Defaults to 1000.
+          **/
+         void setMaxQueued(size_t max_events);
+
+         /**
+          * Returns the number of events dropped because the queue was full
+          * or the mail could not be delivered.
+          **/
+         unsigned long getDropped() const;
+
       protected:
          virtual void _append(const LoggingEvent& event);
 
       private:
-         mail_params * mail_params_;
+         boost::shared_ptr<mail_params> mail_params_;
    };
 }
 
@@ -0,0 +1,132 @@
+/*
+ * SocketEventAppender.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SOCKETEVENTAPPENDER_HH
+#define _LOG4CPP_SOCKETEVENTAPPENDER_HH
+
+#include <log4cpp/Portability.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <string>
+#include <vector>
+#include <log4cpp/AppenderSkeleton.hh>
+#include <log4cpp/EventCodec.hh>
+
+namespace log4cpp {
+
+    class SenderThread;
+
+    /**
+     * SocketEventAppender forwards LoggingEvents in the binary format of
+     * EventCodec over a TCP or Unix domain stream socket. No layout is
+     * applied; the receiver decodes the events with an EventStreamDecoder
+     * and formats them with its own appenders.
+     *
+     * <p>Events are collected into batches which are sent, optionally
+     * compressed, once they reach the batch size, when an event of the
+     * flush priority or higher is appended, when the oldest event waited
+     * for the batch delay, on flush() and on close(). Connecting and
+     * sending happen on a background thread (synchronously where threads
+     * are not available), so logging never waits for the network. When
+     * too much data is waiting or the connection fails, events are
+     * dropped and counted; reconnecting is retried with an exponential
+     * backoff.
+     *
+     * @since 1.1
+     **/
+    class LOG4CPP_EXPORT SocketEventAppender : public AppenderSkeleton {
+        public:
+
+        /**
+         * The default batch size in bytes.
+         **/
+        static const size_t DEFAULT_BATCH_SIZE;
+
+        /**
+         * The default batch delay in milliseconds.
+         **/
+        static const unsigned int DEFAULT_BATCH_DELAY;
+
+        /**
+         * Instantiate a SocketEventAppender.
+         * @param name The name of the Appender.
+         * @param address Either "host:port" for TCP or "unix:path" for a
+         * Unix domain socket.
+         * @param compression The compression applied to batches.
+         * @param batchSize The number of bytes collected before a batch is
+         * sent. 0 sends events as soon as possible.
+         **/
+        SocketEventAppender(const std::string& name, const std::string& address,
+                            EventCodec::Compression compression = EventCodec::NONE,
+                            size_t batchSize = DEFAULT_BATCH_SIZE);
+        virtual ~SocketEventAppender();
+
+        virtual bool reopen();
+        virtual void close();
+
+        /**
+         * The SocketEventAppender does not layout.
+         * @returns false
+         **/
+        virtual bool requiresLayout() const;
+
+        /**
+         * Releases the layout, which the SocketEventAppender does not use.
+         **/
+        virtual void setLayout(Layout* layout);
+
+        /**
+         * Sets the priority at or above which events are sent immediately
+         * together with the pending batch. Defaults to Priority::ERROR.
+         **/
+        void setFlushPriority(Priority::Value priority);
+
+        /**
+         * Sets the time in milliseconds an event waits at most for its
+         * batch to fill up. Defaults to DEFAULT_BATCH_DELAY.
+         **/
+        void setBatchDelay(unsigned int batchDelay);
+
+        /**
+         * Sends the pending batch and waits until it is sent.
+         * @returns false if events were dropped.
+         **/
+        bool flush();
+
+        /**
+         * Returns the number of events dropped because they could not be
+         * sent.
+         **/
+        unsigned long getDropped() const;
+
+        protected:
+        virtual void _append(const LoggingEvent& event);
+        bool _connect();
+        void _disconnect();
+        bool _send(const char* data, size_t length);
+
+        static bool _connectSender(void* appender);
+        static size_t _sendBatch(void* appender, const std::string& records,
+                                 const std::vector<size_t>& sizes, bool& connected);
+
+        const std::string _address;
+        const EventCodec::Compression _compression;
+        Priority::Value _flushPriority;
+        std::string _record;
+
+        // used by the sending thread only
+        int _socket;
+        std::string _block;
+
+        SenderThread* _sender;
+    };
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
+#endif // _LOG4CPP_SOCKETEVENTAPPENDER_HH
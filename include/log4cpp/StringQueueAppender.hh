@@ -32,6 +32,11 @@ namespace log4cpp {
         virtual bool reopen();
         virtual void close();
 
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
         /**
          * Return the current size of the message queue.
          * Shorthand for getQueue().size().
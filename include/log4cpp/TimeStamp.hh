@@ -11,14 +11,39 @@
 #define _LOG4CPP_TIMESTAMP_HH
 
 #include <log4cpp/Portability.hh>
+#ifdef LOG4CPP_HAVE_STDINT_H
+#include <stdint.h>
+#endif
 
 namespace log4cpp {
 
     /**
-     * A simple TimeStamp abstraction
+     * A simple TimeStamp abstraction. Time stamps are kept as 64 bit
+     * nanoseconds since the epoch and read from the clock selected with
+     * setClock().
      **/
     class LOG4CPP_EXPORT TimeStamp {
         public:
+        /**
+           The clocks TimeStamps can be read from. Where a clock is not
+           available, REALTIME is used instead.
+           @since 1.1
+        **/
+        typedef enum {
+            /** The system wall clock, as precise as the platform allows. */
+            REALTIME,
+            /** The wall clock as of the last timer tick, typically with a
+                resolution of a few milliseconds, but the cheapest to read. */
+            REALTIME_COARSE,
+            /** The processor's time stamp counter, its rate measured
+                against a monotonic clock, which wall clock steps do not
+                skew, and its offset resynchronized with the wall clock
+                every second; as cheap as REALTIME_COARSE with the
+                precision of REALTIME, but only available on x86
+                processors with an invariant counter. */
+            TSC
+        } Clock;
+
         /**
            Constructs a TimeStamp representing 'now'.
         **/
@@ -30,11 +55,18 @@ namespace log4cpp {
         **/
         TimeStamp(unsigned int seconds, unsigned int microSeconds = 0);
 
+        /**
+           Returns a TimeStamp representing the given number of
+           nanoseconds since the epoch.
+           @since 1.1
+        **/
+        static TimeStamp fromNanoSeconds(int64_t nanoSecondsSinceEpoch);
+
         /**
            Returns the 'seconds' part of the TimeStamp.
         **/
-        inline int getSeconds() const {
-            return _seconds;
+        inline int64_t getSeconds() const {
+            return _nanoSeconds / 1000000000;
         };
 
         /** 
@@ -42,7 +74,7 @@ namespace log4cpp {
            getMilliSeconds() == getMicroSeconds() / 1000. 
         **/
         inline int getMilliSeconds() const {
-            return _microSeconds / 1000;
+            return getNanoSeconds() / 1000000;
         };
 
         /**
@@ -51,7 +83,24 @@ namespace log4cpp {
            may be in the order of milliseconds rather than microseconds.
          **/
         inline int getMicroSeconds() const {
-            return _microSeconds;
+            return getNanoSeconds() / 1000;
+        };
+
+        /**
+           Returns the subsecond part of the TimeStamp in nanoseconds,
+           with the precision of the clock it was read from.
+           @since 1.1
+         **/
+        inline int getNanoSeconds() const {
+            return static_cast<int>(_nanoSeconds % 1000000000);
+        };
+
+        /**
+           Returns the TimeStamp as nanoseconds since the epoch.
+           @since 1.1
+         **/
+        inline int64_t getNanoSecondsSinceEpoch() const {
+            return _nanoSeconds;
         };
 
         /**
@@ -62,13 +111,26 @@ namespace log4cpp {
             return _startStamp;
         };
 
+        /**
+           Selects the clock new TimeStamps are read from, for all threads.
+           Selecting TSC calibrates the counter, which takes about 10
+           milliseconds.
+           @returns the clock actually selected.
+           @since 1.1
+        **/
+        static Clock setClock(Clock clock);
+
+        /**
+           Returns the clock new TimeStamps are read from.
+           @since 1.1
+        **/
+        static Clock getClock();
+
         protected:
         static TimeStamp _startStamp;
 
-        int _seconds;
-        int _microSeconds;
+        int64_t _nanoSeconds;
     };
 }
 
 #endif // _LOG4CPP_TIMESTAMP_HH
-
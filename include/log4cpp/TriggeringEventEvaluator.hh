@@ -12,11 +12,40 @@
 
 namespace log4cpp
 {
+   /**
+    * Decides when a BufferingAppender passes its buffered events on.
+    **/
    class LOG4CPP_EXPORT TriggeringEventEvaluator
    {
       public:
+         /**
+          * Receives triggers which do not come with an event, e.g. from
+          * a timer.
+          * @since 1.1
+          **/
+         class LOG4CPP_EXPORT Trigger
+         {
+            public:
+               virtual void trigger() = 0;
+               virtual ~Trigger() {}
+         };
+
          virtual bool eval(const LoggingEvent& event) const = 0;
          virtual ~TriggeringEventEvaluator() {}
+
+         /**
+          * Attaches the trigger an evaluator fires on its own, or detaches
+          * it with NULL. The trigger must stay valid until detached.
+          * @since 1.1
+          **/
+         virtual void attach(Trigger*) {}
+
+         /**
+          * Called once the buffered events were passed on, for whatever
+          * reason, to start a new batch.
+          * @since 1.1
+          **/
+         virtual void reset() const {}
    };
 }
 
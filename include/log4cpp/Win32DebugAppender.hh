@@ -40,6 +40,11 @@ namespace log4cpp {
 		 */
         virtual void close();
 
+        /**
+         * @returns the fields the layout needs.
+         **/
+        virtual unsigned int getRequiredFields();
+
         protected:
 		/**
 		 * Method that does the actual work.  In this case, it simply sets up the layout
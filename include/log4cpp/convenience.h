@@ -8,6 +8,8 @@
 #ifndef LOG4CPP_CONVENIENCE_H
 #define LOG4CPP_CONVENIENCE_H
 
+#include <log4cpp/Portability.hh>
+
 #define LOG4CPP_LOGGER(name) \
   static log4cpp::Category& logger = log4cpp::Category::getInstance( name );
 
@@ -43,6 +45,38 @@
    if (logger.isDebugEnabled()) logger.debug( msg );
 
 
+// printf logging, parsing each format once per call site; formats must
+// be string literals
+#ifdef LOG4CPP_HAVE_VARIADIC_MACROS
+#define LOG4CPP_EMERG_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::EMERG, format, ##__VA_ARGS__)
+
+#define LOG4CPP_FATAL_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::FATAL, format, ##__VA_ARGS__)
+
+#define LOG4CPP_ALERT_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::ALERT, format, ##__VA_ARGS__)
+
+#define LOG4CPP_CRIT_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::CRIT, format, ##__VA_ARGS__)
+
+#define LOG4CPP_ERROR_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::ERROR, format, ##__VA_ARGS__)
+
+#define LOG4CPP_WARN_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::WARN, format, ##__VA_ARGS__)
+
+#define LOG4CPP_NOTICE_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::NOTICE, format, ##__VA_ARGS__)
+
+#define LOG4CPP_INFO_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::INFO, format, ##__VA_ARGS__)
+
+#define LOG4CPP_DEBUG_F(logger, format, ...) \
+   LOG4CPP_PRINTF(logger, log4cpp::Priority::DEBUG, format, ##__VA_ARGS__)
+#endif
+
+
 // stream logging
 #define LOG4CPP_EMERG_S(logger) \
    if (logger.isEmergEnabled()) logger.emergStream()
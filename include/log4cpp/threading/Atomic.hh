@@ -0,0 +1,121 @@
+/*
+ * Atomic.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_THREADING_ATOMIC_HH
+#define _LOG4CPP_THREADING_ATOMIC_HH
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/threading/Threading.hh>
+
+#if defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define LOG4CPP_HAVE_ATOMIC_BUILTINS 1
+#endif
+
+namespace log4cpp {
+    namespace threading {
+
+        /**
+         * An integral or pointer value accessed atomically. Loads acquire,
+         * stores release and read-modify-write operations are sequentially
+         * consistent. Compilers without atomic builtins fall back to a
+         * mutex.
+         *
+         * @since 1.1
+         **/
+        template<typename T> class Atomic {
+            public:
+            inline Atomic(T value = T()) :
+                _value(value) {
+            }
+
+#ifdef LOG4CPP_HAVE_ATOMIC_BUILTINS
+            inline T load() const {
+                return __atomic_load_n(&_value, __ATOMIC_ACQUIRE);
+            }
+
+            inline T loadRelaxed() const {
+                return __atomic_load_n(&_value, __ATOMIC_RELAXED);
+            }
+
+            inline void store(T value) {
+                __atomic_store_n(&_value, value, __ATOMIC_RELEASE);
+            }
+
+            inline T exchange(T value) {
+                return __atomic_exchange_n(&_value, value, __ATOMIC_SEQ_CST);
+            }
+
+            /**
+             * Replaces the value by desired if it equals expected.
+             * Otherwise, expected receives the current value.
+             * @returns whether the value was replaced.
+             **/
+            inline bool compareExchange(T& expected, T desired) {
+                return __atomic_compare_exchange_n(&_value, &expected, desired, false,
+                                                   __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+            }
+
+            /**
+             * @returns the value before the addition.
+             **/
+            inline T fetchAdd(T increment) {
+                return __atomic_fetch_add(&_value, increment, __ATOMIC_SEQ_CST);
+            }
+#else
+            inline T load() const {
+                threading::ScopedLock lock(_mutex);
+                return _value;
+            }
+
+            inline T loadRelaxed() const {
+                return load();
+            }
+
+            inline void store(T value) {
+                threading::ScopedLock lock(_mutex);
+                _value = value;
+            }
+
+            inline T exchange(T value) {
+                threading::ScopedLock lock(_mutex);
+                T previous = _value;
+                _value = value;
+                return previous;
+            }
+
+            inline bool compareExchange(T& expected, T desired) {
+                threading::ScopedLock lock(_mutex);
+                if (_value != expected) {
+                    expected = _value;
+                    return false;
+                }
+                _value = desired;
+                return true;
+            }
+
+            inline T fetchAdd(T increment) {
+                threading::ScopedLock lock(_mutex);
+                T previous = _value;
+                _value += increment;
+                return previous;
+            }
+#endif
+
+            private:
+            Atomic(const Atomic& other);
+            Atomic& operator=(const Atomic& other);
+
+            T _value;
+#ifndef LOG4CPP_HAVE_ATOMIC_BUILTINS
+            mutable threading::Mutex _mutex;
+#endif
+        };
+    }
+}
+
+#endif // _LOG4CPP_THREADING_ATOMIC_HH
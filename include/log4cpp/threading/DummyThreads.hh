@@ -33,7 +33,7 @@ namespace log4cpp {
             public:
             typedef T data_type;
 
-            inline ThreadLocalDataHolder() {};
+            inline ThreadLocalDataHolder() : _data(NULL) {};
             inline ~ThreadLocalDataHolder() {
                 if (_data) 
                     delete _data;
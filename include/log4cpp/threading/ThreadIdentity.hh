@@ -0,0 +1,46 @@
+/*
+ * ThreadIdentity.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_THREADING_THREADIDENTITY_HH
+#define _LOG4CPP_THREADING_THREADIDENTITY_HH
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/SharedString.hh>
+#include <string>
+
+namespace log4cpp {
+    namespace threading {
+
+        /**
+         * Returns the name logging events of the current thread carry,
+         * which is its id as returned by getThreadId() unless set by
+         * setThreadName(). It is made once per thread.
+         * @since 1.1
+         **/
+        LOG4CPP_EXPORT const SharedString& getThreadName();
+
+        /**
+         * Names the current thread in its logging events from now on.
+         * Where the platform allows, the name is also given to the thread
+         * itself, so that debuggers and top show it, truncated to 15
+         * characters. An empty name goes back to the id.
+         * @since 1.1
+         **/
+        LOG4CPP_EXPORT void setThreadName(const std::string& name);
+
+        /**
+         * Returns the id the operating system knows the current thread
+         * by, e.g. gettid() on Linux, or 0 where there is none. It is
+         * looked up once per thread.
+         * @since 1.1
+         **/
+        LOG4CPP_EXPORT unsigned long getSystemThreadId();
+    }
+}
+
+#endif // _LOG4CPP_THREADING_THREADIDENTITY_HH
@@ -0,0 +1,191 @@
+/*
+ * Allocator.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/Allocator.hh>
+#include "Pool.hh"
+#include <new>
+
+namespace log4cpp {
+
+    namespace {
+        /**
+         * Blocks come in classes of 64 to 4096 bytes, each class carved
+         * from slabs of slabSize bytes. Larger blocks come from the system.
+         **/
+        const size_t classCount = 7;
+        const size_t smallestClass = 64;
+        const size_t largestClass = smallestClass << (classCount - 1);
+        const size_t slabSize = 64 * 1024;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct ThreadCache {
+            ThreadCache() {
+                for (size_t i = 0; i < classCount; ++i)
+                    free[i] = NULL;
+            }
+
+            FreeBlock* free[classCount];
+            pool::RemoteList<FreeBlock> remote[classCount];
+
+            // only ever written by the thread owning the cache
+            threading::Atomic<unsigned long> allocations;
+            threading::Atomic<unsigned long> deallocations;
+            threading::Atomic<unsigned long> bytesAllocated;
+            threading::Atomic<unsigned long> bytesFreed;
+            threading::Atomic<unsigned long> systemAllocations;
+            threading::Atomic<unsigned long> systemBytes;
+        };
+
+        typedef pool::ThreadCaches<ThreadCache> Caches;
+
+        /**
+         * Precedes each block. Pooled blocks have an owner, blocks of an
+         * installed Allocator have that, and large blocks neither.
+         **/
+        struct Header {
+            Allocator* allocator;
+            ThreadCache* owner;
+        };
+
+        inline void add(threading::Atomic<unsigned long>& counter, size_t value) {
+            counter.store(counter.loadRelaxed() + static_cast<unsigned long>(value));
+        }
+
+        inline size_t classOf(size_t size) {
+            size_t index = 0;
+            for (size_t classSize = smallestClass; classSize < size; classSize <<= 1)
+                ++index;
+            return index;
+        }
+
+        threading::Atomic<Allocator*>& installed() {
+            static threading::Atomic<Allocator*> allocator;
+            return allocator;
+        }
+
+        void* allocateSystem(ThreadCache& cache, size_t size) {
+            add(cache.systemAllocations, 1);
+            add(cache.systemBytes, size);
+            return ::operator new(size);
+        }
+
+        FreeBlock* refill(ThreadCache& cache, size_t index) {
+            FreeBlock* first = cache.remote[index].takeAll();
+            if (first)
+                return first;
+
+            const size_t size = smallestClass << index;
+            char* slab = static_cast<char*>(allocateSystem(cache, slabSize));
+            for (char* block = slab + slabSize - size; ; block -= size) {
+                FreeBlock* free = reinterpret_cast<FreeBlock*>(block);
+                free->next = first;
+                first = free;
+                if (block == slab)
+                    return first;
+            }
+        }
+    }
+
+    namespace pool {
+        void countSystemAllocation(size_t bytes) {
+            ThreadCache& cache = Caches::get();
+            add(cache.systemAllocations, 1);
+            add(cache.systemBytes, bytes);
+        }
+    }
+
+    Allocator::~Allocator() {
+    }
+
+    void Allocator::setAllocator(Allocator* allocator) {
+        installed().store(allocator);
+    }
+
+    Allocator* Allocator::getAllocator() {
+        return installed().load();
+    }
+
+    void* Allocator::allocateBlock(size_t size) {
+        ThreadCache& cache = Caches::get();
+        add(cache.allocations, 1);
+        add(cache.bytesAllocated, size);
+
+        const size_t total = size + sizeof(Header);
+        Allocator* allocator = installed().load();
+        Header* header;
+        if (allocator) {
+            add(cache.systemAllocations, 1);
+            add(cache.systemBytes, total);
+            header = static_cast<Header*>(allocator->allocate(total));
+            header->allocator = allocator;
+            header->owner = NULL;
+        } else if (total > largestClass) {
+            header = static_cast<Header*>(allocateSystem(cache, total));
+            header->allocator = NULL;
+            header->owner = NULL;
+        } else {
+            const size_t index = classOf(total);
+            FreeBlock* block = cache.free[index];
+            if (!block)
+                block = refill(cache, index);
+            cache.free[index] = block->next;
+
+            header = reinterpret_cast<Header*>(block);
+            header->allocator = NULL;
+            header->owner = &cache;
+        }
+        return header + 1;
+    }
+
+    void Allocator::deallocateBlock(void* block, size_t size) throw() {
+        if (!block)
+            return;
+
+        ThreadCache& cache = Caches::get();
+        add(cache.deallocations, 1);
+        add(cache.bytesFreed, size);
+
+        Header* header = static_cast<Header*>(block) - 1;
+        const size_t total = size + sizeof(Header);
+        ThreadCache* owner = header->owner;
+        if (header->allocator) {
+            header->allocator->deallocate(header, total);
+        } else if (!owner) {
+            ::operator delete(header);
+        } else {
+            const size_t index = classOf(total);
+            FreeBlock* free = reinterpret_cast<FreeBlock*>(header);
+            if (owner == &cache) {
+                free->next = cache.free[index];
+                cache.free[index] = free;
+            } else {
+                owner->remote[index].push(free);
+            }
+        }
+    }
+
+    Allocator::Statistics Allocator::getStatistics() {
+        std::vector<ThreadCache*> caches;
+        Caches::getAll(caches);
+
+        Statistics statistics = Statistics();
+        for (std::vector<ThreadCache*>::const_iterator i = caches.begin(); i != caches.end(); ++i) {
+            statistics.allocations += (*i)->allocations.load();
+            statistics.deallocations += (*i)->deallocations.load();
+            statistics.bytesAllocated += (*i)->bytesAllocated.load();
+            statistics.bytesFreed += (*i)->bytesFreed.load();
+            statistics.systemAllocations += (*i)->systemAllocations.load();
+            statistics.systemBytes += (*i)->systemBytes.load();
+        }
+        return statistics;
+    }
+}
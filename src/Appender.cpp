@@ -121,4 +121,14 @@ namespace log4cpp {
     Appender::~Appender() {
         _removeAppender(this);
     }
+
+    void Appender::doAppendBatch(const LoggingEvent* const* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            doAppend(*events[i]);
+        }
+    }
+
+    unsigned int Appender::getRequiredFields() {
+        return LoggingEvent::ALL_FIELDS;
+    }
 }
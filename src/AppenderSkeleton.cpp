@@ -9,6 +9,8 @@
 
 #include "PortabilityImpl.hh"
 #include <log4cpp/AppenderSkeleton.hh>
+#include <log4cpp/Category.hh>
+#include <vector>
 
 namespace log4cpp {
 
@@ -29,12 +31,46 @@ namespace log4cpp {
     
     void AppenderSkeleton::doAppend(const LoggingEvent& event) {
         if ((Priority::NOTSET == _threshold) || (event.priority <= _threshold)) {
+            // filters may keep state, so they are serialized as well
+            threading::ScopedLock lock(_appendMutex);
             if (!_filter || (_filter->decide(event) != Filter::DENY)) {
                 _append(event);
             }
         }
     }
 
+    void AppenderSkeleton::doAppendBatch(const LoggingEvent* const* events, size_t count) {
+        threading::ScopedLock lock(_appendMutex);
+        // usually all events pass, which needs no copy of the batch
+        size_t passed = 0;
+        while (passed < count && _accepts(*events[passed]))
+            passed++;
+        if (passed == count) {
+            _appendBatch(events, count);
+            return;
+        }
+
+        std::vector<const LoggingEvent*> accepted(events, events + passed);
+        for (size_t i = passed + 1; i < count; i++) {
+            if (_accepts(*events[i]))
+                accepted.push_back(events[i]);
+        }
+        if (!accepted.empty()) {
+            _appendBatch(&accepted[0], accepted.size());
+        }
+    }
+
+    bool AppenderSkeleton::_accepts(const LoggingEvent& event) {
+        return ((Priority::NOTSET == _threshold) || (event.priority <= _threshold)) &&
+               (!_filter || (_filter->decide(event) != Filter::DENY));
+    }
+
+    void AppenderSkeleton::_appendBatch(const LoggingEvent* const* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            _append(*events[i]);
+        }
+    }
+
     void AppenderSkeleton::setThreshold(Priority::Value priority) {
         _threshold = priority;
     }
@@ -49,6 +85,8 @@ namespace log4cpp {
                 delete _filter;
             
             _filter = filter;
+            // filters may look at any field
+            Category::requiredFieldsChanged();
         }
     }
     
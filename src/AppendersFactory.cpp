@@ -22,6 +22,12 @@ namespace log4cpp
    std::auto_ptr<Appender> create_win32_debug_appender(const FactoryParams&);
    std::auto_ptr<Appender> create_abort_appender(const FactoryParams&);
    std::auto_ptr<Appender> create_smtp_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_journald_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_shm_ring_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_socket_event_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_http_bulk_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_gelf_appender(const FactoryParams&);
+   std::auto_ptr<Appender> create_concurrent_queue_appender(const FactoryParams&);
 
    AppendersFactory& AppendersFactory::getInstance()
    {
@@ -36,6 +42,7 @@ namespace log4cpp
          af->registerCreator("remote syslog", &create_remote_syslog_appender);
 #endif
          af->registerCreator("abort", &create_abort_appender);
+         af->registerCreator("concurrent queue", &create_concurrent_queue_appender);
 
 #if defined(LOG4CPP_HAVE_LIBIDSA)
          af->registerCreator("idsa", &create_idsa_appender);
@@ -45,6 +52,17 @@ namespace log4cpp
          af->registerCreator("syslog", &create_syslog_appender);
 #endif
 
+#if defined(LOG4CPP_HAVE_SYS_UN_H)
+         af->registerCreator("journald", &create_journald_appender);
+         af->registerCreator("socket event", &create_socket_event_appender);
+         af->registerCreator("http bulk", &create_http_bulk_appender);
+         af->registerCreator("gelf", &create_gelf_appender);
+#endif
+
+#if defined(LOG4CPP_HAVE_SYS_MMAN_H)
+         af->registerCreator("shm ring", &create_shm_ring_appender);
+#endif
+
 #if defined(WIN32)
          af->registerCreator("win32 debug", &create_win32_debug_appender);
          af->registerCreator("nt event log", &create_nt_event_log_appender);
@@ -36,6 +36,10 @@ namespace log4cpp {
         return message.str();
     }
 
+    unsigned int BasicLayout::getRequiredFields() const {
+        return LoggingEvent::FIELD_TIMESTAMP | LoggingEvent::FIELD_NDC;
+    }
+
     std::auto_ptr<Layout> create_basic_layout(const FactoryParams& params)
     {
        return std::auto_ptr<Layout>(new BasicLayout);
@@ -7,47 +7,86 @@
 #include "PortabilityImpl.hh"
 #include <log4cpp/BufferingAppender.hh>
 #include <algorithm>
-#include <sstream>
 #include <memory>
+#include <new>
 
 namespace log4cpp
 {
    BufferingAppender::BufferingAppender(const std::string name, unsigned long max_size, 
                                         std::auto_ptr<Appender> sink, std::auto_ptr<TriggeringEventEvaluator> evaluator) 
-                     :LayoutAppender(name), max_size_(max_size), sink_(sink), evaluator_(evaluator), lossy_(false)
+                     :LayoutAppender(name), ring_(0), first_(0), size_(0), max_size_(max_size), sink_(sink), evaluator_(evaluator), lossy_(false)
    {
       max_size_ = (max)(1UL, max_size_);
+      ring_ = static_cast<LoggingEvent*>(::operator new(max_size_ * sizeof(LoggingEvent)));
+      batch_.reserve(max_size_);
+      evaluator_->attach(this);
+   }
+
+   BufferingAppender::~BufferingAppender()
+   {
+      evaluator_->attach(0);
+      clear();
+      ::operator delete(ring_);
    }
    
    void BufferingAppender::_append(const LoggingEvent& event)
    {
-      if (queue_.size() == max_size_)
+      if (size_ == max_size_)
+      {
          if (lossy_)
-            queue_.pop_back();
+         {
+            ring_[first_].~LoggingEvent();
+            first_ = (first_ + 1) % max_size_;
+            --size_;
+         }
          else
             dump();
+      }
 
-      queue_.push_front(event);
+// MSVC's <crtdbg.h> requires redefinition of the new operator, but could not deal with placement new form of it
+#ifdef MSVC_MEMORY_LEAK_CHECK
+#pragma push_macro("new")
+#undef new
+#define new new
+#endif // MSVC_MEMORY_LEAK_CHECK
+      new (&ring_[(first_ + size_) % max_size_]) LoggingEvent(event); // placement new
+#ifdef MSVC_MEMORY_LEAK_CHECK
+#pragma pop_macro("new")
+#endif // MSVC_MEMORY_LEAK_CHECK
+      ++size_;
       
       if (evaluator_->eval(event))
-      {
          dump();
-         queue_.clear();
-      }
    }
 
-   static const std::string EMPTY;
-   
    void BufferingAppender::dump()
    {
-      Layout& layout = _getLayout();
-      std::ostringstream s;
-      //  Solaris 10 CC can't work with const_reverse_iterator
-      for(queue_t::reverse_iterator i = queue_.rbegin(), last = queue_.rend(); i != last; ++i)
-         s << layout.format(*i);
-
-      LoggingEvent event(EMPTY, s.str(), EMPTY, Priority::NOTSET);
-      sink_->doAppend(event);
+      batch_.clear();
+      for (unsigned long i = 0; i < size_; ++i)
+         batch_.push_back(&ring_[(first_ + i) % max_size_]);
+
+      if (!batch_.empty())
+         sink_->doAppendBatch(&batch_[0], batch_.size());
+      clear();
+      evaluator_->reset();
    }
-}
 
+   void BufferingAppender::flush()
+   {
+      threading::ScopedLock lock(_appendMutex);
+      dump();
+   }
+
+   void BufferingAppender::trigger()
+   {
+      flush();
+   }
+
+   void BufferingAppender::clear()
+   {
+      for (unsigned long i = 0; i < size_; ++i)
+         ring_[(first_ + i) % max_size_].~LoggingEvent();
+      first_ = 0;
+      size_ = 0;
+   }
+}
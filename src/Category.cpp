@@ -13,13 +13,105 @@
 #    include <unistd.h>
 #endif
 
+#ifdef LOG4CPP_USE_PTHREADS
+#    include <pthread.h>
+#endif
+
 #include <log4cpp/Category.hh>
 #include <log4cpp/HierarchyMaintainer.hh>
 #include <log4cpp/NDC.hh>
-#include "StringUtil.hh"
+#include "FormatMemo.hh"
+#include "Pool.hh"
+#include <algorithm>
+#include <new>
 
 namespace log4cpp {
 
+    namespace {
+        /**
+         * Counts the requiredFieldsChanged() calls. Never destroyed, as
+         * layouts and appenders may still be deleted at exit.
+         **/
+        threading::Atomic<unsigned long>& fieldsGeneration() {
+            static threading::Atomic<unsigned long>* generation =
+                new threading::Atomic<unsigned long>(1);
+            return *generation;
+        }
+
+        const unsigned int fieldsBits = 8;
+        const unsigned long fieldsMask = (1UL << fieldsBits) - 1;
+
+        /**
+         * The NDC of events which do not capture it.
+         **/
+        const NDC::ContextStack& noContext() {
+            static const NDC::ContextStack* empty = new NDC::ContextStack();
+            return *empty;
+        }
+
+        /**
+         * The dispatch lists a thread iterates over, innermost last.
+         **/
+        struct DispatchThread {
+            std::vector<const void*> held;
+        };
+
+        DispatchThread& dispatchThread() {
+            // never destroyed, so that statics may still log while the program exits
+            static threading::ThreadLocalDataHolder<DispatchThread>* holder =
+                new threading::ThreadLocalDataHolder<DispatchThread>();
+            DispatchThread* thread = holder->get();
+            if (!thread) {
+                thread = new DispatchThread();
+                holder->reset(thread);
+            }
+            return *thread;
+        }
+
+#ifdef LOG4CPP_USE_PTHREADS
+        /**
+         * Wakes the threads waiting in _retireDispatch(), shared by all
+         * categories as waiting is rare.
+         **/
+        pthread_mutex_t retireMutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_cond_t retireCondition = PTHREAD_COND_INITIALIZER;
+#else
+        /**
+         * Lets the threads still iterating over a retired list go on.
+         **/
+        void pause() {
+#if defined(LOG4CPP_USE_MSTHREADS)
+            ::Sleep(0);
+#elif defined(LOG4CPP_HAVE_UNISTD_H)
+            ::usleep(10);
+#endif
+        }
+#endif
+    }
+
+    class Category::Dispatch {
+        public:
+        Dispatch() :
+            inFlight(1),
+            retired(0),
+            waiting(0),
+            successor(NULL) {
+        }
+
+        AppenderList appenders;
+        // the calls iterating over the list, plus one while published and
+        // one until the list it replaced is recycled
+        threading::Atomic<int> inFlight;
+        // set from retirement until recycled by the last release
+        threading::Atomic<int> retired;
+        // the threads waiting for the calls to return
+        threading::Atomic<int> waiting;
+        // owned appenders removed with the list, deleted when recycled
+        AppenderList removed;
+        // the list which replaced this one, recycled after it
+        Dispatch* successor;
+    };
+
     Category& Category::getRoot() {
         return getInstance("");
     }
@@ -59,15 +151,23 @@ namespace log4cpp {
         _name(name),
         _parent(parent),
         _priority(priority),
+        _requiredFields(0),
+        _dispatch(new Dispatch()),
         _isAdditive(true) {
     }
 
     Category::~Category() {
-        removeAllAppenders();
+        // the last call using the old list would recycle it into this category
+        _removeAllAppenders(true);
+        delete _dispatch.load();
+        for (std::vector<Dispatch*>::iterator i = _spareDispatch.begin();
+             i != _spareDispatch.end(); i++) {
+            delete (*i);
+        }
     }
 
     const std::string& Category::getName() const throw() {
-        return _name; 
+        return _name.str(); 
     }
     
     Priority::Value Category::getPriority() const throw() { 
@@ -98,29 +198,37 @@ namespace log4cpp {
     
     void Category::addAppender(Appender* appender) {
         if (appender) {
-            threading::ScopedLock lock(_appenderSetMutex);
+            Dispatch* retired = NULL;
             {
+                threading::ScopedLock lock(_appenderSetMutex);
                 AppenderSet::iterator i = _appender.find(appender);
                 if (_appender.end() == i) {
                     // not found
                     _appender.insert(appender);
                     _ownsAppender[appender] = true;
+                    retired = _updateDispatch();
                 }
             }
+            if (retired)
+                _retireDispatch(retired, AppenderList(), false);
         } else {
             throw std::invalid_argument("NULL appender");
         }
     }
     
     void Category::addAppender(Appender& appender) {
-        threading::ScopedLock lock(_appenderSetMutex);
+        Dispatch* retired = NULL;
         {
+            threading::ScopedLock lock(_appenderSetMutex);
             AppenderSet::iterator i = _appender.find(&appender);
             if (_appender.end() == i) {
                 _appender.insert(&appender);
                 _ownsAppender[&appender] = false;
+                retired = _updateDispatch();
             }
         }
+        if (retired)
+            _retireDispatch(retired, AppenderList(), false);
     }
     
     Appender* Category::getAppender() const {
@@ -153,37 +261,52 @@ namespace log4cpp {
     }
 
     void Category::removeAllAppenders() {
-        threading::ScopedLock lock(_appenderSetMutex);
+        _removeAllAppenders(false);
+    }
+
+    void Category::_removeAllAppenders(bool wait) {
+        Dispatch* retired;
+        AppenderList removed;
         {
+            threading::ScopedLock lock(_appenderSetMutex);
             for (AppenderSet::iterator i = _appender.begin();
                  i != _appender.end(); i++) {
                 // found
                 OwnsAppenderMap::iterator i2;
                 if (ownsAppender(*i, i2)) {
-                    delete (*i);
+                    removed.push_back(*i);
                 }
             }
 
             _ownsAppender.clear();
             _appender.clear();           
+            retired = _updateDispatch();
         }
+        // the caller may delete the appenders it owns once they are removed
+        _retireDispatch(retired, removed, wait || removed.size() != retired->appenders.size());
     }
 
     void Category::removeAppender(Appender* appender) {
-        threading::ScopedLock lock(_appenderSetMutex);
+        Dispatch* retired = NULL;
+        AppenderList removed;
         {
+            threading::ScopedLock lock(_appenderSetMutex);
             AppenderSet::iterator i = _appender.find(appender);
             if (_appender.end() != i) {            
                 OwnsAppenderMap::iterator i2;
                 if (ownsAppender(*i, i2)) {
                     _ownsAppender.erase(i2);
-                    delete (*i);
+                    removed.push_back(*i);
                 }
                 _appender.erase(i);
+                retired = _updateDispatch();
             } else {
                 // appender not found 
             }
         }
+        // the caller may delete an appender it owns once it is removed
+        if (retired)
+            _retireDispatch(retired, removed, removed.empty());
     }
 
     bool Category::ownsAppender(Appender* appender) const throw() {
@@ -221,23 +344,190 @@ namespace log4cpp {
         return owned;
     }
 
-    void Category::callAppenders(const LoggingEvent& event) throw() {
-        threading::ScopedLock lock(_appenderSetMutex);
-        {
-            if (!_appender.empty()) {
-                for(AppenderSet::const_iterator i = _appender.begin();
-                    i != _appender.end(); i++) {
-                    (*i)->doAppend(event);
+    /* assume lock is held */
+    Category::Dispatch* Category::_updateDispatch() {
+        // reuse a spare list no thread counts itself on, even for a moment
+        Dispatch* dispatch = NULL;
+        for (size_t i = _spareDispatch.size(); i-- > 0; ) {
+            if (_spareDispatch[i]->inFlight.fetchAdd(0) == 0) {
+                dispatch = _spareDispatch[i];
+                _spareDispatch[i] = _spareDispatch.back();
+                _spareDispatch.pop_back();
+                dispatch->inFlight.fetchAdd(1);
+                break;
+            }
+        }
+        if (!dispatch)
+            dispatch = new Dispatch();
+
+        dispatch->appenders.assign(_appender.begin(), _appender.end());
+        // older lists may still hold the appenders removed with this one
+        dispatch->inFlight.fetchAdd(1);
+        Dispatch* previous = _dispatch.exchange(dispatch);
+        previous->successor = dispatch;
+        requiredFieldsChanged();
+        return previous;
+    }
+
+    void Category::_retireDispatch(Dispatch* dispatch, const AppenderList& removed, bool wait) {
+        dispatch->removed = removed;
+        dispatch->retired.store(1);
+
+        if (wait) {
+            // calls of this thread which are still iterating over the list,
+            // e.g. when an appender removes itself, cannot be waited for,
+            // nor a list it replaced, which holds it until recycled
+            DispatchThread& thread = dispatchThread();
+            int own = 0;
+            bool behind = false;
+            for (std::vector<const void*>::const_iterator i = thread.held.begin(); i != thread.held.end(); i++) {
+                if (*i == dispatch) {
+                    own++;
+                    continue;
+                }
+                for (const Dispatch* d = static_cast<const Dispatch*>(*i); d && !behind; d = d->successor) {
+                    behind = (d == dispatch);
                 }
             }
+            if (behind)
+                own++;
+#ifdef LOG4CPP_USE_PTHREADS
+            ::pthread_mutex_lock(&retireMutex);
+            dispatch->waiting.fetchAdd(1);
+            while (dispatch->inFlight.fetchAdd(0) > own + 1) {
+                ::pthread_cond_wait(&retireCondition, &retireMutex);
+            }
+            dispatch->waiting.fetchAdd(-1);
+            ::pthread_mutex_unlock(&retireMutex);
+#else
+            while (dispatch->inFlight.fetchAdd(0) > own + 1) {
+                pause();
+            }
+#endif
+        }
+
+        // no longer published
+        _dropDispatch(dispatch);
+    }
+
+    void Category::_dropDispatch(Dispatch* dispatch) throw() {
+        // recycling a list releases its successor, iteratively rather
+        // than recursively as many may be queued behind a slow call
+        while (dispatch->inFlight.fetchAdd(-1) == 1) {
+            // a thread counting on a spare list for a moment gets here too
+            int retired = 1;
+            if (!dispatch->retired.compareExchange(retired, 0))
+                return;
+
+            Dispatch* successor = dispatch->successor;
+            _recycleDispatch(dispatch);
+            dispatch = successor;
+        }
+
+        if (dispatch->waiting.load()) {
+#ifdef LOG4CPP_USE_PTHREADS
+            ::pthread_mutex_lock(&retireMutex);
+            ::pthread_cond_broadcast(&retireCondition);
+            ::pthread_mutex_unlock(&retireMutex);
+#endif
+        }
+    }
+
+    void Category::_recycleDispatch(Dispatch* dispatch) throw() {
+        for (AppenderList::const_iterator i = dispatch->removed.begin(); i != dispatch->removed.end(); i++) {
+            delete (*i);
+        }
+        dispatch->removed.clear();
+        dispatch->successor = NULL;
+
+        threading::ScopedLock lock(_appenderSetMutex);
+        _spareDispatch.push_back(dispatch);
+    }
+
+    Category::Dispatch* Category::_acquireDispatch() throw() {
+        // counting on a list first and checking that it is still the
+        // published one then keeps writers from reusing it meanwhile
+        Dispatch* dispatch = _dispatch.load();
+        for (;;) {
+            dispatch->inFlight.fetchAdd(1);
+            Dispatch* current = _dispatch.load();
+            if (current == dispatch)
+                break;
+            _dropDispatch(dispatch);
+            dispatch = current;
         }
+        dispatchThread().held.push_back(dispatch);
+        return dispatch;
+    }
+
+    void Category::_releaseDispatch(Dispatch* dispatch) throw() {
+        dispatchThread().held.pop_back();
+        _dropDispatch(dispatch);
+    }
+
+    void Category::callAppenders(const LoggingEvent& event) throw() {
+        const LoggingEvent* events = &event;
+        FormatMemo memo(&events, 1);
+        Dispatch* dispatch = _acquireDispatch();
+        for (AppenderList::const_iterator i = dispatch->appenders.begin();
+             i != dispatch->appenders.end(); i++) {
+            (*i)->doAppend(event);
+        }
+        _releaseDispatch(dispatch);
+
         if (getAdditivity() && (getParent() != NULL)) {
             getParent()->callAppenders(event);
         }
     }
 
+    void Category::callAppenders(const LoggingEvent* const* events,
+                                 size_t count) throw() {
+        FormatMemo memo(events, count);
+        Dispatch* dispatch = _acquireDispatch();
+        for (AppenderList::const_iterator i = dispatch->appenders.begin();
+             i != dispatch->appenders.end(); i++) {
+            (*i)->doAppendBatch(events, count);
+        }
+        _releaseDispatch(dispatch);
+
+        if (getAdditivity() && (getParent() != NULL)) {
+            getParent()->callAppenders(events, count);
+        }
+    }
+
+    unsigned int Category::getRequiredFields() throw() {
+        const unsigned long generation = fieldsGeneration().load();
+        const unsigned long cached = _requiredFields.load();
+        if ((cached >> fieldsBits) == (generation & (~0UL >> fieldsBits)))
+            return static_cast<unsigned int>(cached & fieldsMask);
+
+        // a change while collecting bumps the generation again, so
+        // the next call collects anew
+        unsigned int fields = 0;
+        for (Category* category = this; category; category = category->getParent()) {
+            Dispatch* dispatch = category->_acquireDispatch();
+            for (AppenderList::const_iterator i = dispatch->appenders.begin();
+                 i != dispatch->appenders.end(); i++) {
+                fields |= (*i)->getRequiredFields();
+            }
+            category->_releaseDispatch(dispatch);
+
+            if (!category->getAdditivity())
+                break;
+        }
+        fields &= fieldsMask;
+
+        _requiredFields.store((generation << fieldsBits) | fields);
+        return fields;
+    }
+
+    void Category::requiredFieldsChanged() throw() {
+        fieldsGeneration().fetchAdd(1);
+    }
+
     void Category::setAdditivity(bool additivity) {
         _isAdditive = additivity;
+        requiredFieldsChanged();
     }
 
     bool Category::getAdditivity() const throw() {
@@ -255,15 +545,102 @@ namespace log4cpp {
     void Category::_logUnconditionally(Priority::Value priority, 
                                        const char* format, 
                                        va_list arguments) throw() {
-        _logUnconditionally2(priority, StringUtil::vform(format, arguments));
+        FormatBuffer buffer;
+        buffer.appendVprintf(format, arguments);
+        // through the std::string overload, which subclasses may override
+        _logUnconditionally2(priority, buffer.share().str());
     }
     
     void Category::_logUnconditionally2(Priority::Value priority, 
                                         const std::string& message) throw() {
-        LoggingEvent event(getName(), message, NDC::get(), priority);
+        _logUnconditionally2(priority, SharedString(message));
+    }
+
+    void Category::_logUnconditionally2(Priority::Value priority, 
+                                        const SharedString& message) throw() {
+        const unsigned int fields = getRequiredFields();
+        LoggingEvent event(_name, message,
+                           (fields & LoggingEvent::FIELD_NDC) ? NDC::getStack() : noContext(),
+                           priority, fields);
         callAppenders(event);
     }
     
+    namespace {
+        /**
+         * Room for one LoggingEvent, which is constructed in place.
+         **/
+        union EventSlot {
+            char bytes[sizeof(LoggingEvent)];
+            double alignDouble;
+            int64_t alignInteger;
+            void* alignPointer;
+        };
+
+        /**
+         * The most Batches a thread keeps for reuse.
+         **/
+        const size_t maxPooledBatches = 2;
+
+        /**
+         * Batches keep the capacity for this many events, so that a huge
+         * batch does not hold on to its memory.
+         **/
+        const size_t maxRetainedEvents = 16 * 1024;
+    }
+
+    class Category::Batch {
+        public:
+        std::vector<SharedString> messages;
+        std::vector<EventSlot> slots;
+        std::vector<const LoggingEvent*> events;
+
+        void clear() {
+            if (messages.capacity() > maxRetainedEvents) {
+                std::vector<SharedString>().swap(messages);
+                std::vector<EventSlot>().swap(slots);
+                std::vector<const LoggingEvent*>().swap(events);
+            } else {
+                messages.clear();
+            }
+        }
+    };
+
+    Category::Batch* Category::_acquireBatch() {
+        return pool::FreeList<Batch, maxPooledBatches>::acquire();
+    }
+
+    std::vector<SharedString>& Category::_getBatchMessages(Batch* batch) {
+        return batch->messages;
+    }
+
+    void Category::_logBatch(Priority::Value priority, Batch* batch) throw() {
+        const bool ndc = (getRequiredFields() & LoggingEvent::FIELD_NDC) != 0;
+        _dispatchBatch(priority, batch, ndc ? NDC::getStack() : noContext());
+    }
+
+    void Category::_dispatchBatch(Priority::Value priority, Batch* batch,
+                                  const NDC::ContextStack& ndc) throw() {
+        const size_t count = batch->messages.size();
+        if (count) {
+            const unsigned int fields = getRequiredFields();
+            batch->slots.resize(count);
+            batch->events.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                batch->events[i] = new (batch->slots[i].bytes)
+                    LoggingEvent(_name, batch->messages[i], ndc, priority, fields);
+            }
+
+            callAppenders(&batch->events[0], count);
+
+            for (size_t i = 0; i < count; i++) {
+                batch->events[i]->~LoggingEvent();
+            }
+        }
+
+        batch->clear();
+        pool::FreeList<Batch, maxPooledBatches>::release(batch);
+    }
+
     bool Category::isPriorityEnabled(Priority::Value priority) const throw() {
         return(getChainedPriority() >= priority);
     }
@@ -292,6 +669,18 @@ namespace log4cpp {
         }
     }
 
+    void Category::logPrintf(Priority::Value priority,
+                             const PrintfFormat* format, ...) throw() {
+        if (isPriorityEnabled(priority)) {
+            FormatBuffer buffer;
+            va_list va;
+            va_start(va, format);
+            format->format(buffer, va);
+            va_end(va);
+            _logUnconditionally2(priority, buffer.share().str());
+        }
+    }
+
     void Category::debug(const char* stringFormat, ...) throw() { 
         if (isPriorityEnabled(Priority::DEBUG)) {
             va_list va;
@@ -15,62 +15,222 @@
 
 #include <log4cpp/CategoryStream.hh>
 #include <log4cpp/Category.hh>
+#include <log4cpp/Format.hh>
+#include "Pool.hh"
+#include <locale>
+#include <vector>
 
 namespace log4cpp {
 
+    namespace {
+        /**
+         * The most Streams a thread keeps for reuse, enough for
+         * CategoryStreams nested in the operator<< of streamed objects.
+         **/
+        const size_t maxPooledStreams = 4;
+
+        /**
+         * Streams keep the capacity of their buffer up to this size, so
+         * that a huge message does not hold on to its memory.
+         **/
+        const size_t maxRetainedCapacity = 64 * 1024;
+    }
+
+    /**
+     * The buffer a CategoryStream builds its message in, with an
+     * ostream writing to it. Each thread pools them for reuse.
+     **/
+    class CategoryStream::Stream : public std::streambuf {
+        public:
+        Stream() :
+            out(this) {
+            out.imbue(std::locale::classic());
+        }
+
+        void append(const char* characters, size_t length) {
+            message.append(characters, length);
+        }
+
+        /**
+         * Empties the buffer and resets the formatting of out.
+         **/
+        void reset() {
+            if (message.capacity() > maxRetainedCapacity)
+                std::string().swap(message);
+            else
+                message.clear();
+            out.clear();
+            out.flags(std::ios::dec | std::ios::skipws);
+            out.width(0);
+            out.precision(6);
+            out.fill(' ');
+        }
+
+        std::string message;
+        std::ostream out;
+
+        protected:
+        virtual int_type overflow(int_type c) {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                message += traits_type::to_char_type(c);
+            return traits_type::not_eof(c);
+        }
+
+        virtual std::streamsize xsputn(const char* characters, std::streamsize length) {
+            message.append(characters, static_cast<size_t>(length));
+            return length;
+        }
+    };
+
+    namespace {
+        bool isPlainInteger(const std::ostream& out) {
+            const std::ios::fmtflags flags = out.flags();
+            return ((flags & std::ios::basefield) == std::ios::dec ||
+                    (flags & std::ios::basefield) == 0) &&
+                !(flags & std::ios::showpos);
+        }
+
+        bool isPlainFloat(const std::ostream& out) {
+            const std::ios::fmtflags flags = out.flags();
+            return !(flags & (std::ios::floatfield | std::ios::showpos |
+                              std::ios::showpoint | std::ios::uppercase)) &&
+                out.precision() == 6;
+        }
+    }
+
     CategoryStream::CategoryStream(Category& category, Priority::Value priority) :
         _category(category),
         _priority(priority),
-        _buffer(NULL) {
+        _stream(NULL),
+        _out(NULL)
+#if LOG4CPP_HAS_WCHAR_T != 0
+        , _wbuffer(NULL)
+#endif
+    {
     }
 
     CategoryStream::~CategoryStream() { 
         flush();
+#if LOG4CPP_HAS_WCHAR_T != 0
+        delete _wbuffer;
+#endif
+    }
+
+    std::ostream& CategoryStream::_acquireStream() {
+        _stream = pool::FreeList<Stream, maxPooledStreams>::acquire();
+        _out = &_stream->out;
+        return *_out;
     }
 
     void CategoryStream::flush() {
-        if (_buffer) {
-            getCategory().log(getPriority(), _buffer->str());
-            delete _buffer;
-            _buffer = NULL;
+        if (_stream) {
+            getCategory().log(getPriority(), _stream->message);
+            _stream->reset();
+
+            // back to the free list of the flushing thread
+            pool::FreeList<Stream, maxPooledStreams>::release(_stream);
+            _stream = NULL;
+            _out = NULL;
         }
     }
     
     CategoryStream& CategoryStream::operator<<(const char* t)
     {
        if (getPriority() != Priority::NOTSET) {
-          if (!_buffer) {
-             if (!(_buffer = new std::ostringstream)) {
-                // XXX help help help
-             }
-          }
-          (*_buffer) << t;
+          _getStream() << t;
+       }
+       return *this;
+    }
+
+    CategoryStream& CategoryStream::operator<<(const std::string& t)
+    {
+       if (getPriority() != Priority::NOTSET) {
+          _getStream() << t;
        }
        return *this;
     }
 
+    void CategoryStream::_appendNumber(const char* number, size_t length) {
+        std::ostream& out = _getStream();
+        const std::streamsize width = out.width();
+        if (width > static_cast<std::streamsize>(length)) {
+            const std::string fill(static_cast<size_t>(width) - length, out.fill());
+            if (out.flags() & std::ios::left) {
+                _stream->append(number, length);
+                _stream->append(fill.data(), fill.size());
+            } else {
+                _stream->append(fill.data(), fill.size());
+                _stream->append(number, length);
+            }
+        } else {
+            _stream->append(number, length);
+        }
+        out.width(0);
+    }
+
+#define LOG4CPP_APPEND_NUMBER(condition, convert) \
+        if (getPriority() != Priority::NOTSET) { \
+            if (condition(_getStream())) { \
+                char number[NumberFormat::maxLength]; \
+                _appendNumber(number, NumberFormat::convert(number, t)); \
+            } else { \
+                _getStream() << t; \
+            } \
+        } \
+        return *this;
+
+    CategoryStream& CategoryStream::operator<<(short t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatInteger)
+    }
+
+    CategoryStream& CategoryStream::operator<<(unsigned short t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatUnsigned)
+    }
+
+    CategoryStream& CategoryStream::operator<<(int t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatInteger)
+    }
+
+    CategoryStream& CategoryStream::operator<<(unsigned int t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatUnsigned)
+    }
+
+    CategoryStream& CategoryStream::operator<<(long t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatInteger)
+    }
+
+    CategoryStream& CategoryStream::operator<<(unsigned long t) {
+        LOG4CPP_APPEND_NUMBER(isPlainInteger, formatUnsigned)
+    }
+
+    CategoryStream& CategoryStream::operator<<(float t) {
+        LOG4CPP_APPEND_NUMBER(isPlainFloat, formatFloat)
+    }
+
+    CategoryStream& CategoryStream::operator<<(double t) {
+        LOG4CPP_APPEND_NUMBER(isPlainFloat, formatDouble)
+    }
+
+#undef LOG4CPP_APPEND_NUMBER
+
     std::streamsize CategoryStream::width(std::streamsize wide ) {
         if (getPriority() != Priority::NOTSET) {
-            if (!_buffer) {
-                if (!(_buffer = new std::ostringstream)) {
-                    // XXX help help help
-                }
-            }
+            return _getStream().width(wide);
         }
-        return _buffer->width(wide); 
+        return 0;
     }
     CategoryStream& CategoryStream::operator<< (cspf pf) {
 		return (*pf)(*this);
     }
     CategoryStream& eol (CategoryStream& os) {
-        if  (os._buffer) {
+        if  (os._stream) {
 		os.flush();
         }
         return os;
     }
     CategoryStream& left (CategoryStream& os) {
-        if  (os._buffer) {
-            os._buffer->setf(std::ios::left);
+        if  (os.getPriority() != Priority::NOTSET) {
+            os._getStream().setf(std::ios::left);
         }
         return os;
     }
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include <log4cpp/CompositeEvaluator.hh>
+#include <log4cpp/LevelEvaluator.hh>
+#include <log4cpp/CountEvaluator.hh>
+#include <log4cpp/IntervalEvaluator.hh>
+#include <log4cpp/FactoryParams.hh>
+#include <stdexcept>
+
+namespace log4cpp
+{
+   CompositeEvaluator::~CompositeEvaluator()
+   {
+      for (evaluators_t::iterator i = evaluators_.begin(); i != evaluators_.end(); ++i)
+         delete *i;
+   }
+
+   void CompositeEvaluator::add(std::auto_ptr<TriggeringEventEvaluator> evaluator)
+   {
+      evaluators_.push_back(evaluator.get());
+      evaluator.release();
+   }
+
+   void CompositeEvaluator::attach(Trigger* trigger)
+   {
+      for (evaluators_t::iterator i = evaluators_.begin(); i != evaluators_.end(); ++i)
+         (*i)->attach(trigger);
+   }
+
+   void CompositeEvaluator::reset() const
+   {
+      for (evaluators_t::const_iterator i = evaluators_.begin(); i != evaluators_.end(); ++i)
+         (*i)->reset();
+   }
+
+   bool AndEvaluator::eval(const LoggingEvent& event) const
+   {
+      bool result = !evaluators_.empty();
+      for (evaluators_t::const_iterator i = evaluators_.begin(); i != evaluators_.end(); ++i)
+         result = (*i)->eval(event) && result;
+      return result;
+   }
+
+   bool OrEvaluator::eval(const LoggingEvent& event) const
+   {
+      bool result = false;
+      for (evaluators_t::const_iterator i = evaluators_.begin(); i != evaluators_.end(); ++i)
+         result = (*i)->eval(event) || result;
+      return result;
+   }
+
+   // the combined evaluators are given by their parameters: level, count
+   // and interval
+   static void add_evaluators(CompositeEvaluator& composite, const FactoryParams& params, const char* name)
+   {
+      std::string level;
+      unsigned long count = 0, interval = 0;
+      params.get_for(name).optional("level", level)("count", count)("interval", interval);
+
+      if (!level.empty())
+         composite.add(std::auto_ptr<TriggeringEventEvaluator>(new LevelEvaluator(Priority::getPriorityValue(level))));
+      if (count)
+         composite.add(std::auto_ptr<TriggeringEventEvaluator>(new CountEvaluator(count)));
+      if (interval)
+         composite.add(std::auto_ptr<TriggeringEventEvaluator>(new IntervalEvaluator(interval)));
+   }
+
+   std::auto_ptr<TriggeringEventEvaluator> create_and_evaluator(const FactoryParams& params)
+   {
+      std::auto_ptr<CompositeEvaluator> result(new AndEvaluator);
+      add_evaluators(*result, params, "and evaluator");
+      return std::auto_ptr<TriggeringEventEvaluator>(result.release());
+   }
+
+   std::auto_ptr<TriggeringEventEvaluator> create_or_evaluator(const FactoryParams& params)
+   {
+      std::auto_ptr<CompositeEvaluator> result(new OrEvaluator);
+      add_evaluators(*result, params, "or evaluator");
+      return std::auto_ptr<TriggeringEventEvaluator>(result.release());
+   }
+}
@@ -0,0 +1,79 @@
+/*
+ * Compression.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "Compression.hh"
+#ifdef LOG4CPP_HAVE_LIBZ
+#include <cstring>
+#include <zlib.h>
+#endif
+
+namespace log4cpp {
+    namespace compression {
+
+#ifdef LOG4CPP_HAVE_LIBZ
+        bool isAvailable() {
+            return true;
+        }
+
+        bool compress(const char* data, size_t length, std::string& out,
+                      Format format) {
+            z_stream stream;
+            std::memset(&stream, 0, sizeof(stream));
+            // level 1: shipping logs is latency bound, not bandwidth bound;
+            // 16 added to the window bits selects the gzip wrapper
+            if (::deflateInit2(&stream, 1, Z_DEFLATED, (format == GZIP) ? 15 + 16 : 15,
+                               8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return false;
+
+            const size_t offset = out.size();
+            out.resize(offset + ::deflateBound(&stream, length));
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream.avail_in = length;
+            stream.next_out = reinterpret_cast<Bytef*>(&out[offset]);
+            stream.avail_out = out.size() - offset;
+            int result = ::deflate(&stream, Z_FINISH);
+            out.resize(result == Z_STREAM_END ? offset + stream.total_out : offset);
+            ::deflateEnd(&stream);
+            return result == Z_STREAM_END;
+        }
+
+        bool uncompress(const char* data, size_t length, size_t rawLength,
+                        std::string& out) {
+            z_stream stream;
+            std::memset(&stream, 0, sizeof(stream));
+            // 32 added to the window bits detects zlib and gzip headers
+            if (::inflateInit2(&stream, 15 + 32) != Z_OK)
+                return false;
+
+            const size_t offset = out.size();
+            out.resize(offset + rawLength + 1);
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream.avail_in = length;
+            stream.next_out = reinterpret_cast<Bytef*>(&out[offset]);
+            stream.avail_out = rawLength + 1;
+            int result = ::inflate(&stream, Z_FINISH);
+            bool ok = (result == Z_STREAM_END && stream.total_out == rawLength);
+            out.resize(ok ? offset + rawLength : offset);
+            ::inflateEnd(&stream);
+            return ok;
+        }
+#else
+        bool isAvailable() {
+            return false;
+        }
+
+        bool compress(const char*, size_t, std::string&, Format) {
+            return false;
+        }
+
+        bool uncompress(const char*, size_t, size_t, std::string&) {
+            return false;
+        }
+#endif
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Compression.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_COMPRESSION_HH
+#define _LOG4CPP_COMPRESSION_HH
+
+#include "PortabilityImpl.hh"
+#include <string>
+
+namespace log4cpp {
+    namespace compression {
+
+        /**
+           Returns whether the library was built with zlib.
+        **/
+        bool isAvailable();
+
+        typedef enum {
+            ZLIB,
+            GZIP
+        } Format;
+
+        /**
+           Appends the compressed form of data to out.
+           @returns false if compression is unavailable or failed.
+        **/
+        bool compress(const char* data, size_t length, std::string& out,
+                      Format format = ZLIB);
+
+        /**
+           Appends the uncompressed form of zlib or gzip data to out.
+           @param rawLength The expected uncompressed length.
+           @returns false if the data is corrupt or compression is
+           unavailable.
+        **/
+        bool uncompress(const char* data, size_t length, size_t rawLength,
+                        std::string& out);
+    }
+}
+
+#endif // _LOG4CPP_COMPRESSION_HH
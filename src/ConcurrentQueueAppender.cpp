@@ -0,0 +1,197 @@
+/*
+ * ConcurrentQueueAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/ConcurrentQueueAppender.hh>
+#include <log4cpp/FactoryParams.hh>
+#include <memory>
+#include <cstddef>
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace log4cpp {
+
+    const size_t ConcurrentQueueAppender::DEFAULT_CAPACITY = 1024;
+
+    namespace {
+        size_t roundUpToPowerOfTwo(size_t value) {
+            size_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+    }
+
+    ConcurrentQueueAppender::ConcurrentQueueAppender(const std::string& name,
+                                                     size_t capacity,
+                                                     bool eventFd) :
+        LayoutAppender(name),
+        _mask(roundUpToPowerOfTwo(capacity) - 1),
+        _cells(new Cell[_mask + 1]),
+        _enqueuePosition(0),
+        _dequeuePosition(0),
+        _overflows(0),
+        _signalled(false),
+        _eventFd(-1) {
+        for (size_t i = 0; i <= _mask; i++) {
+            _cells[i].sequence.store(i);
+        }
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+        if (eventFd) {
+            _eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        }
+#endif
+    }
+
+    ConcurrentQueueAppender::~ConcurrentQueueAppender() {
+        close();
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+        if (_eventFd >= 0) {
+            ::close(_eventFd);
+        }
+#endif
+        delete[] _cells;
+    }
+
+    void ConcurrentQueueAppender::close() {
+        // empty
+    }
+
+    bool ConcurrentQueueAppender::reopen() {
+        return true;
+    }
+
+    void ConcurrentQueueAppender::doAppend(const LoggingEvent& event) {
+        // stateful filters need the appender lock, the queue does not
+        if (getFilter()) {
+            LayoutAppender::doAppend(event);
+        } else if (Priority::NOTSET == getThreshold() || event.priority <= getThreshold()) {
+            _append(event);
+        }
+    }
+
+    unsigned int ConcurrentQueueAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
+    void ConcurrentQueueAppender::_append(const LoggingEvent& event) {
+        std::string message(_getLayout().format(event));
+
+        // Dmitry Vyukov's bounded MPMC queue: a cell whose sequence equals
+        // the enqueue position is free, one whose sequence is one ahead of
+        // the dequeue position is full
+        Cell* cell;
+        size_t position = _enqueuePosition.loadRelaxed();
+        for (;;) {
+            cell = &_cells[position & _mask];
+            ptrdiff_t difference = static_cast<ptrdiff_t>(cell->sequence.load() - position);
+            if (difference == 0) {
+                if (_enqueuePosition.compareExchange(position, position + 1))
+                    break;
+            } else if (difference < 0) {
+                _overflows.fetchAdd(1);
+                return;
+            } else {
+                position = _enqueuePosition.loadRelaxed();
+            }
+        }
+        cell->message.swap(message);
+        cell->sequence.store(position + 1);
+
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+        if (_eventFd >= 0 && !_signalled.exchange(true)) {
+            const uint64_t one = 1;
+            ssize_t written = ::write(_eventFd, &one, sizeof(one));
+            (void)written;
+        }
+#endif
+    }
+
+    bool ConcurrentQueueAppender::_pop(std::string& message) {
+        Cell* cell;
+        size_t position = _dequeuePosition.loadRelaxed();
+        for (;;) {
+            cell = &_cells[position & _mask];
+            ptrdiff_t difference = static_cast<ptrdiff_t>(cell->sequence.load() - (position + 1));
+            if (difference == 0) {
+                if (_dequeuePosition.compareExchange(position, position + 1))
+                    break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = _dequeuePosition.loadRelaxed();
+            }
+        }
+        message.swap(cell->message);
+        cell->message.clear();
+        cell->sequence.store(position + _mask + 1);
+        return true;
+    }
+
+    bool ConcurrentQueueAppender::popMessage(std::string& message) {
+        if (_pop(message))
+            return true;
+
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+        // empty: rearm the eventfd, then look again for messages whose
+        // producers saw it still signalled
+        if (_eventFd >= 0 && _signalled.load()) {
+            uint64_t count;
+            ssize_t n = ::read(_eventFd, &count, sizeof(count));
+            (void)n;
+            _signalled.exchange(false);
+            return _pop(message);
+        }
+#endif
+        return false;
+    }
+
+    size_t ConcurrentQueueAppender::drain(std::vector<std::string>& messages, size_t max) {
+        size_t count = 0;
+        while (count < max) {
+            messages.resize(messages.size() + 1);
+            if (!popMessage(messages.back())) {
+                messages.pop_back();
+                break;
+            }
+            count++;
+        }
+        return count;
+    }
+
+    size_t ConcurrentQueueAppender::queueSize() const {
+        size_t enqueued = _enqueuePosition.load();
+        size_t dequeued = _dequeuePosition.load();
+        return (enqueued > dequeued) ? enqueued - dequeued : 0;
+    }
+
+    size_t ConcurrentQueueAppender::getCapacity() const {
+        return _mask + 1;
+    }
+
+    unsigned long ConcurrentQueueAppender::getOverflows() const {
+        return _overflows.load();
+    }
+
+    int ConcurrentQueueAppender::getEventFd() const {
+        return _eventFd;
+    }
+
+    std::auto_ptr<Appender> create_concurrent_queue_appender(const FactoryParams& params)
+    {
+       std::string name;
+       size_t capacity = ConcurrentQueueAppender::DEFAULT_CAPACITY;
+       params.get_for("concurrent queue appender").required("name", name)
+                                                  .optional("capacity", capacity);
+       return std::auto_ptr<Appender>(new ConcurrentQueueAppender(name, capacity));
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * ConditionClock.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_CONDITIONCLOCK_HH
+#define _LOG4CPP_CONDITIONCLOCK_HH
+
+#include <sys/time.h>
+#include <time.h>
+
+namespace log4cpp {
+    namespace condition_clock {
+
+        /*
+         * Milliseconds of the clock of pthread_cond_timedwait(), the wall
+         * clock. Not TimeStamp, which follows TimeStamp::setClock() and
+         * so may be coarse or extrapolated from the time stamp counter.
+         */
+        inline long long now() {
+            struct timeval time;
+            ::gettimeofday(&time, NULL);
+            return time.tv_sec * 1000LL + time.tv_usec / 1000;
+        }
+
+        /*
+         * Converts a deadline of now() for pthread_cond_timedwait().
+         */
+        inline struct timespec toTimespec(long long deadline) {
+            struct timespec timeout;
+            timeout.tv_sec = static_cast<time_t>(deadline / 1000);
+            timeout.tv_nsec = static_cast<long>(deadline % 1000) * 1000000L;
+            return timeout;
+        }
+    }
+}
+
+#endif // _LOG4CPP_CONDITIONCLOCK_HH
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include <log4cpp/CountEvaluator.hh>
+#include <log4cpp/FactoryParams.hh>
+#include <memory>
+
+namespace log4cpp
+{
+   std::auto_ptr<TriggeringEventEvaluator> create_count_evaluator(const FactoryParams& params)
+   {
+      unsigned long count;
+      params.get_for("count evaluator").required("count", count);
+
+      return std::auto_ptr<TriggeringEventEvaluator>(new CountEvaluator(count));
+   }
+}
@@ -149,6 +149,18 @@ namespace log4cpp {
 	}
 
 	void DailyRollingFileAppender::_append(const log4cpp::LoggingEvent &event)
+	{
+		_rollOverIfNewDay();
+		log4cpp::FileAppender::_append(event);
+	}
+
+	void DailyRollingFileAppender::_appendBatch(const log4cpp::LoggingEvent* const* events, size_t count)
+	{
+		_rollOverIfNewDay();
+		log4cpp::FileAppender::_appendBatch(events, count);
+	}
+
+	void DailyRollingFileAppender::_rollOverIfNewDay()
 	{
 		struct tm now;
 		time_t t = time(NULL);
@@ -166,7 +178,6 @@ namespace log4cpp {
 				_logsTime = now;
 			}
 		}
-		log4cpp::FileAppender::_append(event);
 	}
 
    std::auto_ptr<Appender> create_daily_roll_file_appender(const FactoryParams& params)
@@ -0,0 +1,295 @@
+/*
+ * EventCodec.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/EventCodec.hh>
+#include <log4cpp/Category.hh>
+#include "Compression.hh"
+
+namespace log4cpp {
+
+    namespace {
+        const char BLOCK_MAGIC[4] = { 'L', '4', 'E', 'B' };
+        // version 2 adds the MDC, version 1 blocks are still decoded
+        const char BLOCK_VERSION = 2;
+        const char MIN_BLOCK_VERSION = 1;
+
+        // an upper bound protecting the decoder against garbage lengths
+        const size_t MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+        void put32(std::string& buffer, unsigned long value) {
+            char bytes[4];
+            for (int i = 0; i < 4; i++) {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+            }
+            buffer.append(bytes, 4);
+        }
+
+        void put64(std::string& buffer, long long value) {
+            unsigned long long v = static_cast<unsigned long long>(value);
+            char bytes[8];
+            for (int i = 0; i < 8; i++) {
+                bytes[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+            }
+            buffer.append(bytes, 8);
+        }
+
+        void putString(std::string& buffer, const std::string& value) {
+            put32(buffer, value.size());
+            buffer.append(value);
+        }
+
+        unsigned long get32(const char* p) {
+            const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+            return static_cast<unsigned long>(u[0]) | (static_cast<unsigned long>(u[1]) << 8) |
+                   (static_cast<unsigned long>(u[2]) << 16) | (static_cast<unsigned long>(u[3]) << 24);
+        }
+
+        long long get64(const char* p) {
+            unsigned long long value = 0;
+            for (int i = 7; i >= 0; i--) {
+                value = (value << 8) | static_cast<unsigned char>(p[i]);
+            }
+            return static_cast<long long>(value);
+        }
+
+        /* reads consecutive fields from one record, failing on overrun */
+        class RecordReader {
+            public:
+            RecordReader(const char* data, size_t length) :
+                _data(data), _end(data + length), _ok(true) {
+            }
+
+            unsigned long get32() {
+                if (!_check(4)) return 0;
+                unsigned long value = log4cpp::get32(_data);
+                _data += 4;
+                return value;
+            }
+
+            long long get64() {
+                if (!_check(8)) return 0;
+                long long value = log4cpp::get64(_data);
+                _data += 8;
+                return value;
+            }
+
+            std::string getString() {
+                size_t length = get32();
+                if (!_check(length)) return std::string();
+                std::string value(_data, length);
+                _data += length;
+                return value;
+            }
+
+            bool ok() const {
+                return _ok;
+            }
+
+            private:
+            bool _check(size_t length) {
+                _ok = _ok && static_cast<size_t>(_end - _data) >= length;
+                return _ok;
+            }
+
+            const char* _data;
+            const char* _end;
+            bool _ok;
+        };
+    }
+
+    const size_t EventCodec::BLOCK_HEADER_SIZE = 16;
+
+    bool EventCodec::isSupported(Compression compression) {
+        switch (compression) {
+        case NONE:
+            return true;
+        case ZLIB:
+            return compression::isAvailable();
+        default:
+            return false;
+        }
+    }
+
+    void EventCodec::encode(const LoggingEvent& event, std::string& buffer) {
+        const size_t start = buffer.size();
+        put32(buffer, 0); // record length, patched below
+        put32(buffer, static_cast<unsigned long>(event.priority));
+        put64(buffer, event.timeStamp.getSeconds());
+        put32(buffer, event.timeStamp.getNanoSeconds());
+        putString(buffer, event.categoryName);
+        putString(buffer, event.threadName);
+        putString(buffer, event.ndc);
+        putString(buffer, event.message);
+        put32(buffer, event.mdc.size());
+        for (MDC::Snapshot::const_iterator i = event.mdc.begin(); i != event.mdc.end(); ++i) {
+            putString(buffer, *i->key);
+            putString(buffer, i->value);
+        }
+
+        std::string length;
+        put32(length, buffer.size() - start - 4);
+        buffer.replace(start, 4, length);
+    }
+
+    void EventCodec::encodeBlock(const std::string& records, Compression compression,
+                                 std::string& output) {
+        const size_t start = output.size();
+        output.append(BLOCK_MAGIC, 4);
+        output += BLOCK_VERSION;
+        output += static_cast<char>(NONE);
+        output.append(2, '\0');
+        put32(output, records.size());
+        put32(output, 0); // stored length, patched below
+
+        if (compression == ZLIB && compression::compress(records.data(), records.size(), output) &&
+            output.size() - start - BLOCK_HEADER_SIZE < records.size()) {
+            output[start + 5] = static_cast<char>(ZLIB);
+        } else {
+            output.resize(start + BLOCK_HEADER_SIZE);
+            output.append(records);
+        }
+
+        std::string length;
+        put32(length, output.size() - start - BLOCK_HEADER_SIZE);
+        output.replace(start + 12, 4, length);
+    }
+
+    EventStreamDecoder::EventStreamDecoder() :
+        _inputPosition(0),
+        _records(&_input),
+        _recordPosition(0),
+        _recordEnd(0),
+        _blockVersion(BLOCK_VERSION),
+        _corrupt(false) {
+    }
+
+    void EventStreamDecoder::feed(const char* data, size_t length) {
+        _input.append(data, length);
+    }
+
+    bool EventStreamDecoder::_nextBlock() {
+        // reclaim consumed input once the current block is done with
+        if (_inputPosition == _input.size()) {
+            _input.clear();
+            _inputPosition = 0;
+        } else if (_inputPosition > 65536 && _inputPosition * 2 > _input.size()) {
+            _input.erase(0, _inputPosition);
+            _inputPosition = 0;
+        }
+
+        const size_t available = _input.size() - _inputPosition;
+        if (available < EventCodec::BLOCK_HEADER_SIZE)
+            return false;
+
+        const char* header = _input.data() + _inputPosition;
+        const size_t rawLength = get32(header + 8);
+        const size_t length = get32(header + 12);
+        if (_input.compare(_inputPosition, 4, BLOCK_MAGIC, 4) != 0 ||
+            header[4] < MIN_BLOCK_VERSION || header[4] > BLOCK_VERSION || rawLength > MAX_BLOCK_SIZE || length > MAX_BLOCK_SIZE) {
+            _corrupt = true;
+            return false;
+        }
+
+        if (available < EventCodec::BLOCK_HEADER_SIZE + length)
+            return false;
+
+        _blockVersion = header[4];
+        const size_t contents = _inputPosition + EventCodec::BLOCK_HEADER_SIZE;
+        switch (header[5]) {
+        case EventCodec::NONE:
+            // decoded in place
+            _corrupt = (length != rawLength);
+            _records = &_input;
+            _recordPosition = contents;
+            _recordEnd = contents + length;
+            break;
+        case EventCodec::ZLIB:
+            _uncompressed.clear();
+            _corrupt = !compression::uncompress(_input.data() + contents, length, rawLength, _uncompressed);
+            _records = &_uncompressed;
+            _recordPosition = 0;
+            _recordEnd = _uncompressed.size();
+            break;
+        default:
+            _corrupt = true;
+        }
+
+        _inputPosition = contents + length;
+        return !_corrupt;
+    }
+
+    bool EventStreamDecoder::next(std::auto_ptr<LoggingEvent>& event) {
+        if (_corrupt)
+            return false;
+
+        while (_recordPosition == _recordEnd) {
+            if (!_nextBlock())
+                return false;
+        }
+
+        const char* records = _records->data();
+        if (_recordEnd - _recordPosition < 4) {
+            _corrupt = true;
+            return false;
+        }
+        const size_t length = get32(records + _recordPosition);
+        _recordPosition += 4;
+        if (_recordEnd - _recordPosition < length) {
+            _corrupt = true;
+            return false;
+        }
+
+        RecordReader reader(records + _recordPosition, length);
+        _recordPosition += length;
+        Priority::Value priority = static_cast<Priority::Value>(reader.get32());
+        long long seconds = reader.get64();
+        unsigned long nanoSeconds = reader.get32();
+        std::string categoryName = reader.getString();
+        std::string threadName = reader.getString();
+        std::string ndc = reader.getString();
+        std::string message = reader.getString();
+        MDC::Snapshot::Entries mdc;
+        if (_blockVersion >= 2) {
+            // bounded by the record, whatever the count claims
+            for (unsigned long count = reader.get32(); count > 0 && reader.ok(); count--) {
+                MDC::Snapshot::Entry entry;
+                entry.key = MDC::key(reader.getString());
+                entry.value = reader.getString();
+                if (reader.ok())
+                    mdc.push_back(entry);
+            }
+        }
+        if (!reader.ok()) {
+            _corrupt = true;
+            return false;
+        }
+
+        event.reset(new LoggingEvent(categoryName, message, ndc, priority, threadName,
+                                     TimeStamp::fromNanoSeconds(seconds * 1000000000LL + nanoSeconds),
+                                     MDC::Snapshot(mdc)));
+        return true;
+    }
+
+    size_t EventStreamDecoder::dispatch() {
+        size_t count = 0;
+        std::auto_ptr<LoggingEvent> event;
+        while (next(event)) {
+            Category& category = Category::getInstance(event->categoryName);
+            if (category.isPriorityEnabled(event->priority)) {
+                category.callAppenders(*event);
+            }
+            count++;
+        }
+        return count;
+    }
+
+    bool EventStreamDecoder::isCorrupt() const {
+        return _corrupt;
+    }
+}
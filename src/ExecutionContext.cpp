@@ -0,0 +1,71 @@
+/*
+ * ExecutionContext.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/ExecutionContext.hh>
+#include <log4cpp/threading/Threading.hh>
+#include <log4cpp/threading/Atomic.hh>
+
+namespace log4cpp {
+
+    namespace {
+        struct ThreadContext {
+            ThreadContext() :
+                current(&own) {
+            }
+
+            ExecutionContext own;
+            ExecutionContext* current;
+        };
+
+        threading::ThreadLocalDataHolder<ThreadContext> _threadContext;
+        threading::Atomic<ExecutionContext::Storage*> _storage(NULL);
+
+        ThreadContext& getThreadContext() {
+            ThreadContext* context = _threadContext.get();
+
+            if (!context) {
+                context = new ThreadContext();
+                _threadContext.reset(context);
+            }
+
+            return *context;
+        }
+    }
+
+    ExecutionContext::Storage::~Storage() {
+    }
+
+    ExecutionContext::ExecutionContext() {
+    }
+
+    ExecutionContext::~ExecutionContext() {
+    }
+
+    ExecutionContext& ExecutionContext::getCurrent() {
+        Storage* storage = _storage.load();
+        if (storage) {
+            ExecutionContext* context = storage->get();
+            if (context)
+                return *context;
+        }
+
+        return *getThreadContext().current;
+    }
+
+    ExecutionContext* ExecutionContext::swap(ExecutionContext* context) {
+        ThreadContext& thread = getThreadContext();
+        ExecutionContext* previous = thread.current;
+        thread.current = context ? context : &thread.own;
+        return (previous == &thread.own) ? NULL : previous;
+    }
+
+    void ExecutionContext::setStorage(Storage* storage) {
+        _storage.store(storage);
+    }
+}
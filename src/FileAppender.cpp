@@ -76,6 +76,10 @@ namespace log4cpp {
         return _mode;
     }
 
+    unsigned int FileAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void FileAppender::_append(const LoggingEvent& event) {
         std::string message(_getLayout().format(event));
         if (!::write(_fd, message.data(), message.length())) {
@@ -83,6 +87,16 @@ namespace log4cpp {
         }
     }
 
+    void FileAppender::_appendBatch(const LoggingEvent* const* events, size_t count) {
+        std::string messages;
+        for (size_t i = 0; i < count; i++) {
+            messages += _getLayout().format(*events[i]);
+        }
+        if (!::write(_fd, messages.data(), messages.length())) {
+            // XXX help! help!
+        }
+    }
+
     bool FileAppender::reopen() {
         if (_fileName != "") {
             int fd = ::open(_fileName.c_str(), _flags, _mode);
@@ -23,11 +23,11 @@ namespace log4cpp {
     }
 
     void FixedContextCategory::setContext(const std::string& context) {
-        _context = context;
+        _context = NDC::ContextStack(context);
     }
 
     std::string FixedContextCategory::getContext() const {
-        return _context;
+        return _context.str();
     }
 
     Priority::Value FixedContextCategory::getPriority() const throw() {
@@ -82,6 +82,15 @@ namespace log4cpp {
         _delegate.callAppenders(event);
     }
 
+    void FixedContextCategory::callAppenders(const LoggingEvent* const* events,
+                                             size_t count) throw() {
+        _delegate.callAppenders(events, count);
+    }
+
+    unsigned int FixedContextCategory::getRequiredFields() throw() {
+        return _delegate.getRequiredFields();
+    }
+
     void FixedContextCategory::setAdditivity(bool additivity) {
         // XXX do nothing for now
     }
@@ -91,10 +100,16 @@ namespace log4cpp {
     }
 
     void FixedContextCategory::_logUnconditionally2(Priority::Value priority,
-            const std::string& message) throw() {
-        LoggingEvent event(getName(), message, _context, priority);
+            const SharedString& message) throw() {
+        LoggingEvent event(_getSharedName(), message, _context, priority,
+                           getRequiredFields());
         callAppenders(event);
     }
+
+    void FixedContextCategory::_logBatch(Priority::Value priority,
+                                         Batch* batch) throw() {
+        _dispatchBatch(priority, batch, _context);
+    }
     
 } 
 
@@ -0,0 +1,252 @@
+/*
+ * Format.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/Format.hh>
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+    #define SNPRINTF _snprintf
+    #define VSNPRINTF _vsnprintf
+#else
+    #define SNPRINTF snprintf
+    #define VSNPRINTF vsnprintf
+#endif
+
+namespace log4cpp {
+
+    namespace {
+        const char digitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        /**
+         * Writes value backwards, ending at end.
+         **/
+        void formatDigits(uint64_t value, char* end) {
+            while (value >= 100) {
+                const unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+                value /= 100;
+                *--end = digitPairs[pair + 1];
+                *--end = digitPairs[pair];
+            }
+            if (value >= 10) {
+                const unsigned int pair = static_cast<unsigned int>(value) * 2;
+                *--end = digitPairs[pair + 1];
+                *--end = digitPairs[pair];
+            } else {
+                *--end = static_cast<char>('0' + value);
+            }
+        }
+
+        unsigned int countDigits(uint64_t value) {
+            unsigned int digits = 1;
+            for (;;) {
+                if (value < 10) return digits;
+                if (value < 100) return digits + 1;
+                if (value < 1000) return digits + 2;
+                if (value < 10000) return digits + 3;
+                value /= 10000;
+                digits += 4;
+            }
+        }
+
+        /**
+         * Integral values below this are appended as integers.
+         **/
+        const double integralLimit = 1e15;
+
+        bool isIntegral(double value) {
+            return value > -integralLimit && value < integralLimit &&
+                static_cast<double>(static_cast<int64_t>(value)) == value;
+        }
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+        /**
+         * Prints value with the fewest of the given digits that read back
+         * as the same T.
+         **/
+        template<typename T> size_t formatShortest(char* buffer, size_t size,
+                                                   T value, int minDigits, int maxDigits) {
+            int length = 0;
+            for (int digits = minDigits; digits <= maxDigits; ++digits) {
+                length = SNPRINTF(buffer, size, "%.*g", digits, static_cast<double>(value));
+                if (static_cast<T>(strtod(buffer, NULL)) == value)
+                    break;
+            }
+
+            // printf and strtod agree on the locale's decimal point
+            const char point = *localeconv()->decimal_point;
+            if (point != '.') {
+                char* found = static_cast<char*>(std::memchr(buffer, point, length));
+                if (found)
+                    *found = '.';
+            }
+            return length;
+        }
+#endif
+    }
+
+    size_t NumberFormat::formatInteger(char* out, int64_t value) {
+        if (value < 0) {
+            *out = '-';
+            // negating the smallest value would overflow
+            return 1 + formatUnsigned(out + 1, static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+        }
+        return formatUnsigned(out, static_cast<uint64_t>(value));
+    }
+
+    size_t NumberFormat::formatUnsigned(char* out, uint64_t value) {
+        const unsigned int digits = countDigits(value);
+        formatDigits(value, out + digits);
+        return digits;
+    }
+
+    size_t NumberFormat::formatUnsigned(char* out, uint64_t value,
+                                        unsigned int minDigits) {
+        unsigned int digits = countDigits(value);
+        if (minDigits > maxLength)
+            minDigits = maxLength;
+        if (digits < minDigits) {
+            std::memset(out, '0', minDigits - digits);
+            digits = minDigits;
+        }
+        formatDigits(value, out + digits);
+        return digits;
+    }
+
+    size_t NumberFormat::formatDouble(char* out, double value) {
+        if (isIntegral(value))
+            return formatInteger(out, static_cast<int64_t>(value));
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::to_chars(out, out + maxLength, value).ptr - out;
+#else
+        return formatShortest(out, maxLength, value, 15, 17);
+#endif
+    }
+
+    size_t NumberFormat::formatFloat(char* out, float value) {
+        if (isIntegral(value))
+            return formatInteger(out, static_cast<int64_t>(value));
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::to_chars(out, out + maxLength, value).ptr - out;
+#else
+        return formatShortest(out, maxLength, value, 6, 9);
+#endif
+    }
+
+    FormatBuffer::FormatBuffer() :
+        _data(_stack),
+        _size(0),
+        _capacity(stackSize) {
+    }
+
+    FormatBuffer::~FormatBuffer() {
+        if (_data != _stack)
+            delete [] _data;
+    }
+
+    void FormatBuffer::_grow(size_t length) {
+        size_t capacity = _capacity * 2;
+        if (capacity - _size < length)
+            capacity = _size + length;
+
+        char* data = new char[capacity];
+        std::memcpy(data, _data, _size);
+        if (_data != _stack)
+            delete [] _data;
+        _data = data;
+        _capacity = capacity;
+    }
+
+    void FormatBuffer::append(const char* value) {
+        if (value)
+            append(value, std::strlen(value));
+        else
+            append("(null)", 6);
+    }
+
+    void FormatBuffer::appendPointer(const void* value) {
+        static const char hexDigits[] = "0123456789abcdef";
+        char digits[2 + 2 * sizeof(void*)];
+        char* end = digits + sizeof(digits);
+        char* begin = end;
+        size_t address = reinterpret_cast<size_t>(value);
+        do {
+            *--begin = hexDigits[address & 0xf];
+            address >>= 4;
+        } while (address);
+        *--begin = 'x';
+        *--begin = '0';
+        append(begin, end - begin);
+    }
+
+    void FormatBuffer::appendVprintf(const char* format, va_list arguments) {
+        while (1) {
+            va_list copy;
+
+#if defined(_MSC_VER) || defined(__BORLANDC__)
+            copy = arguments;
+#else
+            va_copy(copy, arguments);
+#endif
+
+            const size_t available = _capacity - _size;
+            int n = VSNPRINTF(_data + _size, available, format, copy);
+
+            va_end(copy);
+
+            if ((n > -1) && (static_cast<size_t>(n) < available)) {
+                _size += n;
+                return;
+            }
+
+            // Else try again with more space.
+            _grow((n > -1) ?
+                  n + 1 :          // ISO/IEC 9899:1999
+                  available + 1);  // at least twice the old size
+        }
+    }
+
+    const char* FormatBuffer::appendUntilPlaceholder(const char* format) {
+        const char* literal = format;
+        for (;; ++format) {
+            const char c = *format;
+            if (c == '\0') {
+                append(literal, format - literal);
+                return NULL;
+            }
+            if ((c == '{' || c == '}') && format[1] == c) {
+                // a doubled brace stands for itself
+                append(literal, format + 1 - literal);
+                literal = ++format + 1;
+            } else if (c == '{' && format[1] == '}') {
+                append(literal, format - literal);
+                return format + 2;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * FormatMemo.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include "FormatMemo.hh"
+#include <log4cpp/threading/Threading.hh>
+
+namespace log4cpp {
+
+    struct FormatMemo::State {
+        State() :
+            current(NULL) {
+        }
+
+        FormatMemo* current;
+    };
+
+    FormatMemo::State& FormatMemo::_getState() {
+        // never destroyed, so that statics may still log while the program exits
+        static threading::ThreadLocalDataHolder<State>* holder =
+            new threading::ThreadLocalDataHolder<State>();
+        State* state = holder->get();
+        if (!state) {
+            state = new State();
+            holder->reset(state);
+        }
+        return *state;
+    }
+
+    FormatMemo::FormatMemo(const LoggingEvent* const* events, size_t count) :
+        _events(events),
+        _count(count),
+        _next(0),
+        _state(&_getState()),
+        _previous(_state->current) {
+        const FormatMemo* open = _previous;
+        if (open && open->_count == count && (count == 0 || open->_events[0] == events[0])) {
+            // the same dispatch, going on to the ancestors
+            _state = NULL;
+        } else {
+            _state->current = this;
+        }
+    }
+
+    FormatMemo::~FormatMemo() {
+        if (_state)
+            _state->current = _previous;
+    }
+
+    std::string FormatMemo::format(Layout& layout, const LoggingEvent& event) {
+        FormatMemo* memo = _getState().current;
+        size_t index;
+        if (!memo || !memo->_find(event, index))
+            return layout.format(event);
+
+        Texts& texts = memo->_getTexts(layout);
+        if (!texts.formatted[index]) {
+            texts.texts[index] = layout.format(event);
+            texts.formatted[index] = true;
+        }
+        return texts.texts[index];
+    }
+
+    bool FormatMemo::_find(const LoggingEvent& event, size_t& index) {
+        // appenders go through a batch in order, so the event following
+        // the last one found is the likely one
+        if (_next < _count && _events[_next] == &event) {
+            index = _next++;
+            return true;
+        }
+        for (size_t i = 0; i < _count; ++i) {
+            if (_events[i] == &event) {
+                index = i;
+                _next = i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    FormatMemo::Texts& FormatMemo::_getTexts(const Layout& layout) {
+        for (std::vector<Texts>::iterator i = _layouts.begin(); i != _layouts.end(); ++i) {
+            if (i->layout == &layout)
+                return *i;
+        }
+        _layouts.push_back(Texts());
+        Texts& texts = _layouts.back();
+        texts.layout = &layout;
+        texts.texts.resize(_count);
+        texts.formatted.resize(_count, false);
+        return texts;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * FormatMemo.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_FORMATMEMO_HH
+#define _LOG4CPP_FORMATMEMO_HH
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/Layout.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace log4cpp {
+
+    /*
+     * Remembers what shared layouts formatted for the events of one
+     * dispatch, so that the other appenders sharing a layout reuse the
+     * text. Category::callAppenders() opens one on the stack of the
+     * dispatching thread. While the dispatch of the same events to a
+     * child category has one open, e.g. when going up to additive
+     * ancestors, that one stays in use. Dispatches nested in it, e.g. by
+     * appenders which log themselves, open their own.
+     */
+    class FormatMemo {
+        public:
+        FormatMemo(const LoggingEvent* const* events, size_t count);
+        ~FormatMemo();
+
+        /*
+         * Formats the event with a shared layout, reusing the text if the
+         * layout formatted it before in the open memo. Events which are not
+         * part of the dispatch, e.g. ones an appender buffered earlier, are
+         * formatted every time.
+         */
+        static std::string format(Layout& layout, const LoggingEvent& event);
+
+        private:
+        FormatMemo(const FormatMemo& other);
+        FormatMemo& operator=(const FormatMemo& other);
+
+        struct State;
+
+        struct Texts {
+            const Layout* layout;
+            std::vector<std::string> texts;
+            std::vector<bool> formatted;
+        };
+
+        static State& _getState();
+        bool _find(const LoggingEvent& event, size_t& index);
+        Texts& _getTexts(const Layout& layout);
+
+        const LoggingEvent* const* _events;
+        size_t _count;
+        size_t _next;
+        std::vector<Texts> _layouts;
+        State* _state;
+        FormatMemo* _previous;
+    };
+}
+
+#endif // _LOG4CPP_FORMATMEMO_HH
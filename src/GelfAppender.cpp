@@ -0,0 +1,282 @@
+/*
+ * GelfAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <log4cpp/GelfAppender.hh>
+#include <log4cpp/PassThroughLayout.hh>
+#include <log4cpp/FactoryParams.hh>
+#include "Compression.hh"
+#include "SenderThread.hh"
+#include "StringUtil.hh"
+#include <memory>
+
+#ifdef MSG_NOSIGNAL
+#define LOG4CPP_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define LOG4CPP_SEND_FLAGS 0
+#endif
+
+namespace log4cpp {
+
+    namespace {
+        const size_t CHUNK_HEADER_SIZE = 12;
+        const size_t MAX_CHUNKS = 128;
+        const size_t MAX_QUEUED = 1024 * 1024;         // bytes
+    }
+
+    const unsigned short GelfAppender::DEFAULT_PORT = 12201;
+    const size_t GelfAppender::DEFAULT_CHUNK_SIZE = 8192;
+
+    GelfAppender::GelfAppender(const std::string& name, const std::string& host,
+                               unsigned short port, Transport transport,
+                               Compression compressionType, size_t chunkSize) :
+        LayoutAppender(name),
+        _host(host),
+        _port(port),
+        _transport(transport),
+        _compression((transport == UDP && compression::isAvailable()) ? compressionType : NONE),
+        _chunkSize((chunkSize > CHUNK_HEADER_SIZE) ? chunkSize : DEFAULT_CHUNK_SIZE),
+        _socket(-1),
+        _sender(new SenderThread(&_connectSender, &_sendBatch, this, 0, 0, MAX_QUEUED)) {
+        setLayout(new PassThroughLayout());
+
+        char hostName[256];
+        if (::gethostname(hostName, sizeof(hostName)) == 0) {
+            hostName[sizeof(hostName) - 1] = '\0';
+            _source = hostName;
+        } else {
+            _source = "localhost";
+        }
+
+        // chunks of different processes must not share message ids
+        struct timeval now;
+        ::gettimeofday(&now, NULL);
+        _messageId = (static_cast<unsigned long long>(::getpid()) << 40) ^
+                     (static_cast<unsigned long long>(now.tv_sec) << 20) ^ now.tv_usec;
+
+        _sender->start();
+    }
+
+    GelfAppender::~GelfAppender() {
+        close();
+        delete _sender;
+    }
+
+    bool GelfAppender::_connect() {
+        char port[8];
+        std::sprintf(port, "%u", _port);
+        struct addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = (_transport == TCP) ? SOCK_STREAM : SOCK_DGRAM;
+        struct addrinfo* addresses;
+        if (::getaddrinfo(_host.c_str(), port, &hints, &addresses) != 0)
+            return false; // fail silently
+
+        // UDP sockets are connected too, to send without an address
+        for (struct addrinfo* a = addresses; a && _socket < 0; a = a->ai_next) {
+            _socket = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (_socket >= 0 && ::connect(_socket, a->ai_addr, a->ai_addrlen) < 0) {
+                _disconnect();
+            }
+        }
+        ::freeaddrinfo(addresses);
+        if (_socket < 0)
+            return false;
+
+        struct timeval timeout;
+        timeout.tv_sec = 1;
+        timeout.tv_usec = 0;
+        ::setsockopt(_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        ::fcntl(_socket, F_SETFD, FD_CLOEXEC);
+        return true;
+    }
+
+    void GelfAppender::_disconnect() {
+        if (_socket >= 0) {
+            ::close(_socket);
+            _socket = -1;
+        }
+    }
+
+    void GelfAppender::close() {
+        _sender->stop();
+        _disconnect();
+    }
+
+    bool GelfAppender::reopen() {
+        close();
+        _sender->start();
+        return true;
+    }
+
+    unsigned int GelfAppender::getRequiredFields() {
+        return LoggingEvent::ALL_FIELDS;
+    }
+
+    void GelfAppender::setSource(const std::string& source) {
+        _source = source;
+    }
+
+    bool GelfAppender::flush() {
+        return _sender->flush();
+    }
+
+    unsigned long GelfAppender::getDropped() const {
+        return _sender->getDropped();
+    }
+
+    void GelfAppender::_append(const LoggingEvent& event) {
+        int level = (event.priority + 1) / 100;
+        char numbers[64];
+        std::sprintf(numbers, ",\"timestamp\":%lld.%06d,\"level\":%d",
+                     static_cast<long long>(event.timeStamp.getSeconds()), event.timeStamp.getMicroSeconds(),
+                     (level < 0) ? 0 : (level > 7) ? 7 : level);
+
+        _message.assign("{\"version\":\"1.1\",\"host\":");
+        StringUtil::appendJsonString(_message, _source);
+        _message += ",\"short_message\":";
+        StringUtil::appendJsonString(_message, _getLayout().format(event));
+        _message += numbers;
+        _message += ",\"_category\":";
+        StringUtil::appendJsonString(_message, event.categoryName);
+        _message += ",\"_priority\":";
+        StringUtil::appendJsonString(_message, Priority::getPriorityName(event.priority));
+        _message += ",\"_thread\":";
+        StringUtil::appendJsonString(_message, event.threadName);
+        if (!event.ndc.empty()) {
+            _message += ",\"_ndc\":";
+            StringUtil::appendJsonString(_message, event.ndc);
+        }
+        for (MDC::Snapshot::const_iterator i = event.mdc.begin(); i != event.mdc.end(); ++i) {
+            _message += ',';
+            StringUtil::appendJsonString(_message, "_" + *i->key);
+            _message += ':';
+            StringUtil::appendJsonString(_message, i->value);
+        }
+        _message += '}';
+        if (_transport == TCP) {
+            _message += '\0';
+        }
+
+        _sender->append(_message.data(), _message.size(), false);
+    }
+
+    bool GelfAppender::_connectSender(void* appender) {
+        return static_cast<GelfAppender*>(appender)->_connect();
+    }
+
+    size_t GelfAppender::_sendBatch(void* appender, const std::string& messages,
+                                    const std::vector<size_t>& sizes, bool& connected) {
+        GelfAppender* self = static_cast<GelfAppender*>(appender);
+        if (self->_transport == TCP) {
+            // null terminated already, so the batch goes out as one stream
+            if (self->_send(messages.data(), messages.size()))
+                return 0;
+            connected = false;
+            return sizes.size();
+        }
+
+        size_t dropped = 0;
+        size_t offset = 0;
+        for (size_t i = 0; i < sizes.size(); offset += sizes[i], i++) {
+            bool sent;
+            if (self->_compression != NONE) {
+                self->_compressed.clear();
+                sent = compression::compress(messages.data() + offset, sizes[i], self->_compressed,
+                                             (self->_compression == GZIP) ? compression::GZIP : compression::ZLIB) &&
+                       self->_sendChunked(self->_compressed.data(), self->_compressed.size());
+            } else {
+                sent = self->_sendChunked(messages.data() + offset, sizes[i]);
+            }
+            if (!sent) {
+                dropped++;
+            }
+        }
+
+        connected = (self->_socket >= 0);
+        return dropped;
+    }
+
+    bool GelfAppender::_sendChunked(const char* message, size_t length) {
+        if (length <= _chunkSize)
+            return _send(message, length);
+
+        const size_t payload = _chunkSize - CHUNK_HEADER_SIZE;
+        const size_t count = (length + payload - 1) / payload;
+        if (count > MAX_CHUNKS)
+            return false;
+
+        // magic bytes, message id, sequence number and count
+        _chunk.resize(CHUNK_HEADER_SIZE);
+        _chunk[0] = '\x1e';
+        _chunk[1] = '\x0f';
+        const unsigned long long id = _messageId++;
+        for (int i = 0; i < 8; i++) {
+            _chunk[2 + i] = static_cast<char>(id >> (56 - 8 * i));
+        }
+        _chunk[11] = static_cast<char>(count);
+
+        for (size_t i = 0; i < count; i++) {
+            _chunk[10] = static_cast<char>(i);
+            _chunk.resize(CHUNK_HEADER_SIZE);
+            _chunk.append(message + i * payload, (i + 1 < count) ? payload : length - i * payload);
+            if (!_send(_chunk.data(), _chunk.size()))
+                return false;
+        }
+        return true;
+    }
+
+    bool GelfAppender::_send(const char* data, size_t length) {
+        while (_socket >= 0 && length > 0) {
+            ssize_t n = ::send(_socket, data, length, LOG4CPP_SEND_FLAGS);
+            if (n >= 0) {
+                data += n;
+                length -= n;
+            } else if (errno == ECONNREFUSED && _transport == UDP) {
+                // nobody listened to an earlier datagram
+                return false;
+            } else if (errno != EINTR) {
+                // a partial message would corrupt the stream
+                _disconnect();
+            }
+        }
+
+        return length == 0;
+    }
+
+    std::auto_ptr<Appender> create_gelf_appender(const FactoryParams& params)
+    {
+       std::string name, host, transport = "udp", compression = "none";
+       unsigned short port = GelfAppender::DEFAULT_PORT;
+       size_t chunk_size = GelfAppender::DEFAULT_CHUNK_SIZE;
+       params.get_for("gelf appender").required("name", name)("host", host)
+                                      .optional("port", port)("transport", transport)
+                                               ("compression", compression)("chunk_size", chunk_size);
+       return std::auto_ptr<Appender>(new GelfAppender(name, host, port,
+                                                       (transport == "tcp") ? GelfAppender::TCP : GelfAppender::UDP,
+                                                       (compression == "gzip") ? GelfAppender::GZIP :
+                                                       (compression == "zlib") ? GelfAppender::ZLIB : GelfAppender::NONE,
+                                                       chunk_size));
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
@@ -0,0 +1,422 @@
+/*
+ * HttpBulkAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <log4cpp/HttpBulkAppender.hh>
+#include <log4cpp/PassThroughLayout.hh>
+#include <log4cpp/FactoryParams.hh>
+#include "Compression.hh"
+#include "SenderThread.hh"
+#include "StringUtil.hh"
+#include <memory>
+#include <vector>
+#include <cctype>
+
+#ifdef MSG_NOSIGNAL
+#define LOG4CPP_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define LOG4CPP_SEND_FLAGS 0
+#endif
+
+namespace log4cpp {
+
+    namespace {
+        const unsigned int INITIAL_BACKOFF = 100;       // milliseconds
+        const unsigned int MAX_BACKOFF = 30000;
+        const int SOCKET_TIMEOUT = 10;                  // seconds
+
+        bool equalsIgnoreCase(const std::string& a, const char* b) {
+            size_t length = std::strlen(b);
+            if (a.size() != length)
+                return false;
+            for (size_t i = 0; i < length; i++) {
+                if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    const size_t HttpBulkAppender::DEFAULT_BATCH_SIZE = 1024 * 1024;
+    const unsigned int HttpBulkAppender::DEFAULT_BATCH_DELAY = 1000;
+    const size_t HttpBulkAppender::DEFAULT_BUDGET = 16 * 1024 * 1024;
+
+    HttpBulkAppender::HttpBulkAppender(const std::string& name, const std::string& url,
+                                       Format format, size_t batchSize,
+                                       unsigned int batchDelay, size_t budget) :
+        LayoutAppender(name),
+        _format(format),
+        _batchSize(batchSize),
+        _gzip(false),
+        _maxRetries(5),
+        _socket(-1),
+        _sender(new SenderThread(&_connectSender, &_sendBatch, this, batchSize, batchDelay, budget)) {
+        setLayout(new PassThroughLayout());
+
+        // http://host[:port]/path
+        if (url.compare(0, 7, "http://") == 0) {
+            std::string::size_type slash = url.find('/', 7);
+            std::string authority = url.substr(7, (slash == std::string::npos) ? std::string::npos : slash - 7);
+            _path = (slash == std::string::npos) ? "/" : url.substr(slash);
+            std::string::size_type colon = authority.rfind(':');
+            _host = authority.substr(0, colon);
+            _port = (colon == std::string::npos) ? "80" : authority.substr(colon + 1);
+        }
+
+        _sender->start();
+    }
+
+    HttpBulkAppender::~HttpBulkAppender() {
+        close();
+        delete _sender;
+    }
+
+    void HttpBulkAppender::close() {
+        _sender->stop();
+        _disconnect();
+    }
+
+    bool HttpBulkAppender::reopen() {
+        close();
+        _sender->start();
+        return true;
+    }
+
+    unsigned int HttpBulkAppender::getRequiredFields() {
+        return LoggingEvent::ALL_FIELDS;
+    }
+
+    void HttpBulkAppender::setActionLine(const std::string& actionLine) {
+        _actionLine = actionLine;
+    }
+
+    void HttpBulkAppender::setGzip(bool gzip) {
+        _gzip = gzip && compression::isAvailable();
+    }
+
+    void HttpBulkAppender::setMaxRetries(unsigned int maxRetries) {
+        _maxRetries = maxRetries;
+    }
+
+    unsigned long HttpBulkAppender::getDropped() {
+        return _sender->getDropped();
+    }
+
+    void HttpBulkAppender::_append(const LoggingEvent& event) {
+        std::string& document = _document;
+        char timestamp[64];
+        time_t seconds = event.timeStamp.getSeconds();
+        struct tm tm;
+        ::gmtime_r(&seconds, &tm);
+        std::sprintf(timestamp, "\"%04d-%02d-%02dT%02d:%02d:%02d.%06dZ\"",
+                     tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                     event.timeStamp.getMicroSeconds());
+        document = "{\"timestamp\":";
+        document += timestamp;
+        document += ",\"priority\":";
+        StringUtil::appendJsonString(document, Priority::getPriorityName(event.priority));
+        document += ",\"category\":";
+        StringUtil::appendJsonString(document, event.categoryName);
+        document += ",\"thread\":";
+        StringUtil::appendJsonString(document, event.threadName);
+        document += ",\"ndc\":";
+        StringUtil::appendJsonString(document, event.ndc);
+        if (!event.mdc.empty()) {
+            document += ",\"mdc\":{";
+            for (MDC::Snapshot::const_iterator i = event.mdc.begin(); i != event.mdc.end(); ++i) {
+                if (i != event.mdc.begin())
+                    document += ',';
+                StringUtil::appendJsonString(document, *i->key);
+                document += ':';
+                StringUtil::appendJsonString(document, i->value);
+            }
+            document += '}';
+        }
+        document += ",\"message\":";
+        StringUtil::appendJsonString(document, _getLayout().format(event));
+        document += '}';
+
+        _sender->append(document.data(), document.size(), false, event.priority);
+    }
+
+    bool HttpBulkAppender::_connectSender(void*) {
+        // each request connects if the connection was not kept alive
+        return true;
+    }
+
+    size_t HttpBulkAppender::_sendBatch(void* appender, const std::string& documents,
+                                        const std::vector<size_t>& sizes, bool&) {
+        HttpBulkAppender* self = static_cast<HttpBulkAppender*>(appender);
+        const bool array = (self->_format == JSON_ARRAY);
+        size_t dropped = 0;
+        size_t offset = 0;
+        std::string body;
+        for (size_t i = 0; i < sizes.size(); ) {
+            // split into bodies of at most the batch size
+            size_t count = 0;
+            body = array ? "[" : "";
+            for (; i < sizes.size() && (count == 0 || body.size() + sizes[i] <= self->_batchSize);
+                 offset += sizes[i], i++, count++) {
+                if (array) {
+                    if (count > 0) {
+                        body += ',';
+                    }
+                    body.append(documents, offset, sizes[i]);
+                } else {
+                    if (!self->_actionLine.empty()) {
+                        body += self->_actionLine;
+                        body += '\n';
+                    }
+                    body.append(documents, offset, sizes[i]);
+                    body += '\n';
+                }
+            }
+            if (array) {
+                body += ']';
+            }
+
+            if (!self->_deliver(body)) {
+                dropped += count;
+            }
+        }
+        return dropped;
+    }
+
+    bool HttpBulkAppender::_deliver(const std::string& body) {
+        std::string compressed;
+        if (_gzip) {
+            compression::compress(body.data(), body.size(), compressed, compression::GZIP);
+        }
+        const std::string& payload = _gzip ? compressed : body;
+
+        unsigned int backoff = INITIAL_BACKOFF;
+        bool mayWait = true;
+        for (unsigned int attempt = 0; ; attempt++) {
+            int status = _post(payload);
+            if (status >= 200 && status < 300)
+                return true;
+
+            // client errors other than timeouts and throttling will not
+            // go away by retrying
+            bool retryable = (status == 0 || status == 408 || status == 429 || status >= 500);
+            if (!retryable || attempt >= _maxRetries || !mayWait)
+                return false;
+
+            // woken early by close(), which then gets one last attempt
+            mayWait = _sender->pause(backoff);
+            backoff = (backoff * 2 > MAX_BACKOFF) ? MAX_BACKOFF : backoff * 2;
+        }
+    }
+
+    bool HttpBulkAppender::_connect() {
+        if (_host.empty())
+            return false;
+
+        struct addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        struct addrinfo* addresses;
+        if (::getaddrinfo(_host.c_str(), _port.c_str(), &hints, &addresses) != 0)
+            return false;
+
+        for (struct addrinfo* a = addresses; a && _socket < 0; a = a->ai_next) {
+            _socket = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (_socket >= 0 && ::connect(_socket, a->ai_addr, a->ai_addrlen) < 0) {
+                _disconnect();
+            }
+        }
+        ::freeaddrinfo(addresses);
+        if (_socket < 0)
+            return false;
+
+        struct timeval timeout;
+        timeout.tv_sec = SOCKET_TIMEOUT;
+        timeout.tv_usec = 0;
+        ::setsockopt(_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        ::fcntl(_socket, F_SETFD, FD_CLOEXEC);
+        _response.clear();
+        return true;
+    }
+
+    void HttpBulkAppender::_disconnect() {
+        if (_socket >= 0) {
+            ::close(_socket);
+            _socket = -1;
+        }
+    }
+
+    int HttpBulkAppender::_post(const std::string& payload) {
+        // a kept alive connection may have been closed by the server meanwhile
+        for (int tries = 0; tries < 2; tries++) {
+            const bool reused = (_socket >= 0);
+            if (!reused && !_connect())
+                return 0;
+
+            char length[32];
+            std::sprintf(length, "%lu", static_cast<unsigned long>(payload.size()));
+            std::string request = "POST " + _path + " HTTP/1.1\r\n"
+                                  "Host: " + _host + "\r\n"
+                                  "Content-Type: " + ((_format == NDJSON) ? "application/x-ndjson" : "application/json") + "\r\n" +
+                                  (_gzip ? "Content-Encoding: gzip\r\n" : "") +
+                                  "Content-Length: " + length + "\r\n"
+                                  "Connection: keep-alive\r\n"
+                                  "\r\n";
+            request += payload;
+
+            const char* data = request.data();
+            size_t remaining = request.size();
+            while (remaining > 0) {
+                ssize_t n = ::send(_socket, data, remaining, LOG4CPP_SEND_FLAGS);
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    break;
+                }
+                data += n;
+                remaining -= n;
+            }
+
+            int status;
+            if (remaining == 0 && _readResponse(status))
+                return status;
+
+            _disconnect();
+            if (!reused)
+                return 0;
+        }
+        return 0;
+    }
+
+    bool HttpBulkAppender::_receive() {
+        char buffer[4096];
+        ssize_t n;
+        do {
+            n = ::recv(_socket, buffer, sizeof(buffer), 0);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0)
+            return false;
+
+        _response.append(buffer, n);
+        return true;
+    }
+
+    bool HttpBulkAppender::_readResponse(int& status) {
+        std::string::size_type end;
+        while ((end = _response.find("\r\n\r\n")) == std::string::npos) {
+            if (!_receive())
+                return false;
+        }
+
+        std::vector<std::string> lines;
+        StringUtil::split(lines, _response.substr(0, end), '\n');
+        _response.erase(0, end + 4);
+        if (lines.empty() || lines[0].compare(0, 5, "HTTP/") != 0)
+            return false;
+
+        std::string::size_type space = lines[0].find(' ');
+        status = (space == std::string::npos) ? 0 : std::atoi(lines[0].c_str() + space + 1);
+        bool keepAlive = lines[0].compare(0, 8, "HTTP/1.0") != 0;
+        bool chunked = false;
+        long contentLength = -1;
+        for (size_t i = 1; i < lines.size(); i++) {
+            std::string::size_type colon = lines[i].find(':');
+            if (colon == std::string::npos)
+                continue;
+            std::string name = StringUtil::trim(lines[i].substr(0, colon));
+            std::string value = StringUtil::trim(lines[i].substr(colon + 1));
+            if (equalsIgnoreCase(name, "content-length")) {
+                contentLength = std::atol(value.c_str());
+            } else if (equalsIgnoreCase(name, "transfer-encoding")) {
+                chunked = equalsIgnoreCase(value, "chunked");
+            } else if (equalsIgnoreCase(name, "connection")) {
+                keepAlive = !equalsIgnoreCase(value, "close");
+            }
+        }
+
+        // skip the response body
+        if (chunked) {
+            for (;;) {
+                while ((end = _response.find("\r\n")) == std::string::npos) {
+                    if (!_receive())
+                        return false;
+                }
+                long size = std::strtol(_response.c_str(), NULL, 16);
+                _response.erase(0, end + 2);
+                if (size == 0) {
+                    // trailers, up to an empty line
+                    while ((end = _response.find("\r\n")) != 0) {
+                        if (end != std::string::npos) {
+                            _response.erase(0, end + 2);
+                        } else if (!_receive()) {
+                            return false;
+                        }
+                    }
+                    _response.erase(0, 2);
+                    break;
+                }
+                while (_response.size() < static_cast<size_t>(size) + 2) {
+                    if (!_receive())
+                        return false;
+                }
+                _response.erase(0, size + 2);
+            }
+        } else if (contentLength >= 0) {
+            while (_response.size() < static_cast<size_t>(contentLength)) {
+                if (!_receive())
+                    return false;
+            }
+            _response.erase(0, contentLength);
+        } else if (status != 204 && status != 304) {
+            // delimited by the end of the connection
+            while (_receive()) {
+            }
+            keepAlive = false;
+        }
+
+        if (!keepAlive) {
+            _disconnect();
+        }
+        return true;
+    }
+
+    std::auto_ptr<Appender> create_http_bulk_appender(const FactoryParams& params)
+    {
+       std::string name, url, format = "ndjson", action_line, gzip = "false";
+       size_t batch_size = HttpBulkAppender::DEFAULT_BATCH_SIZE, budget = HttpBulkAppender::DEFAULT_BUDGET;
+       unsigned int batch_delay = HttpBulkAppender::DEFAULT_BATCH_DELAY;
+       params.get_for("http bulk appender").required("name", name)("url", url)
+                                           .optional("format", format)("action_line", action_line)
+                                                    ("gzip", gzip)("batch_size", batch_size)
+                                                    ("batch_delay", batch_delay)("budget", budget);
+       std::auto_ptr<HttpBulkAppender> appender(new HttpBulkAppender(name, url,
+                                                                     (format == "json") ? HttpBulkAppender::JSON_ARRAY : HttpBulkAppender::NDJSON,
+                                                                     batch_size, batch_delay, budget));
+       appender->setActionLine(action_line);
+       appender->setGzip(gzip == "true" || gzip == "1");
+       return std::auto_ptr<Appender>(appender.release());
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
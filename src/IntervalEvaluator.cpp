@@ -0,0 +1,134 @@
+/*
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include <log4cpp/IntervalEvaluator.hh>
+#include <log4cpp/FactoryParams.hh>
+#ifdef LOG4CPP_USE_PTHREADS
+#include "ConditionClock.hh"
+#endif
+#include <memory>
+
+namespace log4cpp
+{
+   IntervalEvaluator::IntervalEvaluator(unsigned long interval) :
+      interval_(interval ? interval : 1), started_(0), trigger_(0)
+   {
+#ifdef LOG4CPP_USE_PTHREADS
+      ::pthread_mutex_init(&mutex_, NULL);
+      ::pthread_cond_init(&condition_, NULL);
+      running_ = false;
+#endif
+   }
+
+   IntervalEvaluator::~IntervalEvaluator()
+   {
+      attach(0);
+#ifdef LOG4CPP_USE_PTHREADS
+      ::pthread_cond_destroy(&condition_);
+      ::pthread_mutex_destroy(&mutex_);
+#endif
+   }
+
+   long long IntervalEvaluator::now()
+   {
+#ifdef LOG4CPP_USE_PTHREADS
+      // the timer thread waits for deadlines of this clock
+      return condition_clock::now();
+#else
+      TimeStamp stamp;
+      return stamp.getSeconds() * 1000LL + stamp.getMilliSeconds();
+#endif
+   }
+
+   bool IntervalEvaluator::eval(const LoggingEvent&) const
+   {
+      long long started = started_.loadRelaxed();
+      if (!started)
+      {
+         started = now();
+         started_.store(started);
+#ifdef LOG4CPP_USE_PTHREADS
+         // the timer sleeps while no batch is open
+         ::pthread_mutex_lock(&mutex_);
+         ::pthread_cond_signal(&condition_);
+         ::pthread_mutex_unlock(&mutex_);
+#endif
+      }
+      return now() - started >= static_cast<long long>(interval_);
+   }
+
+   void IntervalEvaluator::reset() const
+   {
+      started_.store(0);
+   }
+
+   void IntervalEvaluator::attach(Trigger* trigger)
+   {
+#ifdef LOG4CPP_USE_PTHREADS
+      if (running_)
+      {
+         ::pthread_mutex_lock(&mutex_);
+         running_ = false;
+         ::pthread_cond_signal(&condition_);
+         ::pthread_mutex_unlock(&mutex_);
+         ::pthread_join(thread_, NULL);
+      }
+
+      trigger_ = trigger;
+      if (trigger_)
+      {
+         // set before the thread may look at it
+         running_ = true;
+         if (::pthread_create(&thread_, NULL, &run, this) != 0)
+            running_ = false;
+      }
+#else
+      trigger_ = trigger;
+#endif
+   }
+
+#ifdef LOG4CPP_USE_PTHREADS
+   void* IntervalEvaluator::run(void* evaluator)
+   {
+      IntervalEvaluator* self = static_cast<IntervalEvaluator*>(evaluator);
+      ::pthread_mutex_lock(&self->mutex_);
+      while (self->running_)
+      {
+         long long started = self->started_.load();
+         if (!started)
+         {
+            ::pthread_cond_wait(&self->condition_, &self->mutex_);
+            continue;
+         }
+
+         long long deadline = started + self->interval_;
+         if (now() >= deadline)
+         {
+            // not holding the mutex: the trigger resets the evaluator
+            ::pthread_mutex_unlock(&self->mutex_);
+            self->trigger_->trigger();
+            // in case the trigger did not start a new batch
+            self->started_.compareExchange(started, 0);
+            ::pthread_mutex_lock(&self->mutex_);
+            continue;
+         }
+
+         const struct timespec timeout = condition_clock::toTimespec(deadline);
+         ::pthread_cond_timedwait(&self->condition_, &self->mutex_, &timeout);
+      }
+      ::pthread_mutex_unlock(&self->mutex_);
+      return NULL;
+   }
+#endif
+
+   std::auto_ptr<TriggeringEventEvaluator> create_interval_evaluator(const FactoryParams& params)
+   {
+      unsigned long interval;
+      params.get_for("interval evaluator").required("interval", interval);
+
+      return std::auto_ptr<TriggeringEventEvaluator>(new IntervalEvaluator(interval));
+   }
+}
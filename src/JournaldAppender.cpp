@@ -0,0 +1,234 @@
+/*
+ * JournaldAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#ifdef LOG4CPP_HAVE_MEMFD_CREATE
+#include <sys/mman.h>
+#endif
+#include <log4cpp/JournaldAppender.hh>
+#include <log4cpp/PassThroughLayout.hh>
+#include <log4cpp/FactoryParams.hh>
+#include <memory>
+
+namespace log4cpp {
+
+    const char* JournaldAppender::DEFAULT_SOCKET_PATH = "/run/systemd/journal/socket";
+
+    int JournaldAppender::toSyslogPriority(Priority::Value priority) {
+        // LOG_EMERG (0) .. LOG_DEBUG (7)
+        priority++;
+        priority /= 100;
+
+        if (priority < 0) {
+            return 0;
+        } else if (priority > 7) {
+            return 7;
+        } else {
+            return priority;
+        }
+    }
+
+    JournaldAppender::JournaldAppender(const std::string& name,
+                                       const std::string& syslogIdentifier,
+                                       const std::string& socketPath) :
+        LayoutAppender(name),
+        _syslogIdentifier(syslogIdentifier),
+        _socketPath(socketPath),
+        _socket(-1) {
+        setLayout(new PassThroughLayout());
+        open();
+    }
+
+    JournaldAppender::~JournaldAppender() {
+        close();
+    }
+
+    void JournaldAppender::open() {
+        _socket = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        if (_socket >= 0) {
+            ::fcntl(_socket, F_SETFD, FD_CLOEXEC);
+        }
+        // fail silently, like RemoteSyslogAppender
+    }
+
+    void JournaldAppender::close() {
+        if (_socket >= 0) {
+            ::close(_socket);
+            _socket = -1;
+        }
+    }
+
+    bool JournaldAppender::reopen() {
+        close();
+        open();
+        return _socket >= 0;
+    }
+
+    unsigned int JournaldAppender::getRequiredFields() {
+        return _getLayoutFields() |
+            LoggingEvent::FIELD_THREAD | LoggingEvent::FIELD_NDC | LoggingEvent::FIELD_MDC;
+    }
+
+    void JournaldAppender::_appendField(const char* name, const std::string& value) {
+        _buffer.append(name);
+        if (value.find('\n') == std::string::npos) {
+            _buffer += '=';
+            _buffer.append(value);
+        } else {
+            // binary safe encoding: name, newline, little endian 64 bit
+            // length, data
+            _buffer += '\n';
+            unsigned long long length = value.size();
+            for (int i = 0; i < 8; i++) {
+                _buffer += static_cast<char>((length >> (8 * i)) & 0xff);
+            }
+            _buffer.append(value);
+        }
+        _buffer += '\n';
+    }
+
+    const std::string& JournaldAppender::_mdcFieldName(const std::string& key) {
+        // journal field names are upper case letters, digits and '_',
+        // at most 64 of them
+        _fieldName.assign("LOG4CPP_MDC_");
+        for (std::string::const_iterator i = key.begin(); i != key.end() && _fieldName.size() < 64; ++i) {
+            const char c = *i;
+            if (c >= 'a' && c <= 'z') {
+                _fieldName += static_cast<char>(c - 'a' + 'A');
+            } else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                _fieldName += c;
+            } else {
+                _fieldName += '_';
+            }
+        }
+        return _fieldName;
+    }
+
+    void JournaldAppender::_append(const LoggingEvent& event) {
+        if (_socket < 0)
+            return;
+
+        char priority[2] = { static_cast<char>('0' + toSyslogPriority(event.priority)), '\0' };
+
+        _buffer.clear();
+        _appendField("MESSAGE", _getLayout().format(event));
+        _appendField("PRIORITY", priority);
+        _appendField("SYSLOG_IDENTIFIER", _syslogIdentifier);
+        _appendField("LOG4CPP_CATEGORY", event.categoryName);
+        if (!event.ndc.empty()) {
+            _appendField("LOG4CPP_NDC", event.ndc);
+        }
+        _appendField("LOG4CPP_THREAD", event.threadName);
+        for (MDC::Snapshot::const_iterator i = event.mdc.begin(); i != event.mdc.end(); ++i) {
+            _appendField(_mdcFieldName(*i->key).c_str(), i->value);
+        }
+
+        struct sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, _socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        struct iovec iov;
+        iov.iov_base = const_cast<char*>(_buffer.data());
+        iov.iov_len = _buffer.size();
+
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &address;
+        msg.msg_namelen = sizeof(address);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        if (::sendmsg(_socket, &msg, 0) >= 0)
+            return;
+
+        if (errno == EMSGSIZE || errno == ENOBUFS) {
+            _sendMemfd();
+        }
+        // otherwise fail silently
+    }
+
+    bool JournaldAppender::_sendMemfd() {
+#if defined(LOG4CPP_HAVE_MEMFD_CREATE) && defined(MFD_ALLOW_SEALING)
+        int fd = ::memfd_create("log4cpp-journal", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (fd < 0)
+            return false;
+
+        const char* data = _buffer.data();
+        size_t remaining = _buffer.size();
+        while (remaining > 0) {
+            ssize_t n = ::write(fd, data, remaining);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                ::close(fd);
+                return false;
+            }
+            data += n;
+            remaining -= n;
+        }
+
+        // journald only accepts memfds it can trust not to change
+        ::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+
+        struct sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, _socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        union {
+            struct cmsghdr header;
+            char space[CMSG_SPACE(sizeof(int))];
+        } control;
+        std::memset(&control, 0, sizeof(control));
+
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &address;
+        msg.msg_namelen = sizeof(address);
+        msg.msg_control = &control;
+        msg.msg_controllen = sizeof(control);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+        bool result = ::sendmsg(_socket, &msg, 0) >= 0;
+        ::close(fd);
+        return result;
+#else
+        return false;
+#endif
+    }
+
+    std::auto_ptr<Appender> create_journald_appender(const FactoryParams& params)
+    {
+       std::string name, identifier, socket_path = JournaldAppender::DEFAULT_SOCKET_PATH;
+       params.get_for("journald appender").required("name", name)
+                                          .optional("identifier", identifier)("socket", socket_path);
+       if (identifier.empty())
+          identifier = name;
+       return std::auto_ptr<Appender>(new JournaldAppender(name, identifier, socket_path));
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
@@ -9,16 +9,19 @@
 
 #include "PortabilityImpl.hh"
 #include <log4cpp/LayoutAppender.hh>
+#include <log4cpp/Category.hh>
+#include "FormatMemo.hh"
 
 namespace log4cpp {
 
     LayoutAppender::LayoutAppender(const std::string& name) : 
             AppenderSkeleton(name),
-            _layout(new DefaultLayoutType()) {
+            _layout(new DefaultLayoutType()),
+            _sharedLayout(_layout) {
     }
     
     LayoutAppender::~LayoutAppender() {
-        delete _layout;
+        _layout->release();
     }
 
     bool LayoutAppender::requiresLayout() const {
@@ -29,11 +32,33 @@ namespace log4cpp {
        if (layout != _layout) {
 	  Layout *oldLayout = _layout;
 	  _layout = (layout == NULL) ? new DefaultLayoutType() : layout;
-	  delete oldLayout;
+	  oldLayout->release();
+	  Category::requiredFieldsChanged();
        }
     }
 
+    unsigned int LayoutAppender::getRequiredFields() {
+        return LoggingEvent::ALL_FIELDS;
+    }
+
+    unsigned int LayoutAppender::_getLayoutFields() {
+        return getFilter() ? static_cast<unsigned int>(LoggingEvent::ALL_FIELDS) :
+            _getLayout().getRequiredFields();
+    }
+
     Layout& LayoutAppender::_getLayout() {
-        return *_layout;
+        return _layout->isShared() ? _sharedLayout : *_layout;
+    }
+
+    LayoutAppender::SharedLayout::SharedLayout(Layout* const& layout) :
+        _layout(layout) {
+    }
+
+    std::string LayoutAppender::SharedLayout::format(const LoggingEvent& event) {
+        return FormatMemo::format(*_layout, event);
+    }
+
+    unsigned int LayoutAppender::SharedLayout::getRequiredFields() const {
+        return _layout->getRequiredFields();
     }
 }
@@ -9,18 +9,90 @@
 
 #include "PortabilityImpl.hh"
 #include <log4cpp/LoggingEvent.hh>
-#include <log4cpp/threading/Threading.hh>
+#include <log4cpp/Allocator.hh>
+#include <log4cpp/threading/ThreadIdentity.hh>
 
 namespace log4cpp {
-    
+
     LoggingEvent::LoggingEvent(const std::string& categoryName, 
                                const std::string& message,
                                const std::string& ndc, 
                                Priority::Value priority) :
-        categoryName(categoryName),
-        message(message),
+        _categoryName(categoryName),
+        _message(message),
+        _threadName(threading::getThreadName()),
+        categoryName(_categoryName.str()),
+        message(_message.str()),
+        ndc(ndc),
+        mdc(MDC::getSnapshot()),
+        priority(priority),
+        threadName(_threadName.str()),
+        systemThreadId(threading::getSystemThreadId()) {
+    }
+
+    LoggingEvent::LoggingEvent(const std::string& categoryName, 
+                               const std::string& message,
+                               const std::string& ndc, 
+                               Priority::Value priority,
+                               const std::string& threadName,
+                               const TimeStamp& timeStamp,
+                               const MDC::Snapshot& mdc) :
+        _categoryName(categoryName),
+        _message(message),
+        _threadName(threadName),
+        categoryName(_categoryName.str()),
+        message(_message.str()),
         ndc(ndc),
+        mdc(mdc),
         priority(priority),
-        threadName(threading::getThreadId()) {
+        threadName(_threadName.str()),
+        systemThreadId(0),
+        timeStamp(timeStamp) {
+    }
+
+    LoggingEvent::LoggingEvent(const SharedString& categoryName, 
+                               const SharedString& message,
+                               const NDC::ContextStack& ndc, 
+                               Priority::Value priority,
+                               unsigned int fields) :
+        _categoryName(categoryName),
+        _message(message),
+        _threadName((fields & FIELD_THREAD) ? threading::getThreadName() : SharedString()),
+        categoryName(_categoryName.str()),
+        message(_message.str()),
+        ndc((fields & FIELD_NDC) ? ndc : NDC::ContextStack()),
+        mdc((fields & FIELD_MDC) ? MDC::getSnapshot() : MDC::Snapshot()),
+        priority(priority),
+        threadName(_threadName.str()),
+        systemThreadId((fields & FIELD_THREAD) ? threading::getSystemThreadId() : 0),
+        timeStamp((fields & FIELD_TIMESTAMP) ? TimeStamp() : TimeStamp(0, 0)) {
+    }
+
+    LoggingEvent::LoggingEvent(const SharedString& categoryName, 
+                               const SharedString& message,
+                               const NDC::ContextStack& ndc, 
+                               Priority::Value priority,
+                               const SharedString& threadName,
+                               const TimeStamp& timeStamp,
+                               const MDC::Snapshot& mdc) :
+        _categoryName(categoryName),
+        _message(message),
+        _threadName(threadName),
+        categoryName(_categoryName.str()),
+        message(_message.str()),
+        ndc(ndc),
+        mdc(mdc),
+        priority(priority),
+        threadName(_threadName.str()),
+        systemThreadId(0),
+        timeStamp(timeStamp) {
+    }
+
+    void* LoggingEvent::operator new(size_t size) {
+        return Allocator::allocateBlock(size);
+    }
+
+    void LoggingEvent::operator delete(void* event, size_t size) {
+        Allocator::deallocateBlock(event, size);
     }
 }
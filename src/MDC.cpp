@@ -0,0 +1,204 @@
+/*
+ * MDC.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/MDC.hh>
+#include <log4cpp/ExecutionContext.hh>
+#include <log4cpp/threading/Threading.hh>
+#include <set>
+
+namespace log4cpp {
+
+    namespace {
+        const std::string& emptyValue() {
+            static const std::string empty;
+            return empty;
+        }
+
+        struct KeyTable {
+            threading::Mutex mutex;
+            std::set<std::string> keys;
+        };
+
+        KeyTable& getKeyTable() {
+            static KeyTable table;
+            return table;
+        }
+
+        const MDC::Snapshot::Entries& emptyEntries() {
+            static const MDC::Snapshot::Entries empty;
+            return empty;
+        }
+    }
+
+    bool MDC::isUsedMDC = false;
+
+    MDC::Key MDC::key(const std::string& name) {
+        KeyTable& table = getKeyTable();
+        threading::ScopedLock lock(table.mutex);
+        return &*table.keys.insert(name).first;
+    }
+
+    MDC::Snapshot::Snapshot(const Entries& entries) :
+        _rep(NULL) {
+        if (!entries.empty()) {
+            _rep = new Rep();
+            _rep->entries = entries;
+        }
+    }
+
+    MDC::Snapshot::Snapshot(const Snapshot& other) :
+        _rep(other._rep) {
+        if (_rep)
+            _rep->references.fetchAdd(1);
+    }
+
+    MDC::Snapshot& MDC::Snapshot::operator=(const Snapshot& other) {
+        if (_rep != other._rep) {
+            if (other._rep)
+                other._rep->references.fetchAdd(1);
+            _release();
+            _rep = other._rep;
+        }
+        return *this;
+    }
+
+    MDC::Snapshot::~Snapshot() {
+        _release();
+    }
+
+    void MDC::Snapshot::_release() {
+        if (_rep && _rep->references.fetchAdd(static_cast<unsigned long>(-1)) == 1)
+            delete _rep;
+    }
+
+    MDC::Snapshot::Entry* MDC::Snapshot::_find(Key key) const {
+        if (_rep) {
+            for (Entries::iterator i = _rep->entries.begin(); i != _rep->entries.end(); ++i) {
+                if (i->key == key)
+                    return &*i;
+            }
+        }
+        return NULL;
+    }
+
+    const std::string& MDC::Snapshot::get(Key key) const {
+        Entry* entry = _find(key);
+        return entry ? entry->value : emptyValue();
+    }
+
+    const std::string& MDC::Snapshot::get(const std::string& name) const {
+        if (_rep) {
+            for (const_iterator i = _rep->entries.begin(); i != _rep->entries.end(); ++i) {
+                if (*i->key == name)
+                    return i->value;
+            }
+        }
+        return emptyValue();
+    }
+
+    bool MDC::Snapshot::contains(Key key) const {
+        return _find(key) != NULL;
+    }
+
+    MDC::Snapshot::const_iterator MDC::Snapshot::begin() const {
+        return _rep ? _rep->entries.begin() : emptyEntries().begin();
+    }
+
+    MDC::Snapshot::const_iterator MDC::Snapshot::end() const {
+        return _rep ? _rep->entries.end() : emptyEntries().end();
+    }
+
+    void MDC::put(Key key, const std::string& value) {
+        if (!isUsedMDC)
+            isUsedMDC = true;
+        getMDC()._put(key, value);
+    }
+
+    void MDC::put(const std::string& name, const std::string& value) {
+        put(key(name), value);
+    }
+
+    const std::string& MDC::get(const std::string& name) {
+        return getSnapshot().get(name);
+    }
+
+    void MDC::remove(Key key) {
+        getMDC()._remove(key);
+    }
+
+    void MDC::remove(const std::string& name) {
+        remove(key(name));
+    }
+
+    void MDC::clear() {
+        getMDC()._clear();
+    }
+
+    const MDC::Snapshot& MDC::getSnapshot() {
+        static const Snapshot empty;
+
+        if (isUsedMDC)
+            return getMDC()._snapshot;
+        else
+            return empty;
+    }
+
+    MDC& MDC::getMDC() {
+        return ExecutionContext::getCurrent().getMDC();
+    }
+
+    MDC::MDC() {
+    }
+
+    MDC::~MDC() {
+    }
+
+    void MDC::_detach() {
+        // copy on write: events may share the entries
+        if (!_snapshot._rep) {
+            _snapshot._rep = new Snapshot::Rep();
+        } else if (_snapshot._rep->references.load() > 1) {
+            Snapshot::Rep* copy = new Snapshot::Rep();
+            copy->entries = _snapshot._rep->entries;
+            _snapshot._release();
+            _snapshot._rep = copy;
+        }
+    }
+
+    void MDC::_put(Key key, const std::string& value) {
+        _detach();
+        Snapshot::Entry* entry = _snapshot._find(key);
+        if (entry) {
+            entry->value = value;
+        } else {
+            Snapshot::Entry added;
+            added.key = key;
+            added.value = value;
+            _snapshot._rep->entries.push_back(added);
+        }
+    }
+
+    void MDC::_remove(Key key) {
+        if (!_snapshot._find(key))
+            return;
+
+        _detach();
+        Snapshot::Entries& entries = _snapshot._rep->entries;
+        for (Snapshot::Entries::iterator i = entries.begin(); i != entries.end(); ++i) {
+            if (i->key == key) {
+                entries.erase(i);
+                break;
+            }
+        }
+    }
+
+    void MDC::_clear() {
+        _snapshot = Snapshot();
+    }
+}
@@ -9,28 +9,113 @@
 
 #include "PortabilityImpl.hh"
 #include <log4cpp/NDC.hh>
-#include <log4cpp/threading/Threading.hh>
+#include <log4cpp/ExecutionContext.hh>
+#include <ostream>
 
 namespace log4cpp {
 
-    NDC::DiagnosticContext::DiagnosticContext(const std::string& message) :
+    NDC::DiagnosticContext::DiagnosticContext(const std::string& message,
+            const DiagnosticContext* parent) :
         message(message),
-        fullMessage(message) {
+        parent(parent),
+        depth(parent ? parent->depth + 1 : 1),
+        _references(1),
+        _fullMessage(NULL) {
+    }
+
+    NDC::DiagnosticContext::~DiagnosticContext() {
+        delete _fullMessage.load();
+    }
+
+    const std::string& NDC::DiagnosticContext::fullMessage() const {
+        if (!parent)
+            return message;
+
+        std::string* full = _fullMessage.load();
+        if (!full) {
+            const std::string& parentMessage = parent->fullMessage();
+            std::string* rendered = new std::string();
+            rendered->reserve(parentMessage.size() + 1 + message.size());
+            rendered->append(parentMessage).append(1, ' ').append(message);
+            // another thread may have been first
+            if (_fullMessage.compareExchange(full, rendered)) {
+                full = rendered;
+            } else {
+                delete rendered;
+            }
+        }
+        return *full;
     }
 
-    NDC::DiagnosticContext::DiagnosticContext(const std::string& message, 
-            const DiagnosticContext& parent) :
-        message(message),
-        fullMessage(parent.fullMessage + " " + message) {
+    NDC::ContextStack::ContextStack(const std::string& message) :
+        _top(message.empty() ? NULL : new DiagnosticContext(message, NULL)) {
     }
 
-	bool NDC::isUsedNDC = false;
-	const std::string NDC::emptyString = "";
+    NDC::ContextStack::ContextStack(const ContextStack& other) :
+        _top(other._top) {
+        if (_top)
+            _top->_references.fetchAdd(1);
+    }
+
+    NDC::ContextStack& NDC::ContextStack::operator=(const ContextStack& other) {
+        if (_top != other._top) {
+            if (other._top)
+                other._top->_references.fetchAdd(1);
+            _release(_top);
+            _top = other._top;
+        }
+        return *this;
+    }
+
+    NDC::ContextStack::~ContextStack() {
+        _release(_top);
+    }
+
+    void NDC::ContextStack::_release(const DiagnosticContext* context) {
+        // iteratively rather than recursively, for deep stacks
+        while (context && context->_references.fetchAdd(static_cast<unsigned long>(-1)) == 1) {
+            const DiagnosticContext* parent = context->parent;
+            delete context;
+            context = parent;
+        }
+    }
+
+    NDC::ContextStack NDC::ContextStack::push(const std::string& message) const {
+        ContextStack result;
+        if (_top)
+            _top->_references.fetchAdd(1);
+        result._top = new DiagnosticContext(message, _top);
+        return result;
+    }
+
+    NDC::ContextStack NDC::ContextStack::pop() const {
+        ContextStack result;
+        if (_top && _top->parent) {
+            result._top = _top->parent;
+            result._top->_references.fetchAdd(1);
+        }
+        return result;
+    }
+
+    const std::string& NDC::ContextStack::str() const {
+        return _top ? _top->fullMessage() : NDC::emptyString;
+    }
+
+    bool operator==(const NDC::ContextStack& stack, const std::string& message) {
+        return stack.str() == message;
+    }
 
-	namespace {
-        threading::ThreadLocalDataHolder<NDC> _nDC;
+    bool operator==(const NDC::ContextStack& stack, const char* message) {
+        return stack.str() == message;
     }
 
+    std::ostream& operator<<(std::ostream& out, const NDC::ContextStack& stack) {
+        return out << stack.str();
+    }
+
+	bool NDC::isUsedNDC = false;
+	const std::string NDC::emptyString = "";
+
     void NDC::clear() {
         getNDC()._clear();
     }
@@ -46,6 +131,15 @@ namespace log4cpp {
     		return emptyString;
     }
 
+    const NDC::ContextStack& NDC::getStack() {
+        static const ContextStack empty;
+
+        if (isUsedNDC)
+            return getNDC()._getStack();
+        else
+            return empty;
+    }
+
     size_t NDC::getDepth() {
         return getNDC()._getDepth();
     }
@@ -69,14 +163,7 @@ namespace log4cpp {
     }
 
     NDC& NDC::getNDC() {
-        NDC* nDC = _nDC.get();
-
-        if (!nDC) {
-            nDC = new NDC();
-            _nDC.reset(nDC);
-        }
-
-        return *nDC;
+        return ExecutionContext::getCurrent().getNDC();
     }
 
     NDC::NDC() {
@@ -86,7 +173,7 @@ namespace log4cpp {
     }
 
     void NDC::_clear() {
-        _stack.clear();
+        _stack = ContextStack();
     }
 
     NDC::ContextStack* NDC::_cloneStack() {
@@ -94,13 +181,15 @@ namespace log4cpp {
     }
 
     const std::string& NDC::_get() const {
-        static std::string empty = "";
+        return _stack.str();
+    }
 
-        return (_stack.empty() ? empty : _stack.back().fullMessage);
+    const NDC::ContextStack& NDC::_getStack() const {
+        return _stack;
     }
 
     size_t NDC::_getDepth() const {
-        return _stack.size();
+        return _stack.depth();
     }
 
     void NDC::_inherit(NDC::ContextStack* stack) {
@@ -108,17 +197,16 @@ namespace log4cpp {
     }
 
     std::string NDC::_pop() {
-        std::string result = _stack.back().message;
-        _stack.pop_back();
+        if (_stack.empty())
+            return emptyString;
+
+        std::string result = _stack.top()->message;
+        _stack = _stack.pop();
         return result;
     }
 
     void NDC::_push(const std::string& message) {
-        if (_stack.empty()) {
-            _stack.push_back(DiagnosticContext(message));
-        } else {            
-            _stack.push_back(DiagnosticContext(message, _stack.back()));
-        }
+        _stack = _stack.push(message);
     }
 
     void NDC::_setMaxDepth(int maxDepth) {
@@ -31,6 +31,10 @@ namespace log4cpp {
         // empty
     }
 
+    unsigned int OstreamAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void OstreamAppender::_append(const LoggingEvent& event) {
         (*_stream) << _getLayout().format(event);
         if (!_stream->good()) {
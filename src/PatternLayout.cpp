@@ -9,10 +9,13 @@
 #include "PortabilityImpl.hh"
 
 #include <log4cpp/PatternLayout.hh>
+#include <log4cpp/Category.hh>
 #include <log4cpp/Priority.hh>
 #include <log4cpp/NDC.hh>
+#include <log4cpp/MDC.hh>
 #include <log4cpp/TimeStamp.hh>
 #include <log4cpp/FactoryParams.hh>
+#include <log4cpp/Format.hh>
 #include <memory>
 
 #ifdef LOG4CPP_HAVE_SSTREAM
@@ -21,9 +24,9 @@
 #include <strstream>
 #endif
 
-#include <iomanip>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
 #include "Localtime.hh"
 
 #ifdef LOG4CPP_HAVE_INT64_T
@@ -111,6 +114,29 @@ namespace log4cpp {
         }
     };
 
+    struct MDCComponent : public PatternLayout::PatternComponent {
+        MDCComponent(const std::string& key) :
+            _key(key.empty() ? NULL : MDC::key(key)) {
+        }
+
+        virtual void append(std::ostringstream& out, const LoggingEvent& event) {
+            if (_key) {
+                out << event.mdc.get(_key);
+            } else {
+                out << '{';
+                for (MDC::Snapshot::const_iterator i = event.mdc.begin(); i != event.mdc.end(); ++i) {
+                    if (i != event.mdc.begin())
+                        out << ", ";
+                    out << *i->key << '=' << i->value;
+                }
+                out << '}';
+            }
+        }
+
+        private:
+        MDC::Key _key;
+    };
+
     struct PriorityComponent : public PatternLayout::PatternComponent {
         virtual void append(std::ostringstream& out, const LoggingEvent& event) {
             out << Priority::getPriorityName(event.priority);
@@ -123,6 +149,13 @@ namespace log4cpp {
         }
     };
 
+    struct SystemThreadIdComponent : public PatternLayout::PatternComponent {
+        virtual void append(std::ostringstream& out, const LoggingEvent& event) {
+            char number[NumberFormat::maxLength];
+            out.write(number, NumberFormat::formatUnsigned(number, event.systemThreadId));
+        }
+    };
+
     struct ProcessorTimeComponent : public PatternLayout::PatternComponent {
         virtual void append(std::ostringstream& out, const LoggingEvent& event) {
             out << std::clock();
@@ -142,30 +175,43 @@ namespace log4cpp {
             } else if (timeFormat == "DATE") {
                 timeFormat = FORMAT_DATE;
             }
-            std::string::size_type pos = timeFormat.find("%l");
+            // the first of %l, %us and %ns gives the subseconds
+            static const char* const subsecondSpecifiers[] = { "%l", "%us", "%ns" };
+            static const int subsecondDigits[] = { 3, 6, 9 };
+            std::string::size_type pos = std::string::npos;
+            std::string::size_type length = 0;
+            for (int i = 0; i < 3; i++) {
+                std::string::size_type found = timeFormat.find(subsecondSpecifiers[i]);
+                if (found < pos) {
+                    pos = found;
+                    length = std::strlen(subsecondSpecifiers[i]);
+                    _subsecondDigits = subsecondDigits[i];
+                }
+            }
             if (pos == std::string::npos) {
-                _printMillis = false;
+                _subsecondDigits = 0;
                 _timeFormat1 = timeFormat; 
             } else {
-                _printMillis = true;
                 _timeFormat1 = timeFormat.substr(0, pos);
-                _timeFormat2 = timeFormat.substr(pos + 2);
+                _timeFormat2 = timeFormat.substr(pos + length);
             }
         }
 
         virtual void append(std::ostringstream& out, const LoggingEvent& event) {
             struct std::tm currentTime;
-            std::time_t t = event.timeStamp.getSeconds();
+            std::time_t t = static_cast<std::time_t>(event.timeStamp.getSeconds());
             localtime(&t, &currentTime);
             char formatted[100];
             std::string timeFormat;
-            if (_printMillis) {
-                std::ostringstream formatStream;
-                formatStream << _timeFormat1 
-                             << std::setw(3) << std::setfill('0')
-                             << event.timeStamp.getMilliSeconds()
-                             << _timeFormat2;
-                timeFormat = formatStream.str();
+            if (_subsecondDigits) {
+                int subseconds = event.timeStamp.getNanoSeconds();
+                for (int digits = 9; digits > _subsecondDigits; digits--) {
+                    subseconds /= 10;
+                }
+                char number[NumberFormat::maxLength];
+                const size_t length = NumberFormat::formatUnsigned(number, subseconds, _subsecondDigits);
+                timeFormat.reserve(_timeFormat1.size() + length + _timeFormat2.size());
+                timeFormat.append(_timeFormat1).append(number, length).append(_timeFormat2);
             } else {
                 timeFormat = _timeFormat1;
             }
@@ -176,7 +222,7 @@ namespace log4cpp {
         private:
         std::string _timeFormat1;
         std::string _timeFormat2;
-        bool _printMillis;
+        int _subsecondDigits;
     };
 
     const char* const TimeStampComponent::FORMAT_ISO8601 = "%Y-%m-%d %H:%M:%S,%l";
@@ -185,31 +231,33 @@ namespace log4cpp {
 
     struct SecondsSinceEpochComponent : public PatternLayout::PatternComponent {
         virtual void append(std::ostringstream& out, const LoggingEvent& event) {
-            out << event.timeStamp.getSeconds();
+            char number[NumberFormat::maxLength];
+            out.write(number, NumberFormat::formatInteger(number, event.timeStamp.getSeconds()));
         }
     };
 
-    struct MillisSinceEpochComponent : public PatternLayout::PatternComponent {
+    struct TimeSinceStartComponent : public PatternLayout::PatternComponent {
+        TimeSinceStartComponent(const std::string& unit) {
+            if (unit == "" || unit == "ms") {
+                _divisor = 1000000;
+            } else if (unit == "us") {
+                _divisor = 1000;
+            } else if (unit == "ns") {
+                _divisor = 1;
+            } else {
+                throw ConfigureFailure("unknown unit '" + unit + "' for %r, expected ms, us or ns");
+            }
+        }
+
         virtual void append(std::ostringstream& out, const LoggingEvent& event) {
-#ifdef LOG4CPP_HAVE_INT64_T
-            int64_t t = event.timeStamp.getSeconds() -
-                TimeStamp::getStartTime().getSeconds();
-            t *= 1000;
-            t += event.timeStamp.getMilliSeconds() -
-                TimeStamp::getStartTime().getMilliSeconds();
-            
-            out << t;
-#else
-            double t = event.timeStamp.getSeconds() -
-                TimeStamp::getStartTime().getSeconds();
-            t *= 1000;
-            t += event.timeStamp.getMilliSeconds() -
-                TimeStamp::getStartTime().getMilliSeconds();
-            
-            out << std::setiosflags(std::ios::fixed)
-                << std::setprecision(0) << t;
-#endif
+            int64_t t = event.timeStamp.getNanoSecondsSinceEpoch() -
+                TimeStamp::getStartTime().getNanoSecondsSinceEpoch();
+            char number[NumberFormat::maxLength];
+            out.write(number, NumberFormat::formatInteger(number, t / _divisor));
         }
+
+        private:
+        int64_t _divisor;
     };
 
     struct FormatModifierComponent : public PatternLayout::PatternComponent {
@@ -256,7 +304,8 @@ namespace log4cpp {
     const char* PatternLayout::BASIC_CONVERSION_PATTERN = "%R %p %c %x: %m%n";
     const char* PatternLayout::TTCC_CONVERSION_PATTERN = "%r [%t] %p %c %x - %m%n";
 
-    PatternLayout::PatternLayout() {
+    PatternLayout::PatternLayout() :
+        _requiredFields(0) {
         try {
             setConversionPattern(DEFAULT_CONVERSION_PATTERN);
         } catch(ConfigureFailure&) {
@@ -274,6 +323,8 @@ namespace log4cpp {
         }
         _components.clear();
         _conversionPattern = "";
+        _requiredFields = 0;
+        Category::requiredFieldsChanged();
     }
 
     void PatternLayout::setConversionPattern(const std::string& conversionPattern) {
@@ -343,24 +394,37 @@ namespace log4cpp {
                     break;
                 case 'd':
                     component = new TimeStampComponent(specPostfix);
+                    _requiredFields |= LoggingEvent::FIELD_TIMESTAMP;
                     break;
                 case 'p':
                     component = new PriorityComponent();
                     break;
                 case 'r':
-                    component = new MillisSinceEpochComponent();
+                    component = new TimeSinceStartComponent(specPostfix);
+                    _requiredFields |= LoggingEvent::FIELD_TIMESTAMP;
                     break;
                 case 'R':
                     component = new SecondsSinceEpochComponent();
+                    _requiredFields |= LoggingEvent::FIELD_TIMESTAMP;
                     break;
                 case 't':
-                    component = new ThreadNameComponent();
+                    if (specPostfix == "tid") {
+                        component = new SystemThreadIdComponent();
+                    } else {
+                        component = new ThreadNameComponent();
+                    }
+                    _requiredFields |= LoggingEvent::FIELD_THREAD;
                     break;
                 case 'u':
                     component = new ProcessorTimeComponent();
                     break;
                 case 'x':
                     component = new NDCComponent();
+                    _requiredFields |= LoggingEvent::FIELD_NDC;
+                    break;
+                case 'X':
+                    component = new MDCComponent(specPostfix);
+                    _requiredFields |= LoggingEvent::FIELD_MDC;
                     break;
                 default:
                     std::ostringstream msg;
@@ -388,12 +452,17 @@ namespace log4cpp {
         }
 
         _conversionPattern = conversionPattern;
+        Category::requiredFieldsChanged();
     }
 
     std::string PatternLayout::getConversionPattern() const {
         return _conversionPattern;
     }
 
+    unsigned int PatternLayout::getRequiredFields() const {
+        return _requiredFields;
+    }
+
     std::string PatternLayout::format(const LoggingEvent& event) {
         std::ostringstream message;
 
@@ -0,0 +1,169 @@
+/*
+ * Pool.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_POOL_HH
+#define _LOG4CPP_POOL_HH
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/threading/Threading.hh>
+#include <log4cpp/threading/Atomic.hh>
+#include <cstddef>
+#include <vector>
+
+namespace log4cpp {
+    namespace pool {
+
+        /*
+         * A list other threads push nodes onto, e.g. memory they free on
+         * behalf of the thread owning it, and which the owner takes as a
+         * whole. T needs a 'T* next' member. As nodes are only ever taken
+         * all at once, pushing cannot suffer from ABA.
+         */
+        template<typename T> class RemoteList {
+            public:
+            RemoteList() :
+                _head(NULL) {
+            }
+
+            void push(T* node) {
+                T* head = _head.loadRelaxed();
+                do {
+                    node->next = head;
+                } while (!_head.compareExchange(head, node));
+            }
+
+            T* takeAll() {
+                return _head.loadRelaxed() ? _head.exchange(NULL) : NULL;
+            }
+
+            private:
+            RemoteList(const RemoteList& other);
+            RemoteList& operator=(const RemoteList& other);
+
+            threading::Atomic<T*> _head;
+        };
+
+        /*
+         * Hands each thread a Cache of its own. Other threads may still
+         * return memory to a cache after its thread ended, so caches are
+         * never destroyed: the next thread needing one adopts it instead.
+         * Neither are the holder and the list of caches, so that statics
+         * may still free memory while the program exits.
+         */
+        template<typename Cache> class ThreadCaches {
+            public:
+            static Cache& get() {
+                Holder& holder = _getHolder();
+                Handle* handle = holder.get();
+                if (!handle) {
+                    handle = new Handle(_adopt());
+                    holder.reset(handle);
+                }
+                return *handle->cache;
+            }
+
+            /*
+             * Copies the caches made so far, e.g. to sum their counters.
+             */
+            static void getAll(std::vector<Cache*>& caches) {
+                State& state = _getState();
+                threading::ScopedLock lock(state.mutex);
+                caches = state.all;
+            }
+
+            private:
+            struct State {
+                threading::Mutex mutex;
+                std::vector<Cache*> all;
+                std::vector<Cache*> abandoned;
+            };
+
+            struct Handle {
+                Handle(Cache* cache) :
+                    cache(cache) {
+                }
+
+                // the thread ended
+                ~Handle() {
+                    State& state = _getState();
+                    threading::ScopedLock lock(state.mutex);
+                    state.abandoned.push_back(cache);
+                }
+
+                Cache* cache;
+            };
+
+            typedef threading::ThreadLocalDataHolder<Handle> Holder;
+
+            static State& _getState() {
+                static State* state = new State();
+                return *state;
+            }
+
+            static Holder& _getHolder() {
+                static Holder* holder = new Holder();
+                return *holder;
+            }
+
+            static Cache* _adopt() {
+                State& state = _getState();
+                threading::ScopedLock lock(state.mutex);
+                if (!state.abandoned.empty()) {
+                    Cache* cache = state.abandoned.back();
+                    state.abandoned.pop_back();
+                    return cache;
+                }
+                Cache* cache = new Cache();
+                state.all.push_back(cache);
+                return cache;
+            }
+        };
+
+        /*
+         * Keeps up to maxFree objects per thread for reuse, e.g. buffers
+         * which are expensive to set up again. An object goes to the free
+         * list of the thread releasing it.
+         */
+        template<typename T, size_t maxFree> class FreeList {
+            public:
+            FreeList() {
+                _free.reserve(maxFree);
+            }
+
+            static T* acquire() {
+                std::vector<T*>& free = ThreadCaches<FreeList>::get()._free;
+                if (free.empty())
+                    return new T();
+
+                T* object = free.back();
+                free.pop_back();
+                return object;
+            }
+
+            static void release(T* object) {
+                std::vector<T*>& free = ThreadCaches<FreeList>::get()._free;
+                if (free.size() < maxFree) {
+                    free.push_back(object);
+                } else {
+                    delete object;
+                }
+            }
+
+            private:
+            std::vector<T*> _free;
+        };
+
+        /*
+         * Counts memory taken from the system outside of Allocator blocks,
+         * e.g. to grow message buffers, in Allocator::Statistics.
+         */
+        void countSystemAllocation(size_t bytes);
+    }
+}
+
+#endif // _LOG4CPP_POOL_HH
@@ -0,0 +1,292 @@
+/*
+ * PrintfFormat.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/PrintfFormat.hh>
+#include <stddef.h>
+#include <cstring>
+
+namespace log4cpp {
+
+    namespace {
+        void appendPrintf(FormatBuffer& buffer, const char* format, ...) {
+            va_list arguments;
+            va_start(arguments, format);
+            buffer.appendVprintf(format, arguments);
+            va_end(arguments);
+        }
+
+        bool isDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+    }
+
+    PrintfFormat::PrintfFormat(const char* format) :
+        _format(format ? format : ""),
+        _compiled(true) {
+        const char* literal = format = _format.c_str();
+        std::string text;
+
+        while (_compiled && *format) {
+            if (*format != '%') {
+                ++format;
+                continue;
+            }
+
+            text.append(literal, format);
+            if (format[1] == '%') {
+                // "%%" is literal text
+                text += '%';
+                literal = format += 2;
+            } else {
+                _appendLiteral(text);
+                literal = format = _parseConversion(format);
+            }
+        }
+
+        text.append(literal, format);
+        _appendLiteral(text);
+
+        if (!_compiled)
+            _segments.clear();
+    }
+
+    PrintfFormat::~PrintfFormat() {
+    }
+
+    void PrintfFormat::_appendLiteral(std::string& text) {
+        if (!text.empty()) {
+            Segment segment;
+            segment.text.swap(text);
+            segment.conversion = '\0';
+            _segments.push_back(segment);
+        }
+    }
+
+    const char* PrintfFormat::_parseConversion(const char* format) {
+        Segment segment;
+        segment.length = DEFAULT;
+        segment.variableWidth = false;
+        segment.variablePrecision = false;
+
+        const char* begin = format++;
+        const char* flags = format;
+        while (*format && std::strchr("-+ #0'", *format))
+            ++format;
+        std::string specification(begin, format);
+        bool plain = (format == flags);
+
+        if (*format == '*') {
+            segment.variableWidth = true;
+            specification += *format++;
+            plain = false;
+        } else {
+            const char* width = format;
+            while (isDigit(*format))
+                ++format;
+            if (*format == '$') {
+                // positional arguments cannot be taken one by one
+                _compiled = false;
+                return format;
+            }
+            specification.append(width, format);
+            plain = plain && (format == width);
+        }
+
+        if (*format == '.') {
+            specification += *format++;
+            plain = false;
+            if (*format == '*') {
+                segment.variablePrecision = true;
+                specification += *format++;
+            } else {
+                while (isDigit(*format))
+                    specification += *format++;
+            }
+        }
+
+        switch (*format) {
+            case 'h':
+                segment.length = (format[1] == 'h') ? CHAR : SHORT;
+                format += (format[1] == 'h') ? 2 : 1;
+                break;
+            case 'l':
+                segment.length = (format[1] == 'l') ? LONG_LONG : LONG;
+                format += (format[1] == 'l') ? 2 : 1;
+                break;
+            case 'q': segment.length = LONG_LONG; ++format; break;
+            case 'j': segment.length = INTMAX; ++format; break;
+            case 'z':
+            case 'Z': segment.length = SIZE; ++format; break;
+            case 't': segment.length = PTRDIFF; ++format; break;
+            case 'L': segment.length = LONG_DOUBLE; ++format; break;
+            default: break;
+        }
+
+        segment.conversion = *format;
+        switch (segment.conversion) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                // integers are passed on as long long
+                specification += "ll";
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (segment.length == LONG_DOUBLE)
+                    specification += 'L';
+                else if (segment.length != DEFAULT && segment.length != LONG)
+                    _compiled = false;
+                break;
+            case 'c':
+            case 's':
+            case 'p':
+                // wide characters are left to vsnprintf
+                if (segment.length != DEFAULT)
+                    _compiled = false;
+                break;
+            default:
+                // %n, %m, and whatever else vsnprintf may know
+                _compiled = false;
+                break;
+        }
+
+        if (_compiled) {
+            specification += *format++;
+            segment.text = specification;
+            segment.plain = plain;
+            _segments.push_back(segment);
+        }
+        return format;
+    }
+
+    void PrintfFormat::format(FormatBuffer& buffer, va_list arguments) const {
+        if (!_compiled) {
+            buffer.appendVprintf(_format.c_str(), arguments);
+            return;
+        }
+
+        for (std::vector<Segment>::const_iterator i = _segments.begin(); i != _segments.end(); ++i) {
+            const Segment& segment = *i;
+            if (!segment.conversion) {
+                buffer.append(segment.text);
+                continue;
+            }
+
+            int width = 0;
+            int precision = 0;
+            if (segment.variableWidth)
+                width = va_arg(arguments, int);
+            if (segment.variablePrecision)
+                precision = va_arg(arguments, int);
+
+            // the arguments in the order the conversion takes them
+            const char* specification = segment.text.c_str();
+            const bool both = segment.variableWidth && segment.variablePrecision;
+            const bool one = segment.variableWidth || segment.variablePrecision;
+            const int variable = segment.variableWidth ? width : precision;
+
+#define LOG4CPP_APPEND_CONVERSION(value) \
+            if (both) \
+                appendPrintf(buffer, specification, width, precision, value); \
+            else if (one) \
+                appendPrintf(buffer, specification, variable, value); \
+            else \
+                appendPrintf(buffer, specification, value);
+
+            switch (segment.conversion) {
+                case 'd':
+                case 'i': {
+                    long long value;
+                    switch (segment.length) {
+                        case CHAR: value = static_cast<signed char>(va_arg(arguments, int)); break;
+                        case SHORT: value = static_cast<short>(va_arg(arguments, int)); break;
+                        case LONG: value = va_arg(arguments, long); break;
+                        case LONG_LONG: value = va_arg(arguments, long long); break;
+                        case INTMAX: value = va_arg(arguments, intmax_t); break;
+                        case SIZE: value = static_cast<long long>(va_arg(arguments, size_t)); break;
+                        case PTRDIFF: value = va_arg(arguments, ptrdiff_t); break;
+                        default: value = va_arg(arguments, int); break;
+                    }
+                    if (segment.plain) {
+                        buffer.appendInteger(value);
+                    } else {
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    }
+                    break;
+                }
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X': {
+                    unsigned long long value;
+                    switch (segment.length) {
+                        case CHAR: value = static_cast<unsigned char>(va_arg(arguments, unsigned int)); break;
+                        case SHORT: value = static_cast<unsigned short>(va_arg(arguments, unsigned int)); break;
+                        case LONG: value = va_arg(arguments, unsigned long); break;
+                        case LONG_LONG: value = va_arg(arguments, unsigned long long); break;
+                        case INTMAX: value = va_arg(arguments, uintmax_t); break;
+                        case SIZE: value = va_arg(arguments, size_t); break;
+                        case PTRDIFF: value = static_cast<unsigned long long>(va_arg(arguments, ptrdiff_t)); break;
+                        default: value = va_arg(arguments, unsigned int); break;
+                    }
+                    if (segment.plain && segment.conversion == 'u') {
+                        buffer.appendUnsigned(value);
+                    } else {
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    }
+                    break;
+                }
+                case 'c': {
+                    const int value = va_arg(arguments, int);
+                    if (segment.plain) {
+                        buffer.append(static_cast<char>(value));
+                    } else {
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    }
+                    break;
+                }
+                case 's': {
+                    const char* value = va_arg(arguments, const char*);
+                    if (segment.plain) {
+                        buffer.append(value);
+                    } else {
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    }
+                    break;
+                }
+                case 'p': {
+                    void* value = va_arg(arguments, void*);
+                    LOG4CPP_APPEND_CONVERSION(value)
+                    break;
+                }
+                default: {
+                    if (segment.length == LONG_DOUBLE) {
+                        const long double value = va_arg(arguments, long double);
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    } else {
+                        const double value = va_arg(arguments, double);
+                        LOG4CPP_APPEND_CONVERSION(value)
+                    }
+                    break;
+                }
+            }
+
+#undef LOG4CPP_APPEND_CONVERSION
+        }
+    }
+}
@@ -40,6 +40,15 @@
 #ifdef LOG4CPP_HAVE_SYSLOG
 #include <log4cpp/SyslogAppender.hh>
 #endif
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+#include <log4cpp/JournaldAppender.hh>
+#include <log4cpp/SocketEventAppender.hh>
+#include <log4cpp/HttpBulkAppender.hh>
+#include <log4cpp/GelfAppender.hh>
+#endif
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+#include <log4cpp/ShmRingAppender.hh>
+#endif
 
 // layouts
 #include <log4cpp/Layout.hh>
@@ -64,6 +73,13 @@ namespace log4cpp {
     }
 
     PropertyConfiguratorImpl::~PropertyConfiguratorImpl() {
+        releaseLayouts();
+    }
+
+    void PropertyConfiguratorImpl::releaseLayouts() {
+        for (LayoutMap::iterator i = _layouts.begin(); i != _layouts.end(); ++i)
+            (*i).second->release();
+        _layouts.clear();
     }
 
     void PropertyConfiguratorImpl::doConfigure(const std::string& initFileName) {
@@ -91,6 +107,9 @@ namespace log4cpp {
             iter != catList.end(); ++iter) {
             configureCategory(*iter);
         }
+
+        // appenders keep the layouts they share
+        releaseLayouts();
     }
 
     void PropertyConfiguratorImpl::instantiateAllAppenders() {
@@ -256,6 +275,64 @@ namespace log4cpp {
             appender = new SyslogAppender(appenderName, syslogName, facility);
         }
 #endif // LOG4CPP_HAVE_SYSLOG
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+        else if (appenderType == "JournaldAppender") {
+            std::string identifier = _properties.getString(appenderPrefix + ".identifier", appenderName.c_str());
+            std::string socketPath = _properties.getString(appenderPrefix + ".socketPath",
+                                                           JournaldAppender::DEFAULT_SOCKET_PATH);
+            appender = new JournaldAppender(appenderName, identifier, socketPath);
+        }
+        else if (appenderType == "SocketEventAppender") {
+            std::string address = _properties.getString(appenderPrefix + ".address", "");
+            std::string compression = _properties.getString(appenderPrefix + ".compression", "none");
+            size_t batchSize = _properties.getInt(appenderPrefix + ".batchSize",
+                                                  SocketEventAppender::DEFAULT_BATCH_SIZE);
+            SocketEventAppender* socketAppender =
+                new SocketEventAppender(appenderName, address,
+                                        (compression == "zlib") ? EventCodec::ZLIB : EventCodec::NONE,
+                                        batchSize);
+            socketAppender->setBatchDelay(_properties.getInt(appenderPrefix + ".batchDelay",
+                                                             SocketEventAppender::DEFAULT_BATCH_DELAY));
+            appender = socketAppender;
+        }
+        else if (appenderType == "HttpBulkAppender") {
+            std::string url = _properties.getString(appenderPrefix + ".url", "");
+            std::string format = _properties.getString(appenderPrefix + ".format", "ndjson");
+            size_t batchSize = _properties.getInt(appenderPrefix + ".batchSize",
+                                                  HttpBulkAppender::DEFAULT_BATCH_SIZE);
+            unsigned int batchDelay = _properties.getInt(appenderPrefix + ".batchDelay",
+                                                         HttpBulkAppender::DEFAULT_BATCH_DELAY);
+            size_t budget = _properties.getInt(appenderPrefix + ".budget",
+                                               HttpBulkAppender::DEFAULT_BUDGET);
+            HttpBulkAppender* httpAppender = new HttpBulkAppender(appenderName, url,
+                                                                  (format == "json") ? HttpBulkAppender::JSON_ARRAY : HttpBulkAppender::NDJSON,
+                                                                  batchSize, batchDelay, budget);
+            httpAppender->setActionLine(_properties.getString(appenderPrefix + ".actionLine", ""));
+            httpAppender->setGzip(_properties.getBool(appenderPrefix + ".gzip", false));
+            appender = httpAppender;
+        }
+        else if (appenderType == "GelfAppender") {
+            std::string host = _properties.getString(appenderPrefix + ".host", "localhost");
+            int port = _properties.getInt(appenderPrefix + ".port", GelfAppender::DEFAULT_PORT);
+            std::string transport = _properties.getString(appenderPrefix + ".transport", "udp");
+            std::string compression = _properties.getString(appenderPrefix + ".compression", "none");
+            size_t chunkSize = _properties.getInt(appenderPrefix + ".chunkSize",
+                                                  GelfAppender::DEFAULT_CHUNK_SIZE);
+            appender = new GelfAppender(appenderName, host, port,
+                                        (transport == "tcp") ? GelfAppender::TCP : GelfAppender::UDP,
+                                        (compression == "gzip") ? GelfAppender::GZIP :
+                                        (compression == "zlib") ? GelfAppender::ZLIB : GelfAppender::NONE,
+                                        chunkSize);
+        }
+#endif // LOG4CPP_HAVE_SYS_UN_H
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+        else if (appenderType == "ShmRingAppender") {
+            std::string path = _properties.getString(appenderPrefix + ".path", "");
+            size_t capacity = _properties.getInt(appenderPrefix + ".capacity",
+                                                 ShmRingAppender::DEFAULT_CAPACITY);
+            appender = new ShmRingAppender(appenderName, path, capacity);
+        }
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
         else if (appenderType == "AbortAppender") {
             appender = new AbortAppender(appenderName);
         }
@@ -317,6 +394,20 @@ namespace log4cpp {
         std::string layoutType = (length == std::string::npos) ? 
             (*key).second : (*key).second.substr(length+1);
  
+        // appenders with the same layout share it, which formats each
+        // event once for all of them
+        std::string layoutKey = layoutType;
+        Properties::iterator pattern =
+            _properties.find(std::string("appender.") + appenderName + ".layout.ConversionPattern");
+        if (layoutType == "PatternLayout" && pattern != _properties.end())
+            layoutKey += "\n" + (*pattern).second;
+
+        LayoutMap::iterator shared = _layouts.find(layoutKey);
+        if (shared != _layouts.end()) {
+            appender->setLayout((*shared).second->share());
+            return;
+        }
+
         Layout* layout;
         // and instantiate the appropriate object
         if (layoutType == "BasicLayout") {
@@ -329,12 +420,11 @@ namespace log4cpp {
             // need to read the properties to configure this one
             PatternLayout* patternLayout = new PatternLayout();
 
-            key = _properties.find(std::string("appender.") + appenderName + ".layout.ConversionPattern");
-            if (key == _properties.end()) {
+            if (pattern == _properties.end()) {
                 // leave default pattern
             } else {
                 // set pattern
-                patternLayout->setConversionPattern((*key).second);
+                patternLayout->setConversionPattern((*pattern).second);
             }
 
             layout = patternLayout;
@@ -344,6 +434,7 @@ namespace log4cpp {
                                                "' for appender '") + appenderName + "'");
         }
 
+        _layouts[layoutKey] = layout->share();
         appender->setLayout(layout);
     }
 
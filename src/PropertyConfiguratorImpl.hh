@@ -25,6 +25,7 @@ namespace log4cpp {
     class PropertyConfiguratorImpl {
         public:
         typedef std::map<std::string, Appender*> AppenderMap;
+        typedef std::map<std::string, Layout*> LayoutMap;
 
         PropertyConfiguratorImpl();
         virtual ~PropertyConfiguratorImpl();
@@ -87,8 +88,15 @@ namespace log4cpp {
          */
         void setLayout(Appender* appender, const std::string& name);
 
+        /**
+         * Drops the references to the layouts configured so far, which
+         * appenders with the same layout share.
+         */
+        void releaseLayouts();
+
         Properties _properties;
         AppenderMap _allAppenders;
+        LayoutMap _layouts;
     };
 }
 
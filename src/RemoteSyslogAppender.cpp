@@ -138,6 +138,10 @@ namespace log4cpp {
         }
     }
 
+    unsigned int RemoteSyslogAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void RemoteSyslogAppender::_append(const LoggingEvent& event) {
         const std::string message(_getLayout().format(event));
         size_t messageLength = message.length();
@@ -83,6 +83,16 @@ namespace log4cpp {
 
     void RollingFileAppender::_append(const LoggingEvent& event) {
         FileAppender::_append(event);
+        _rollOverIfFull();
+    }
+
+    void RollingFileAppender::_appendBatch(const LoggingEvent* const* events, size_t count) {
+        // a batch is not split across files
+        FileAppender::_appendBatch(events, count);
+        _rollOverIfFull();
+    }
+
+    void RollingFileAppender::_rollOverIfFull() {
         off_t offset = ::lseek(_fd, 0, SEEK_END);
         if (offset < 0) {
             // XXX we got an error, ignore for now
@@ -0,0 +1,341 @@
+/*
+ * SenderThread.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include "SenderThread.hh"
+#include "ConditionClock.hh"
+#include <cerrno>
+#include <ctime>
+
+namespace log4cpp {
+
+    namespace {
+        const unsigned int INITIAL_BACKOFF = 100;       // milliseconds
+        const unsigned int MAX_BACKOFF = 30000;
+    }
+
+    using condition_clock::now;
+
+    SenderThread::SenderThread(ConnectFunction connect, SendFunction send, void* context,
+                               size_t batchSize, unsigned int batchDelay, size_t budget) :
+        _connect(connect),
+        _send(send),
+        _context(context),
+        _batchSize(batchSize),
+        _budget(budget),
+        _batchDelay(batchDelay),
+        _bytes(0),
+        _evictedBytes(0),
+        _batchTime(0),
+        _urgent(false),
+        _stopping(false),
+        _waiting(false),
+        _sending(false),
+        _flushRequests(0),
+        _flushes(0),
+        _dropped(0),
+        _connected(false),
+        _retryTime(0),
+        _backoff(INITIAL_BACKOFF) {
+#ifdef LOG4CPP_USE_PTHREADS
+        ::pthread_mutex_init(&_mutex, NULL);
+        ::pthread_cond_init(&_condition, NULL);
+        _threadStarted = false;
+#endif
+    }
+
+    SenderThread::~SenderThread() {
+        stop();
+#ifdef LOG4CPP_USE_PTHREADS
+        ::pthread_cond_destroy(&_condition);
+        ::pthread_mutex_destroy(&_mutex);
+#endif
+    }
+
+    void SenderThread::_lock() {
+#ifdef LOG4CPP_USE_PTHREADS
+        ::pthread_mutex_lock(&_mutex);
+#endif
+    }
+
+    void SenderThread::_unlock() {
+#ifdef LOG4CPP_USE_PTHREADS
+        ::pthread_mutex_unlock(&_mutex);
+#endif
+    }
+
+    void SenderThread::_signal() {
+#ifdef LOG4CPP_USE_PTHREADS
+        // the sending thread and flush() wait on the same condition
+        ::pthread_cond_broadcast(&_condition);
+#endif
+    }
+
+    void SenderThread::start() {
+        _lock();
+        _stopping = false;
+#ifdef LOG4CPP_USE_PTHREADS
+        if (!_threadStarted)
+            _threadStarted = (::pthread_create(&_thread, NULL, &_threadMain, this) == 0);
+#endif
+        _unlock();
+    }
+
+    void SenderThread::stop() {
+        _lock();
+        _stopping = true;
+#ifdef LOG4CPP_USE_PTHREADS
+        if (_threadStarted) {
+            _signal();
+            _unlock();
+            ::pthread_join(_thread, NULL);
+            _lock();
+            _threadStarted = false;
+        }
+#endif
+        _run(false);
+        _connected = false;
+        _unlock();
+    }
+
+    bool SenderThread::append(const char* data, size_t size, bool urgent, int priority) {
+        _lock();
+        // over budget: make room by dropping less important records
+        while (size <= _budget && _bytes + size > _budget && !_byPriority.empty()) {
+            std::map<int, std::vector<size_t> >::iterator worst = --_byPriority.end();
+            if (worst->first <= priority)
+                break;
+
+            const size_t victim = worst->second.back();
+            worst->second.pop_back();
+            if (worst->second.empty())
+                _byPriority.erase(worst);
+            _evicted[victim] = true;
+            _bytes -= _sizes[victim];
+            _evictedBytes += _sizes[victim];
+            _dropped++;
+        }
+
+        if (_bytes + size > _budget) {
+            _dropped++;
+            _unlock();
+            return false;
+        }
+
+        // evicted records take memory until sent, bound it
+        if (_evictedBytes > _budget)
+            _compact();
+
+        if (_sizes.empty())
+            _batchTime = now();
+        _byPriority[priority].push_back(_sizes.size());
+        _records.append(data, size);
+        _sizes.push_back(size);
+        _priorities.push_back(priority);
+        _evicted.push_back(false);
+        _bytes += size;
+        _urgent = _urgent || urgent;
+
+#ifdef LOG4CPP_USE_PTHREADS
+        if (_threadStarted) {
+            // wake the sender to send, or to start timing the batch
+            if (_waiting && (_sizes.size() == 1 || _urgent || _bytes >= _batchSize))
+                _signal();
+            _unlock();
+            return true;
+        }
+#endif
+        _run(false);
+        _unlock();
+        return true;
+    }
+
+    bool SenderThread::flush() {
+        _lock();
+        const unsigned long dropped = _dropped;
+        const unsigned long request = ++_flushRequests;
+#ifdef LOG4CPP_USE_PTHREADS
+        if (_threadStarted) {
+            _signal();
+            while (_threadStarted && _flushes < request)
+                ::pthread_cond_wait(&_condition, &_mutex);
+        } else {
+            _run(false);
+        }
+#else
+        _run(false);
+#endif
+        const bool result = (_dropped == dropped);
+        _unlock();
+        return result;
+    }
+
+    void SenderThread::setBatchDelay(unsigned int batchDelay) {
+        _lock();
+        _batchDelay = batchDelay;
+        _signal();
+        _unlock();
+    }
+
+    bool SenderThread::pause(unsigned int milliseconds) {
+#ifdef LOG4CPP_USE_PTHREADS
+        _lock();
+        const long long deadline = now() + milliseconds;
+        const struct timespec timeout = condition_clock::toTimespec(deadline);
+        while (_threadStarted && !_stopping && now() < deadline &&
+               ::pthread_cond_timedwait(&_condition, &_mutex, &timeout) != ETIMEDOUT) {
+        }
+        const bool result = _threadStarted && !_stopping;
+        _unlock();
+        return result;
+#else
+        return false;
+#endif
+    }
+
+    unsigned long SenderThread::getDropped() {
+        _lock();
+        unsigned long dropped = _dropped;
+        _unlock();
+        return dropped;
+    }
+
+    bool SenderThread::_batchReady(long long time) const {
+        return !_sizes.empty() &&
+               (_stopping || _urgent || _bytes >= _batchSize ||
+                time - _batchTime >= _batchDelay);
+    }
+
+    /* assume lock is held */
+    void SenderThread::_compact() {
+        size_t from = 0;
+        size_t to = 0;
+        size_t kept = 0;
+        _byPriority.clear();
+        for (size_t i = 0; i < _sizes.size(); i++) {
+            const size_t size = _sizes[i];
+            if (!_evicted[i]) {
+                if (to != from)
+                    _records.replace(to, size, _records, from, size);
+                _sizes[kept] = size;
+                _priorities[kept] = _priorities[i];
+                _byPriority[_priorities[kept]].push_back(kept);
+                to += size;
+                kept++;
+            }
+            from += size;
+        }
+        _records.resize(to);
+        _sizes.resize(kept);
+        _priorities.resize(kept);
+        _evicted.assign(kept, false);
+        _evictedBytes = 0;
+    }
+
+#ifdef LOG4CPP_USE_PTHREADS
+    void* SenderThread::_threadMain(void* sender) {
+        SenderThread* thread = static_cast<SenderThread*>(sender);
+        thread->_lock();
+        thread->_run(true);
+        thread->_unlock();
+        return NULL;
+    }
+#endif
+
+    /* assume lock is held */
+    void SenderThread::_run(bool background) {
+        if (background && !_connected) {
+            // connect ahead of the first batch
+            _unlock();
+            _connected = _connect(_context);
+            if (!_connected)
+                _retryTime = now() + _backoff;
+            _lock();
+        }
+
+        for (;;) {
+            // without the thread, whoever sends first sends for all
+            if (_sending)
+                break;
+
+            const long long time = now();
+            const bool flushing = (_flushes != _flushRequests);
+            if (!_sizes.empty() && (flushing || _batchReady(time))) {
+                const unsigned long requests = _flushRequests;
+                _sendBatch(time);
+                if (flushing) {
+                    _flushes = requests;
+                    _signal();
+                }
+                continue;
+            }
+
+            if (flushing) {
+                _flushes = _flushRequests;
+                _signal();
+            }
+
+#ifdef LOG4CPP_USE_PTHREADS
+            if (!background || _stopping)
+                break;
+
+            _waiting = true;
+            if (_sizes.empty()) {
+                ::pthread_cond_wait(&_condition, &_mutex);
+            } else {
+                const struct timespec timeout = condition_clock::toTimespec(_batchTime + _batchDelay);
+                ::pthread_cond_timedwait(&_condition, &_mutex, &timeout);
+            }
+            _waiting = false;
+#else
+            break;
+#endif
+        }
+    }
+
+    /* assume lock is held, releases it while sending */
+    void SenderThread::_sendBatch(long long time) {
+        if (_evictedBytes)
+            _compact();
+        _batch.swap(_records);
+        _batchSizes.swap(_sizes);
+        _priorities.clear();
+        _evicted.clear();
+        _byPriority.clear();
+        _bytes = 0;
+        _urgent = false;
+        _sending = true;
+        _unlock();
+
+        if (!_connected && time >= _retryTime) {
+            _connected = _connect(_context);
+            if (_connected) {
+                _backoff = INITIAL_BACKOFF;
+            }
+        }
+
+        size_t dropped = _batchSizes.size();
+        if (_connected) {
+            dropped = _send(_context, _batch, _batchSizes, _connected);
+        }
+        if (!_connected && time >= _retryTime) {
+            _retryTime = now() + _backoff;
+            _backoff = (_backoff * 2 > MAX_BACKOFF) ? MAX_BACKOFF : _backoff * 2;
+        }
+        _batch.clear();
+        _batchSizes.clear();
+
+        _lock();
+        _sending = false;
+        _dropped += dropped;
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
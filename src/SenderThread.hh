@@ -0,0 +1,151 @@
+/*
+ * SenderThread.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SENDERTHREAD_HH
+#define _LOG4CPP_SENDERTHREAD_HH
+
+#include "PortabilityImpl.hh"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace log4cpp {
+
+    /*
+     * Sends records the socket appenders queue from a background thread, so that
+     * resolving, connecting and sending never block the logging threads
+     * (synchronously where threads are not available).
+     *
+     * Records are collected into batches, which are sent once they reach
+     * the batch size, when an urgent record is queued, when the oldest
+     * record waited for the batch delay, on flush() and on stop(). Queued
+     * records are bounded by a budget in bytes. To make room, records of
+     * a lower priority (a higher value, as of Priority::Value) are
+     * dropped, the most recent first; a record finding none is dropped
+     * itself. While not connected, connecting is retried with an
+     * exponential backoff and the batches ready meanwhile are dropped.
+     */
+    class SenderThread {
+        public:
+        /*
+         * Connects, on the sending thread.
+         * @returns whether connected.
+         */
+        typedef bool (*ConnectFunction)(void* context);
+
+        /*
+         * Sends a batch of records, concatenated in records, on the
+         * sending thread.
+         * @param connected set to false if the connection broke.
+         * @returns the number of records which could not be sent.
+         */
+        typedef size_t (*SendFunction)(void* context, const std::string& records,
+                                       const std::vector<size_t>& sizes, bool& connected);
+
+        SenderThread(ConnectFunction connect, SendFunction send, void* context,
+                     size_t batchSize, unsigned int batchDelay, size_t budget);
+        ~SenderThread();
+
+        /*
+         * Starts the thread, which connects ahead of the first batch.
+         */
+        void start();
+
+        /*
+         * Sends the queued records and stops the thread. The context
+         * may disconnect then; start() connects again.
+         */
+        void stop();
+
+        /*
+         * Queues a record.
+         * @returns false if it was dropped for exceeding the budget.
+         */
+        bool append(const char* data, size_t size, bool urgent, int priority = 0);
+
+        /*
+         * Sends the queued records and waits until they are sent.
+         * @returns false if some were dropped.
+         */
+        bool flush();
+
+        void setBatchDelay(unsigned int batchDelay);
+
+        /*
+         * Waits on the sending thread, e.g. before retrying a batch, until
+         * the time passed or stop() is called.
+         * @returns false if stopping, or sending without the thread.
+         */
+        bool pause(unsigned int milliseconds);
+
+        /*
+         * @returns the number of records dropped.
+         */
+        unsigned long getDropped();
+
+        private:
+        SenderThread(const SenderThread& other);
+        SenderThread& operator=(const SenderThread& other);
+
+        void _lock();
+        void _unlock();
+        void _signal();
+        bool _batchReady(long long now) const;
+        void _compact();
+        void _run(bool background);
+        void _sendBatch(long long now);
+#ifdef LOG4CPP_USE_PTHREADS
+        static void* _threadMain(void* sender);
+#endif
+
+        const ConnectFunction _connect;
+        const SendFunction _send;
+        void* const _context;
+        const size_t _batchSize;
+        const size_t _budget;
+
+        // guarded by the mutex
+        unsigned int _batchDelay;
+        std::string _records;
+        std::vector<size_t> _sizes;
+        std::vector<int> _priorities;
+        std::vector<bool> _evicted;
+        // the records kept by priority, most recent last
+        std::map<int, std::vector<size_t> > _byPriority;
+        size_t _bytes;              // of the records kept
+        size_t _evictedBytes;
+        long long _batchTime;
+        bool _urgent;
+        bool _stopping;
+        bool _waiting;
+        bool _sending;
+        unsigned long _flushRequests;
+        unsigned long _flushes;
+        unsigned long _dropped;
+
+        // used by the sending thread only
+        std::string _batch;
+        std::vector<size_t> _batchSizes;
+        bool _connected;
+        long long _retryTime;
+        unsigned int _backoff;
+
+#ifdef LOG4CPP_USE_PTHREADS
+        pthread_mutex_t _mutex;
+        pthread_cond_t _condition;
+        pthread_t _thread;
+        bool _threadStarted;
+#endif
+    };
+}
+
+#endif // _LOG4CPP_SENDERTHREAD_HH
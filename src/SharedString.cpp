@@ -0,0 +1,167 @@
+/*
+ * SharedString.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/SharedString.hh>
+#include <log4cpp/Allocator.hh>
+#include "Pool.hh"
+#include <cstring>
+
+namespace log4cpp {
+
+    namespace {
+        /**
+         * A thread keeps at most maxCachedReps released Reps, of at most
+         * maxRecycledCapacity characters each.
+         **/
+        const size_t maxCachedReps = 256;
+        const size_t maxRecycledCapacity = 4096;
+
+        /**
+         * The characters a std::string holds without allocating.
+         **/
+        size_t inlineCapacity() {
+            static const size_t capacity = std::string().capacity();
+            return capacity;
+        }
+
+        void assign(std::string& value, const char* characters, size_t length) {
+            const size_t capacity = value.capacity();
+            value.assign(characters, length);
+            if (value.capacity() != capacity)
+                pool::countSystemAllocation(value.capacity() + 1);
+        }
+    }
+
+    class SharedString::RepCache {
+        public:
+        RepCache() :
+            free(NULL),
+            count(0) {
+        }
+
+        void release(Rep* rep) {
+            if (count < maxCachedReps) {
+                rep->next = free;
+                free = rep;
+                ++count;
+            } else {
+                delete rep;
+            }
+        }
+
+        /**
+         * Takes the Reps other threads released.
+         **/
+        void takeRemote() {
+            for (Rep* rep = remote.takeAll(); rep; ) {
+                Rep* next = rep->next;
+                release(rep);
+                rep = next;
+            }
+        }
+
+        Rep* free;
+        size_t count;
+        pool::RemoteList<Rep> remote;
+    };
+
+    void* SharedString::Rep::operator new(size_t size) {
+        return Allocator::allocateBlock(size);
+    }
+
+    void SharedString::Rep::operator delete(void* rep, size_t size) {
+        Allocator::deallocateBlock(rep, size);
+    }
+
+    SharedString::Rep* SharedString::_acquire(size_t length) {
+        RepCache& cache = pool::ThreadCaches<RepCache>::get();
+        if (length > inlineCapacity()) {
+            if (!cache.free)
+                cache.takeRemote();
+
+            Rep* rep = cache.free;
+            if (rep) {
+                cache.free = rep->next;
+                --cache.count;
+                rep->references.store(1);
+                return rep;
+            }
+        }
+
+        Rep* rep = new Rep();
+        rep->cache = &cache;
+        return rep;
+    }
+
+    void SharedString::_recycle(Rep* rep) {
+        // only characters on the heap are worth keeping
+        const size_t capacity = rep->value.capacity();
+        if (capacity <= inlineCapacity() || capacity > maxRecycledCapacity) {
+            delete rep;
+            return;
+        }
+
+        RepCache& cache = pool::ThreadCaches<RepCache>::get();
+        RepCache* owner = static_cast<RepCache*>(rep->cache);
+        if (owner == &cache)
+            cache.release(rep);
+        else
+            owner->remote.push(rep);
+    }
+
+    SharedString::SharedString(const std::string& value) :
+        _rep(0) {
+        if (!value.empty()) {
+            _rep = _acquire(value.size());
+            assign(_rep->value, value.data(), value.size());
+        }
+    }
+
+    SharedString::SharedString(const char* value) :
+        _rep(0) {
+        const size_t length = value ? std::strlen(value) : 0;
+        if (length) {
+            _rep = _acquire(length);
+            assign(_rep->value, value, length);
+        }
+    }
+
+    SharedString::SharedString(const char* characters, size_t length) :
+        _rep(0) {
+        if (length) {
+            _rep = _acquire(length);
+            assign(_rep->value, characters, length);
+        }
+    }
+
+    SharedString& SharedString::operator=(const SharedString& other) {
+        if (_rep != other._rep) {
+            if (other._rep)
+                other._rep->references.fetchAdd(1);
+            _release();
+            _rep = other._rep;
+        }
+        return *this;
+    }
+
+    SharedString SharedString::adopt(std::string& value) {
+        SharedString result;
+        if (!value.empty()) {
+            // takes the characters, so needs none of its own
+            result._rep = _acquire(0);
+            result._rep->value.swap(value);
+        }
+        return result;
+    }
+
+    const std::string& SharedString::emptyString() {
+        static const std::string empty;
+        return empty;
+    }
+}
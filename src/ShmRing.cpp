@@ -0,0 +1,83 @@
+/*
+ * ShmRing.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "ShmRing.hh"
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <sys/mman.h>
+#include <ctime>
+#include <cerrno>
+#ifdef LOG4CPP_HAVE_LINUX_FUTEX_H
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace log4cpp {
+    namespace shmring {
+
+        Header* map(int fd, size_t size) {
+            void* address = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED)
+                return NULL;
+
+            return static_cast<Header*>(address);
+        }
+
+        void unmap(Header* header) {
+            if (header) {
+                ::munmap(header, sizeof(Header) + header->capacity);
+            }
+        }
+
+        void ringDoorbell(Header* header) {
+            __atomic_add_fetch(&header->doorbell, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&header->waiting, __ATOMIC_SEQ_CST)) {
+#ifdef LOG4CPP_HAVE_LINUX_FUTEX_H
+                // the segment is shared between processes: no FUTEX_PRIVATE_FLAG
+                ::syscall(SYS_futex, &header->doorbell, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+            }
+        }
+
+        static bool available(Header* header) {
+            return loadAcquire(&header->head) != loadAcquire(&header->tail);
+        }
+
+        bool waitDoorbell(Header* header, int timeoutMilliseconds) {
+            __atomic_store_n(&header->waiting, 1, __ATOMIC_SEQ_CST);
+            uint32_t doorbell = __atomic_load_n(&header->doorbell, __ATOMIC_SEQ_CST);
+
+            if (!available(header) && timeoutMilliseconds > 0) {
+                struct timespec timeout;
+                timeout.tv_sec = timeoutMilliseconds / 1000;
+                timeout.tv_nsec = (timeoutMilliseconds % 1000) * 1000000L;
+#ifdef LOG4CPP_HAVE_LINUX_FUTEX_H
+                // returns immediately if the doorbell was rung since it was read
+                ::syscall(SYS_futex, &header->doorbell, FUTEX_WAIT, doorbell, &timeout, NULL, 0);
+#else
+                // no futex: poll the doorbell
+                struct timespec interval = { 0, 1000000L };
+                long remaining = timeoutMilliseconds;
+                while (remaining > 0 &&
+                       __atomic_load_n(&header->doorbell, __ATOMIC_SEQ_CST) == doorbell) {
+                    ::nanosleep(&interval, NULL);
+                    remaining--;
+                }
+#endif
+            }
+
+            __atomic_store_n(&header->waiting, 0, __ATOMIC_SEQ_CST);
+            return available(header);
+        }
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
@@ -0,0 +1,114 @@
+/*
+ * ShmRing.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_SHMRING_HH
+#define _LOG4CPP_SHMRING_HH
+
+#include "PortabilityImpl.hh"
+
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace log4cpp {
+    namespace shmring {
+
+        /*
+         * Layout of the shared memory segment used by ShmRingAppender and
+         * ShmRingReader: a 256 byte Header followed by 'capacity' bytes of
+         * frame data. The producer owns 'head', the consumer owns 'tail';
+         * both are free running byte counters, the offset in the data area
+         * is counter & (capacity - 1).
+         *
+         * A frame is a FrameHeader followed by the 'length' bytes of the
+         * message, the 'categoryLength' bytes of the category name and the
+         * 'threadLength' bytes of the thread name, padded to a multiple
+         * of 8. 'timeStamp' is the time the event was made at, in
+         * nanoseconds since the epoch. A frame never wraps around the end of
+         * the data area; the producer writes a WRAP marker instead and
+         * continues at offset 0.
+         *
+         * The capacity is a power of two of at least MIN_CAPACITY.
+         */
+
+        const uint32_t MAGIC = 0x4c344352; // "L4CR"
+        const uint32_t VERSION = 3;
+        const uint32_t WRAP = 0xffffffffu;
+        const size_t MIN_CAPACITY = 4096;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t capacity;
+            char pad0[48];
+            uint64_t head;          // written by the producer
+            char pad1[56];
+            uint64_t tail;          // written by the consumer
+            char pad2[56];
+            uint64_t dropped;       // frames dropped because the ring was full
+            uint32_t doorbell;      // futex word, bumped for each frame
+            uint32_t waiting;       // non zero while the consumer sleeps
+            char pad3[48];
+        };
+
+        struct FrameHeader {
+            uint32_t length;
+            int32_t priority;
+            uint32_t categoryLength;
+            uint32_t threadLength;
+            int64_t timeStamp;
+        };
+
+        inline size_t frameSize(size_t payloadLength) {
+            return (sizeof(FrameHeader) + payloadLength + 7) & ~static_cast<size_t>(7);
+        }
+
+        inline bool isValidCapacity(uint64_t capacity) {
+            return capacity >= MIN_CAPACITY && (capacity & (capacity - 1)) == 0;
+        }
+
+        inline char* data(Header* header) {
+            return reinterpret_cast<char*>(header) + sizeof(Header);
+        }
+
+        inline uint64_t loadAcquire(const uint64_t* p) {
+            return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+        }
+
+        inline void storeRelease(uint64_t* p, uint64_t value) {
+            __atomic_store_n(p, value, __ATOMIC_RELEASE);
+        }
+
+        /**
+           Maps an already sized segment.
+           @returns the header or NULL on failure.
+        **/
+        Header* map(int fd, size_t size);
+
+        /**
+           Unmaps a segment mapped by map().
+        **/
+        void unmap(Header* header);
+
+        /**
+           Wakes a consumer sleeping in waitDoorbell().
+        **/
+        void ringDoorbell(Header* header);
+
+        /**
+           Sleeps until a producer rings the doorbell or the timeout
+           (in milliseconds) expires.
+           @returns true if frames are available.
+        **/
+        bool waitDoorbell(Header* header, int timeoutMilliseconds);
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
+#endif // _LOG4CPP_SHMRING_HH
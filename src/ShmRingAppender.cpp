@@ -0,0 +1,183 @@
+/*
+ * ShmRingAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <cstring>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <log4cpp/ShmRingAppender.hh>
+#include <log4cpp/PassThroughLayout.hh>
+#include <log4cpp/FactoryParams.hh>
+#include "ShmRing.hh"
+#include <memory>
+
+namespace log4cpp {
+
+    const size_t ShmRingAppender::DEFAULT_CAPACITY = 1024 * 1024;
+
+    ShmRingAppender::ShmRingAppender(const std::string& name,
+                                     const std::string& path,
+                                     size_t capacity) :
+        LayoutAppender(name),
+        _path(path),
+        _capacity(shmring::MIN_CAPACITY),
+        _fd(-1),
+        _header(NULL),
+        _dropped(0),
+        _passThrough(false) {
+        while (_capacity < capacity) {
+            _capacity <<= 1;
+        }
+        open();
+    }
+
+    ShmRingAppender::~ShmRingAppender() {
+        close();
+    }
+
+    void ShmRingAppender::open() {
+        if (_path.empty()) {
+#ifdef LOG4CPP_HAVE_MEMFD_CREATE
+            _fd = ::memfd_create("log4cpp-ring", MFD_CLOEXEC);
+#endif
+        } else {
+            _fd = ::open(_path.c_str(), O_RDWR | O_CREAT, 00660);
+            if (_fd >= 0) {
+                ::fcntl(_fd, F_SETFD, FD_CLOEXEC);
+            }
+        }
+        if (_fd < 0)
+            return;
+
+        const size_t size = sizeof(shmring::Header) + _capacity;
+        if (::ftruncate(_fd, size) < 0 || !(_header = shmring::map(_fd, size))) {
+            ::close(_fd);
+            _fd = -1;
+            return;
+        }
+
+        // resume a ring left behind by a previous producer, so that frames
+        // not yet consumed are not lost
+        if (__atomic_load_n(&_header->magic, __ATOMIC_ACQUIRE) == shmring::MAGIC &&
+            _header->version == shmring::VERSION && _header->capacity == _capacity)
+            return;
+
+        std::memset(_header, 0, sizeof(shmring::Header));
+        _header->version = shmring::VERSION;
+        _header->capacity = _capacity;
+        __atomic_store_n(&_header->magic, shmring::MAGIC, __ATOMIC_RELEASE);
+    }
+
+    void ShmRingAppender::close() {
+        if (_header) {
+            shmring::unmap(_header);
+            _header = NULL;
+        }
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    bool ShmRingAppender::reopen() {
+        if (_path.empty()) {
+            // reopening would create a new memfd the consumer does not know of
+            return _header != NULL;
+        }
+        close();
+        open();
+        return _header != NULL;
+    }
+
+    int ShmRingAppender::getFd() const {
+        return _fd;
+    }
+
+    unsigned long ShmRingAppender::getDropped() const {
+        return _dropped;
+    }
+
+    unsigned int ShmRingAppender::getRequiredFields() {
+        // frames carry the time and thread for the consumer's layout
+        return _getLayoutFields() | LoggingEvent::FIELD_TIMESTAMP | LoggingEvent::FIELD_THREAD;
+    }
+
+    void ShmRingAppender::setLayout(Layout* layout) {
+        LayoutAppender::setLayout(layout);
+        _passThrough = (dynamic_cast<PassThroughLayout*>(layout) != NULL);
+    }
+
+    void ShmRingAppender::_append(const LoggingEvent& event) {
+        if (!_header)
+            return;
+
+        if (_passThrough) {
+            // the message goes straight from the event into the frame
+            _write(event, event.message);
+        } else {
+            _write(event, _getLayout().format(event));
+        }
+    }
+
+    void ShmRingAppender::_write(const LoggingEvent& event, const std::string& message) {
+        const std::string& category = event.categoryName;
+        const std::string& thread = event.threadName;
+        const size_t size = shmring::frameSize(message.size() + category.size() + thread.size());
+        const uint64_t head = _header->head;
+        const uint64_t tail = shmring::loadAcquire(&_header->tail);
+        const size_t offset = head & (_capacity - 1);
+
+        // frames never wrap: skip the rest of the data area if necessary
+        const size_t skip = (size > _capacity - offset) ? _capacity - offset : 0;
+        if (size > _capacity || head + skip + size - tail > _capacity) {
+            _dropped++;
+            __atomic_add_fetch(&_header->dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+
+        char* data = shmring::data(_header);
+        shmring::FrameHeader* frame;
+        if (skip) {
+            frame = reinterpret_cast<shmring::FrameHeader*>(data + offset);
+            frame->length = shmring::WRAP;
+            frame->priority = 0;
+        }
+
+        frame = reinterpret_cast<shmring::FrameHeader*>(data + ((head + skip) & (_capacity - 1)));
+        frame->length = static_cast<uint32_t>(message.size());
+        frame->priority = event.priority;
+        frame->categoryLength = static_cast<uint32_t>(category.size());
+        frame->threadLength = static_cast<uint32_t>(thread.size());
+        frame->timeStamp = event.timeStamp.getNanoSecondsSinceEpoch();
+        char* payload = reinterpret_cast<char*>(frame + 1);
+        std::memcpy(payload, message.data(), message.size());
+        payload += message.size();
+        std::memcpy(payload, category.data(), category.size());
+        std::memcpy(payload + category.size(), thread.data(), thread.size());
+
+        shmring::storeRelease(&_header->head, head + skip + size);
+        shmring::ringDoorbell(_header);
+    }
+
+    std::auto_ptr<Appender> create_shm_ring_appender(const FactoryParams& params)
+    {
+       std::string name, path;
+       size_t capacity = ShmRingAppender::DEFAULT_CAPACITY;
+       params.get_for("shm ring appender").required("name", name)("path", path)
+                                           .optional("capacity", capacity);
+       return std::auto_ptr<Appender>(new ShmRingAppender(name, path, capacity));
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
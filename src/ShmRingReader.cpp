@@ -0,0 +1,214 @@
+/*
+ * ShmRingReader.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <log4cpp/ShmRingReader.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include "ShmRing.hh"
+
+namespace log4cpp {
+
+    ShmRingReader::ShmRingReader(const std::string& path) :
+        _fd(::open(path.c_str(), O_RDWR)),
+        _header(NULL),
+        _capacity(0),
+        _pending(0),
+        _corrupt(false) {
+        if (_fd >= 0) {
+            ::fcntl(_fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+
+    ShmRingReader::ShmRingReader(int fd) :
+        _fd(::dup(fd)),
+        _header(NULL),
+        _capacity(0),
+        _pending(0),
+        _corrupt(false) {
+        if (_fd >= 0) {
+            ::fcntl(_fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+
+    ShmRingReader::~ShmRingReader() {
+        shmring::unmap(_header);
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+    bool ShmRingReader::_attach() {
+        struct stat st;
+        if (_fd < 0 || ::fstat(_fd, &st) < 0 ||
+            st.st_size < static_cast<off_t>(sizeof(shmring::Header) + shmring::MIN_CAPACITY))
+            return false;
+
+        shmring::Header* header = shmring::map(_fd, st.st_size);
+        if (!header)
+            return false;
+
+        // the producer may not have initialized the segment yet
+        if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != shmring::MAGIC ||
+            header->version != shmring::VERSION ||
+            !shmring::isValidCapacity(header->capacity) ||
+            sizeof(shmring::Header) + header->capacity != static_cast<uint64_t>(st.st_size)) {
+            ::munmap(header, st.st_size);
+            return false;
+        }
+
+        _header = header;
+        _capacity = header->capacity;
+        return true;
+    }
+
+    bool ShmRingReader::isOpen() {
+        return _header || _attach();
+    }
+
+    bool ShmRingReader::next(const char*& data, size_t& length, Priority::Value& priority) {
+        const char* category;
+        size_t categoryLength;
+        return next(data, length, priority, category, categoryLength);
+    }
+
+    bool ShmRingReader::next(const char*& data, size_t& length, Priority::Value& priority,
+                             const char*& category, size_t& categoryLength) {
+        Frame frame;
+        if (!_nextFrame(frame))
+            return false;
+
+        data = frame.data;
+        length = frame.length;
+        priority = frame.priority;
+        category = frame.category;
+        categoryLength = frame.categoryLength;
+        return true;
+    }
+
+    bool ShmRingReader::_nextFrame(Frame& result) {
+        if (!isOpen() || _corrupt)
+            return false;
+
+        const uint64_t head = shmring::loadAcquire(&_header->head);
+        uint64_t tail = _header->tail;
+        while (tail != head) {
+            // the segment is shared with whoever can open it: trust
+            // nothing in it to stay within the frames written
+            const uint64_t pending = head - tail;
+            const size_t offset = tail & (_capacity - 1);
+            const size_t room = _capacity - offset;
+            if (pending > _capacity || room < sizeof(uint32_t))
+                return _setCorrupt();
+
+            const shmring::FrameHeader* frame =
+                reinterpret_cast<const shmring::FrameHeader*>(shmring::data(_header) + offset);
+            if (frame->length == shmring::WRAP) {
+                if (room > pending)
+                    return _setCorrupt();
+                tail += room;
+                shmring::storeRelease(&_header->tail, tail);
+                continue;
+            }
+
+            if (room < sizeof(shmring::FrameHeader))
+                return _setCorrupt();
+
+            // copied, so that a producer writing on cannot change them
+            // once they are checked
+            const shmring::FrameHeader header = *frame;
+            size_t payload = room - sizeof(shmring::FrameHeader);
+            if (header.length > payload)
+                return _setCorrupt();
+            payload -= header.length;
+            if (header.categoryLength > payload)
+                return _setCorrupt();
+            payload -= header.categoryLength;
+            if (header.threadLength > payload)
+                return _setCorrupt();
+            const size_t size = shmring::frameSize(static_cast<size_t>(header.length) +
+                                                   header.categoryLength + header.threadLength);
+            if (size > pending)
+                return _setCorrupt();
+
+            result.data = reinterpret_cast<const char*>(frame + 1);
+            result.length = header.length;
+            result.priority = header.priority;
+            result.category = result.data + result.length;
+            result.categoryLength = header.categoryLength;
+            result.thread = result.category + result.categoryLength;
+            result.threadLength = header.threadLength;
+            result.timeStamp = header.timeStamp;
+            _pending = size;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ShmRingReader::_setCorrupt() {
+        _corrupt = true;
+        _pending = 0;
+        return false;
+    }
+
+    bool ShmRingReader::isCorrupt() const {
+        return _corrupt;
+    }
+
+    void ShmRingReader::release() {
+        if (_header && _pending) {
+            shmring::storeRelease(&_header->tail, _header->tail + _pending);
+            _pending = 0;
+        }
+    }
+
+    bool ShmRingReader::wait(int timeoutMilliseconds) {
+        if (!isOpen() || _corrupt)
+            return false;
+
+        return shmring::waitDoorbell(_header, timeoutMilliseconds);
+    }
+
+    size_t ShmRingReader::drainTo(Appender& appender, size_t maxFrames) {
+        Frame frame;
+        size_t count = 0;
+
+        while (count < maxFrames && _nextFrame(frame)) {
+            // frames of a category or thread usually follow each other
+            if (_category.str().compare(0, std::string::npos, frame.category, frame.categoryLength) != 0)
+                _category = SharedString(frame.category, frame.categoryLength);
+            if (_threadName.str().compare(0, std::string::npos, frame.thread, frame.threadLength) != 0)
+                _threadName = SharedString(frame.thread, frame.threadLength);
+            LoggingEvent event(_category, SharedString(frame.data, frame.length), NDC::ContextStack(),
+                               frame.priority, _threadName, TimeStamp::fromNanoSeconds(frame.timeStamp));
+            release();
+            appender.doAppend(event);
+            count++;
+        }
+
+        return count;
+    }
+
+    unsigned long ShmRingReader::getDropped() {
+        if (!isOpen())
+            return 0;
+
+        return static_cast<unsigned long>(__atomic_load_n(&_header->dropped, __ATOMIC_RELAXED));
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
@@ -35,6 +35,10 @@ namespace log4cpp {
         return message.str();
     }
 
+    unsigned int SimpleLayout::getRequiredFields() const {
+        return 0;
+    }
+
    std::auto_ptr<Layout> create_simple_layout(const FactoryParams& params)
    {
       return std::auto_ptr<Layout>(new SimpleLayout);
@@ -14,22 +14,36 @@
 #include <log4cpp/HierarchyMaintainer.hh>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/thread/mutex.hpp>
-#include <boost/thread/once.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/noncopyable.hpp>
+#include <list>
+#include <map>
+#include <cstdlib>
+#include <stdexcept>
 #include <memory>
 
 namespace log4cpp
 {
    void sender_shutdown();
 
+   namespace
+   {
+      struct digest;
+   }
+
    struct SmptAppender::mail_params
    {
       mail_params(const std::string& host,
                   const std::string& from,
                   const std::string& to,
-                  const std::string& subject) : host_(host), from_(from), to_(to), subject_(subject)
+                  const std::string& subject,
+                  unsigned short port) : host_(host), from_(from), to_(to), subject_(subject),
+                                         port_(boost::lexical_cast<std::string>(port)),
+                                         max_events_(1), max_seconds_(0), max_queued_(1000),
+                                         queued_(0), dropped_(0), open_(0)
       {
       }
 
@@ -37,44 +51,75 @@ namespace log4cpp
       std::string from_;
       std::string to_;
       std::string subject_;
+      std::string port_;
+
+      // the following are guarded by the sender's mutex
+      size_t max_events_;
+      unsigned int max_seconds_;
+      size_t max_queued_;
+      size_t queued_;
+      unsigned long dropped_;
+      digest* open_;            // the digest collecting events, if any
    };
 
    namespace
    {
+      struct digest
+      {
+         boost::shared_ptr<SmptAppender::mail_params> params_;
+         std::string body_;
+         size_t events_;
+         boost::system_time deadline_;
+      };
+
+      struct connection
+      {
+         boost::asio::ip::tcp::iostream stream_;
+         bool pipelining_;
+      };
+
       struct sender : public boost::noncopyable
       {
          sender();
          static sender& instance();
          void shutdown();
          static sender* instance_;
-         void send(const SmptAppender::mail_params& mp, const LoggingEvent& event);
+         void send(const boost::shared_ptr<SmptAppender::mail_params>& mp, const std::string& text);
          void operator()();
-         typedef std::list<std::pair<SmptAppender::mail_params, LoggingEvent> > mails_t;
+         void deliver(const digest& d);
+         connection& connect(const SmptAppender::mail_params& mp);
+         typedef std::list<digest> mails_t;
+         typedef std::map<std::string, boost::shared_ptr<connection> > connections_t;
 
          boost::mutex mails_mutex_;
          boost::condition data_condition_;
          mails_t mails_;
+         connections_t connections_;   // used by the sender thread only
          std::auto_ptr<boost::thread> sender_thread_;
          volatile bool should_exit_;
       };
-      
+
       sender* sender::instance_ = 0;
-      boost::once_flag sender_once = BOOST_ONCE_INIT;
-      
-      sender::sender() : should_exit_(false)
-      {
-         sender_thread_.reset(new boost::thread(boost::ref(*this)));   
-         HierarchyMaintainer::getDefaultMaintainer().register_shutdown_handler(&sender_shutdown);
-      }
+      boost::mutex instance_mutex;
 
-      void create_sender()
+      sender::sender() : should_exit_(false)
       {
-         sender::instance_ = new sender;
+         sender_thread_.reset(new boost::thread(boost::ref(*this)));
       }
 
       sender& sender::instance()
       {
-         boost::call_once(&create_sender, sender_once);
+         static bool handler_registered = false;
+         boost::mutex::scoped_lock lk(instance_mutex);
+         if (!instance_)
+         {
+            instance_ = new sender;
+            if (!handler_registered)
+            {
+               HierarchyMaintainer::getDefaultMaintainer().register_shutdown_handler(&sender_shutdown);
+               handler_registered = true;
+            }
+         }
          return *instance_;
       }
 
@@ -86,64 +131,223 @@ namespace log4cpp
          }
 
          sender_thread_->join();
-         delete instance_;
       }
 
-      void sender::send(const SmptAppender::mail_params& mp, const LoggingEvent& event)
+      void sender::send(const boost::shared_ptr<SmptAppender::mail_params>& mp, const std::string& text)
       {
          boost::mutex::scoped_lock lk(mails_mutex_);
-         mails_.push_back(mails_t::value_type(mp, event));
+         if (mp->queued_ >= mp->max_queued_)
+         {
+            ++mp->dropped_;
+            return;
+         }
+
+         if (!mp->open_)
+         {
+            mails_.push_back(digest());
+            digest& d = mails_.back();
+            d.params_ = mp;
+            d.events_ = 0;
+            d.deadline_ = boost::get_system_time() + boost::posix_time::seconds(mp->max_seconds_);
+            mp->open_ = &d;
+         }
+
+         digest& d = *mp->open_;
+         d.body_ += text;
+         ++d.events_;
+         ++mp->queued_;
+         if (d.events_ >= mp->max_events_)
+         {
+            d.deadline_ = boost::get_system_time();
+            mp->open_ = 0;
+         }
          data_condition_.notify_all();
       }
-      
-      void sender::operator()()
+
+      namespace
       {
-         while(!should_exit_)
+         // reads a possibly multi line reply, returns its code
+         int read_reply(std::istream& s, std::string* text = 0)
          {
-            mails_t::iterator i;
-            
-            {boost::mutex::scoped_lock lk(mails_mutex_);
-               if (should_exit_ && mails_.empty())
-                  return;               
+            std::string line;
+            do
+            {
+               std::getline(s, line);
+               if (line.size() < 3)
+                  throw std::runtime_error("malformed SMTP reply");
+               if (text)
+                  *text += line + "\n";
+            } while (line.size() > 3 && line[3] == '-');
 
-               if (mails_.empty())
-               {
-                  data_condition_.wait(lk);
-                  if (should_exit_ && mails_.empty())
-                     return;
-               }
+            return std::atoi(line.substr(0, 3).c_str());
+         }
 
-               i = mails_.begin();
+         void expect(bool ok, const char* command)
+         {
+            if (!ok)
+               throw std::runtime_error(std::string("SMTP server rejected ") + command);
+         }
+
+         std::string address(const std::string& a)
+         {
+            return (!a.empty() && a[0] == '<') ? a : "<" + a + ">";
+         }
+
+         // CRLF line ends and dot stuffing, as required by DATA
+         void append_body(std::string& out, const std::string& body)
+         {
+            bool line_start = true;
+            for (std::string::const_iterator i = body.begin(), last = body.end(); i != last; ++i)
+            {
+               if (line_start && *i == '.')
+                  out += '.';
+               if (*i == '\n' && (i == body.begin() || *(i - 1) != '\r'))
+                  out += '\r';
+               out += *i;
+               line_start = (*i == '\n');
             }
-            
+            if (!line_start)
+               out += "\r\n";
+         }
+      }
+
+      connection& sender::connect(const SmptAppender::mail_params& mp)
+      {
+         const std::string key = mp.host_ + ":" + mp.port_;
+         connections_t::iterator i = connections_.find(key);
+         if (i != connections_.end() && i->second->stream_.good())
+            return *i->second;
+
+         boost::shared_ptr<connection> c(new connection);
+         c->stream_.exceptions(std::ios::failbit | std::ios::eofbit | std::ios::badbit);
+         c->stream_.connect(mp.host_, mp.port_);
+         expect(read_reply(c->stream_) == 220, "connection");
+
+         std::string capabilities;
+         c->stream_ << "EHLO log4cpp\r\n" << std::flush;
+         if (read_reply(c->stream_, &capabilities) == 250)
+         {
+            c->pipelining_ = capabilities.find("PIPELINING") != std::string::npos;
+         }
+         else
+         {
+            c->stream_ << "HELO log4cpp\r\n" << std::flush;
+            expect(read_reply(c->stream_) == 250, "HELO");
+            c->pipelining_ = false;
+         }
+
+         connections_[key] = c;
+         return *c;
+      }
+
+      void sender::deliver(const digest& d)
+      {
+         const SmptAppender::mail_params& mp = *d.params_;
+         std::string data = "Subject: " + mp.subject_;
+         if (d.events_ > 1)
+            data += " (" + boost::lexical_cast<std::string>(d.events_) + " events)";
+         data += "\r\nContent-Transfer-Encoding: 8bit\r\n\r\n";
+         append_body(data, d.body_);
+         data += ".\r\n";
+
+         // a reused connection may have been closed by the server: retry once
+         for (int attempt = 0; attempt < 2; ++attempt)
+         {
             try
             {
-               boost::asio::ip::tcp::iostream s;
-               s.exceptions(std::ios::failbit | std::ios::eofbit | std::ios::badbit);
-               s.connect(i->first.host_, "25");
-               std::string buf;
-               std::getline(s, buf);
-               s << "HELO test\xd\xa" << std::flush;
-               std::getline(s, buf);
-               s << "MAIL FROM:" << i->first.from_<< "\xd\xa" << std::flush;
-               std::getline(s, buf);
-               s << "RCPT TO:" << i->first.to_ << "\xd\xa" << std::flush;
-               std::getline(s, buf);
-               s << "DATA\xd\xa" << std::flush;
-               std::getline(s, buf);
-               s << "Subject: " << i->first.subject_ << "\xd\xa""Content-Transfer-Encoding: 8bit\xd\xa\xd\xa"
-                  << i->second.message << "\xd\xa" ".\xd\xa" << std::flush;
-               std::getline(s, buf);
-               s << "QUIT\xd\xa" << std::flush;
-               std::getline(s, buf);
+               connection& c = connect(mp);
+               std::iostream& s = c.stream_;
+               if (c.pipelining_)
+               {
+                  s << "MAIL FROM:" << address(mp.from_) << "\r\n"
+                    << "RCPT TO:" << address(mp.to_) << "\r\n"
+                    << "DATA\r\n" << std::flush;
+                  int mail = read_reply(s);
+                  int rcpt = read_reply(s);
+                  int data_reply = read_reply(s);
+                  expect(mail == 250 && rcpt / 100 == 2 && data_reply == 354, "envelope");
+               }
+               else
+               {
+                  s << "MAIL FROM:" << address(mp.from_) << "\r\n" << std::flush;
+                  expect(read_reply(s) == 250, "MAIL");
+                  s << "RCPT TO:" << address(mp.to_) << "\r\n" << std::flush;
+                  expect(read_reply(s) / 100 == 2, "RCPT");
+                  s << "DATA\r\n" << std::flush;
+                  expect(read_reply(s) == 354, "DATA");
+               }
+               s << data << std::flush;
+               expect(read_reply(s) == 250, "message");
+               return;
             }
-            catch(const std::exception& e)
+            catch(const std::exception&)
             {
-               std::cout << e.what();
+               connections_.erase(mp.host_ + ":" + mp.port_);
+            }
+         }
+
+         boost::mutex::scoped_lock lk(mails_mutex_);
+         d.params_->dropped_ += d.events_;
+      }
+
+      void sender::operator()()
+      {
+         for(;;)
+         {
+            mails_t ready;
+
+            {boost::mutex::scoped_lock lk(mails_mutex_);
+               for(;;)
+               {
+                  boost::system_time now = boost::get_system_time();
+                  boost::system_time next_deadline(boost::posix_time::pos_infin);
+                  for (mails_t::iterator i = mails_.begin(); i != mails_.end();)
+                  {
+                     mails_t::iterator current = i++;
+                     if (should_exit_ || current->deadline_ <= now)
+                     {
+                        if (current->params_->open_ == &*current)
+                           current->params_->open_ = 0;
+                        ready.splice(ready.end(), mails_, current);
+                     }
+                     else if (current->deadline_ < next_deadline)
+                     {
+                        next_deadline = current->deadline_;
+                     }
+                  }
+
+                  if (!ready.empty())
+                     break;
+                  if (should_exit_)
+                  {
+                     for (connections_t::iterator i = connections_.begin(); i != connections_.end(); ++i)
+                     {
+                        try
+                        {
+                           i->second->stream_ << "QUIT\r\n" << std::flush;
+                           read_reply(i->second->stream_);
+                        }
+                        catch(const std::exception&)
+                        {
+                        }
+                     }
+                     connections_.clear();
+                     return;
+                  }
+
+                  if (next_deadline.is_pos_infinity())
+                     data_condition_.wait(lk);
+                  else
+                     data_condition_.timed_wait(lk, next_deadline);
+               }
             }
-            
+
+            for (mails_t::const_iterator i = ready.begin(); i != ready.end(); ++i)
+               deliver(*i);
+
             {boost::mutex::scoped_lock lk(mails_mutex_);
-               mails_.erase(i);
+               for (mails_t::const_iterator i = ready.begin(); i != ready.end(); ++i)
+                  i->params_->queued_ -= i->events_;
             }
          }
       }
@@ -151,35 +355,77 @@ namespace log4cpp
 
    void sender_shutdown()
    {
-      sender::instance().shutdown();
+      sender* s;
+      {boost::mutex::scoped_lock lk(instance_mutex);
+         s = sender::instance_;
+         sender::instance_ = 0;
+      }
+
+      if (s)
+      {
+         s->shutdown();
+         delete s;
+      }
    }
 
-   SmptAppender::SmptAppender(const std::string& name, 
-                              const std::string& host, 
+   SmptAppender::SmptAppender(const std::string& name,
+                              const std::string& host,
                               const std::string& from,
-                              const std::string& to, 
-                              const std::string& subject) : LayoutAppender(name), 
-                                                            mail_params_(new mail_params(host, from, to, subject))
-                                                            
+                              const std::string& to,
+                              const std::string& subject,
+                              unsigned short port) : LayoutAppender(name),
+                                                     mail_params_(new mail_params(host, from, to, subject, port))
+
    {
    }
 
+   void SmptAppender::setDigest(size_t max_events, unsigned int max_seconds)
+   {
+      boost::mutex::scoped_lock lk(sender::instance().mails_mutex_);
+      mail_params_->max_events_ = max_events ? max_events : 1;
+      mail_params_->max_seconds_ = max_seconds;
+   }
+
+   void SmptAppender::setMaxQueued(size_t max_events)
+   {
+      boost::mutex::scoped_lock lk(sender::instance().mails_mutex_);
+      mail_params_->max_queued_ = max_events;
+   }
+
+   unsigned long SmptAppender::getDropped() const
+   {
+      boost::mutex::scoped_lock lk(sender::instance().mails_mutex_);
+      return mail_params_->dropped_;
+   }
+
+   unsigned int SmptAppender::getRequiredFields()
+   {
+      return _getLayoutFields();
+   }
+
    void SmptAppender::_append(const LoggingEvent& event)
    {
-      sender::instance().send(*mail_params_, event);
+      sender::instance().send(mail_params_, _getLayout().format(event));
    }
-   
+
    SmptAppender::~SmptAppender()
    {
-      delete mail_params_;
    }
 
    std::auto_ptr<Appender> create_smtp_appender(const FactoryParams& params)
    {
       std::string name, host, from, to, subject;
+      unsigned short port = 25;
+      size_t digest_events = 1, max_queued = 1000;
+      unsigned int digest_seconds = 0;
       params.get_for("SMTP appender").required("name", name)("host", host)("from", from)
-                                              ("to", to)("subject", subject);
-      return std::auto_ptr<Appender>(new SmptAppender(name, host, from, to, subject));
+                                              ("to", to)("subject", subject)
+                                     .optional("port", port)("digest_events", digest_events)
+                                              ("digest_seconds", digest_seconds)("max_queued", max_queued);
+      std::auto_ptr<SmptAppender> appender(new SmptAppender(name, host, from, to, subject, port));
+      appender->setDigest(digest_events, digest_seconds);
+      appender->setMaxQueued(max_queued);
+      return std::auto_ptr<Appender>(appender.release());
    }
 }
 #endif // BOOST_VERSION >= 103500
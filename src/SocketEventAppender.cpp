@@ -0,0 +1,207 @@
+/*
+ * SocketEventAppender.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <log4cpp/SocketEventAppender.hh>
+#include <log4cpp/Layout.hh>
+#include <log4cpp/FactoryParams.hh>
+#include "SenderThread.hh"
+#include <memory>
+
+#ifdef MSG_NOSIGNAL
+#define LOG4CPP_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define LOG4CPP_SEND_FLAGS 0
+#endif
+
+namespace log4cpp {
+
+    namespace {
+        const int SOCKET_TIMEOUT = 10;                  // seconds
+    }
+
+    const size_t SocketEventAppender::DEFAULT_BATCH_SIZE = 64 * 1024;
+    const unsigned int SocketEventAppender::DEFAULT_BATCH_DELAY = 1000;
+
+    SocketEventAppender::SocketEventAppender(const std::string& name,
+                                             const std::string& address,
+                                             EventCodec::Compression compression,
+                                             size_t batchSize) :
+        AppenderSkeleton(name),
+        _address(address),
+        _compression(compression),
+        _flushPriority(Priority::ERROR),
+        _socket(-1),
+        _sender(new SenderThread(&_connectSender, &_sendBatch, this, batchSize, DEFAULT_BATCH_DELAY,
+                                 16 * ((batchSize > DEFAULT_BATCH_SIZE) ? batchSize : DEFAULT_BATCH_SIZE))) {
+        _sender->start();
+    }
+
+    SocketEventAppender::~SocketEventAppender() {
+        close();
+        delete _sender;
+    }
+
+    bool SocketEventAppender::_connect() {
+        if (_address.compare(0, 5, "unix:") == 0) {
+            struct sockaddr_un address;
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, _address.c_str() + 5, sizeof(address.sun_path) - 1);
+
+            _socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (_socket >= 0 && ::connect(_socket, (struct sockaddr*)&address, sizeof(address)) < 0) {
+                _disconnect();
+            }
+        } else {
+            std::string::size_type colon = _address.rfind(':');
+            if (colon == std::string::npos)
+                return false;
+
+            std::string host = _address.substr(0, colon);
+            std::string port = _address.substr(colon + 1);
+            struct addrinfo hints;
+            std::memset(&hints, 0, sizeof(hints));
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            struct addrinfo* addresses;
+            if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+                return false; // fail silently
+
+            for (struct addrinfo* a = addresses; a && _socket < 0; a = a->ai_next) {
+                _socket = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+                if (_socket >= 0 && ::connect(_socket, a->ai_addr, a->ai_addrlen) < 0) {
+                    _disconnect();
+                }
+            }
+            ::freeaddrinfo(addresses);
+        }
+
+        if (_socket < 0)
+            return false;
+
+        // the sending thread may block, but not forever
+        struct timeval timeout;
+        timeout.tv_sec = SOCKET_TIMEOUT;
+        timeout.tv_usec = 0;
+        ::setsockopt(_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        ::fcntl(_socket, F_SETFD, FD_CLOEXEC);
+        return true;
+    }
+
+    void SocketEventAppender::_disconnect() {
+        if (_socket >= 0) {
+            ::close(_socket);
+            _socket = -1;
+        }
+    }
+
+    void SocketEventAppender::close() {
+        _sender->stop();
+        _disconnect();
+    }
+
+    bool SocketEventAppender::reopen() {
+        close();
+        _sender->start();
+        return true;
+    }
+
+    bool SocketEventAppender::requiresLayout() const {
+        return false;
+    }
+
+    void SocketEventAppender::setLayout(Layout* layout) {
+        if (layout)
+            layout->release();
+    }
+
+    void SocketEventAppender::setFlushPriority(Priority::Value priority) {
+        _flushPriority = priority;
+    }
+
+    void SocketEventAppender::setBatchDelay(unsigned int batchDelay) {
+        _sender->setBatchDelay(batchDelay);
+    }
+
+    unsigned long SocketEventAppender::getDropped() const {
+        return _sender->getDropped();
+    }
+
+    void SocketEventAppender::_append(const LoggingEvent& event) {
+        _record.clear();
+        EventCodec::encode(event, _record);
+        _sender->append(_record.data(), _record.size(), event.priority <= _flushPriority);
+    }
+
+    bool SocketEventAppender::flush() {
+        return _sender->flush();
+    }
+
+    bool SocketEventAppender::_connectSender(void* appender) {
+        return static_cast<SocketEventAppender*>(appender)->_connect();
+    }
+
+    size_t SocketEventAppender::_sendBatch(void* appender, const std::string& records,
+                                           const std::vector<size_t>& sizes, bool& connected) {
+        SocketEventAppender* self = static_cast<SocketEventAppender*>(appender);
+        self->_block.clear();
+        EventCodec::encodeBlock(records, self->_compression, self->_block);
+        if (self->_send(self->_block.data(), self->_block.size()))
+            return 0;
+
+        // a block sent partially is useless to the receiver
+        self->_disconnect();
+        connected = false;
+        return sizes.size();
+    }
+
+    bool SocketEventAppender::_send(const char* data, size_t length) {
+        while (length > 0) {
+            ssize_t n = ::send(_socket, data, length, LOG4CPP_SEND_FLAGS);
+            if (n >= 0) {
+                data += n;
+                length -= n;
+            } else if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::auto_ptr<Appender> create_socket_event_appender(const FactoryParams& params)
+    {
+       std::string name, address, compression;
+       size_t batch_size = SocketEventAppender::DEFAULT_BATCH_SIZE;
+       unsigned int batch_delay = SocketEventAppender::DEFAULT_BATCH_DELAY;
+       params.get_for("socket event appender").required("name", name)("address", address)
+                                               .optional("compression", compression)("batch_size", batch_size)
+                                                        ("batch_delay", batch_delay);
+       SocketEventAppender* appender = new SocketEventAppender(name, address,
+                                                               compression == "zlib" ? EventCodec::ZLIB : EventCodec::NONE,
+                                                               batch_size);
+       appender->setBatchDelay(batch_delay);
+       return std::auto_ptr<Appender>(appender);
+    }
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
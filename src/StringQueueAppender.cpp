@@ -24,6 +24,10 @@ namespace log4cpp {
         // empty
     }
 
+    unsigned int StringQueueAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void StringQueueAppender::_append(const LoggingEvent& event) {
         _queue.push(_getLayout().format(event));
     }
@@ -35,8 +35,10 @@ extern "C" {
 namespace log4cpp {
 
     std::string StringUtil::vform(const char* format, va_list args) {
-        size_t size = 1024;
-        char* buffer = new char[size];
+        // most messages fit on the stack
+        char stackBuffer[512];
+        size_t size = sizeof(stackBuffer);
+        char* buffer = stackBuffer;
             
         while (1) {
             va_list args_copy;
@@ -53,8 +55,9 @@ namespace log4cpp {
                 
             // If that worked, return a string.
             if ((n > -1) && (static_cast<size_t>(n) < size)) {
-                std::string s(buffer);
-                delete [] buffer;
+                std::string s(buffer, n);
+                if (buffer != stackBuffer)
+                    delete [] buffer;
                 return s;
             }
                 
@@ -63,11 +66,35 @@ namespace log4cpp {
                 n + 1 :   // ISO/IEC 9899:1999
                 size * 2; // twice the old size
                 
-            delete [] buffer;
+            if (buffer != stackBuffer)
+                delete [] buffer;
             buffer = new char[size];
         }
     }
 
+    void StringUtil::appendJsonString(std::string& out, const std::string& value) {
+        out += '"';
+        for (std::string::const_iterator i = value.begin(); i != value.end(); ++i) {
+            const unsigned char c = static_cast<unsigned char>(*i);
+            switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escape[8];
+                    ::sprintf(escape, "\\u%04x", c);
+                    out += escape;
+                } else {
+                    out += *i;
+                }
+            }
+        }
+        out += '"';
+    }
+
     std::string StringUtil::trim(const std::string& s) {
         static const char* whiteSpace = " \t\r\n";
 
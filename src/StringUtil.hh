@@ -34,6 +34,12 @@ namespace log4cpp {
         **/
         static std::string trim(const std::string& s);
 
+        /**
+           Appends the given string to out as a quoted JSON string,
+           escaping quotes, backslashes and control characters.
+        **/
+        static void appendJsonString(std::string& out, const std::string& value);
+
         /**
            splits a string into a vector of string segments based on the
            given delimiter.
@@ -63,6 +63,10 @@ namespace log4cpp {
         ::closelog();
     }
 
+    unsigned int SyslogAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void SyslogAppender::_append(const LoggingEvent& event) {
         std::string message(_getLayout().format(event));
         int priority = toSyslogPriority(event.priority);
@@ -0,0 +1,75 @@
+/*
+ * ThreadIdentity.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#include "PortabilityImpl.hh"
+#include <log4cpp/threading/ThreadIdentity.hh>
+#include <log4cpp/threading/Threading.hh>
+
+#ifdef LOG4CPP_HAVE_SYS_SYSCALL_H
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace log4cpp {
+    namespace threading {
+
+        namespace {
+            struct Identity {
+                SharedString name;
+                unsigned long systemId;
+            };
+
+            ThreadLocalDataHolder<Identity> _identity;
+
+            unsigned long lookUpSystemThreadId() {
+#if defined(LOG4CPP_HAVE_SYS_SYSCALL_H) && defined(SYS_gettid)
+                return static_cast<unsigned long>(::syscall(SYS_gettid));
+#elif defined(LOG4CPP_USE_MSTHREADS)
+                return ::GetCurrentThreadId();
+#else
+                return 0;
+#endif
+            }
+
+            Identity& getIdentity() {
+                Identity* identity = _identity.get();
+
+                if (!identity) {
+                    identity = new Identity();
+                    identity->name = SharedString(getThreadId());
+                    identity->systemId = lookUpSystemThreadId();
+                    _identity.reset(identity);
+                }
+
+                return *identity;
+            }
+        }
+
+        const SharedString& getThreadName() {
+            return getIdentity().name;
+        }
+
+        void setThreadName(const std::string& name) {
+            getIdentity().name = SharedString(name.empty() ? getThreadId() : name);
+#if defined(LOG4CPP_USE_PTHREADS) && defined(LOG4CPP_HAVE_PTHREAD_SETNAME_NP)
+            if (!name.empty()) {
+#ifdef __APPLE__
+                ::pthread_setname_np(name.c_str());
+#else
+                // Linux limits thread names to 15 characters
+                ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+#endif
+            }
+#endif
+        }
+
+        unsigned long getSystemThreadId() {
+            return getIdentity().systemId;
+        }
+    }
+}
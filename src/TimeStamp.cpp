@@ -8,9 +8,13 @@
  */
 
 #include <log4cpp/TimeStamp.hh>
+#include <log4cpp/threading/Atomic.hh>
 
 #include <cstring>
 
+#ifdef LOG4CPP_HAVE_CLOCK_GETTIME
+#include <time.h>
+#else
 #ifdef LOG4CPP_HAVE_GETTIMEOFDAY
 #include <sys/time.h>
 #else
@@ -20,34 +24,220 @@
 #include <time.h>
 #endif
 #endif
+#endif
+
+#if defined(LOG4CPP_HAVE_CLOCK_GETTIME) && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define LOG4CPP_TIMESTAMP_TSC 1
+#include <cpuid.h>
+#include "TscCalibration.hh"
+#endif
 
 namespace log4cpp {
 
-    LOG4CPP_EXPORT TimeStamp TimeStamp::_startStamp;
+    namespace {
+        threading::Atomic<int> _clock(TimeStamp::REALTIME);
 
-    TimeStamp::TimeStamp() {
+        int64_t readRealtime() {
+#ifdef LOG4CPP_HAVE_CLOCK_GETTIME
+            struct timespec ts;
+            ::clock_gettime(CLOCK_REALTIME, &ts);
+            return ts.tv_sec * static_cast<int64_t>(1000000000) + ts.tv_nsec;
+#else
 #ifdef LOG4CPP_HAVE_GETTIMEOFDAY
-        struct timeval tv;
-        ::gettimeofday(&tv, NULL);
-        _seconds = tv.tv_sec;
-        _microSeconds = tv.tv_usec;
+            struct timeval tv;
+            ::gettimeofday(&tv, NULL);
+            return tv.tv_sec * static_cast<int64_t>(1000000000) + tv.tv_usec * 1000;
 #else
 #ifdef LOG4CPP_HAVE_FTIME
-        struct timeb tb;
-        ::ftime(&tb);
-        _seconds = (int)tb.time;
-        _microSeconds = 1000 * tb.millitm;
+            struct timeb tb;
+            ::ftime(&tb);
+            return tb.time * static_cast<int64_t>(1000000000) + tb.millitm * 1000000;
+#else
+            return ::time(NULL) * static_cast<int64_t>(1000000000);
+#endif
+#endif
+#endif
+        }
+
+        int64_t readCoarse() {
+#if defined(LOG4CPP_HAVE_CLOCK_GETTIME) && defined(CLOCK_REALTIME_COARSE)
+            struct timespec ts;
+            ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return ts.tv_sec * static_cast<int64_t>(1000000000) + ts.tv_nsec;
 #else
-        _seconds = ::time(NULL);
-        _microSeconds = 0;
+            return readRealtime();
 #endif
+        }
+
+#ifdef LOG4CPP_TIMESTAMP_TSC
+        // the calibration, written under a sequence lock: readers retry
+        // while the sequence is odd or has changed
+        threading::Atomic<unsigned long> _sequence(0);
+        threading::Atomic<uint64_t> _baseTicks(0);
+        threading::Atomic<int64_t> _baseMonotonic(0);
+        threading::Atomic<int64_t> _baseNanoSeconds(0);
+        threading::Atomic<uint64_t> _scale(0);
+        threading::Atomic<uint64_t> _resyncTicks(0);
+        threading::Atomic<bool> _resyncing(false);
+
+        inline uint64_t readTicks() {
+            unsigned int low, high;
+            __asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
+            return (static_cast<uint64_t>(high) << 32) | low;
+        }
+
+        int64_t readMonotonic() {
+            struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+            ::clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+            ::clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+            return ts.tv_sec * static_cast<int64_t>(1000000000) + ts.tv_nsec;
+        }
+
+        bool haveInvariantTicks() {
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+                return false;
+            __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+            return (edx & (1 << 8)) != 0;
+        }
+
+        // reads the counter and both clocks at about the same time,
+        // keeping the closest of a few tries in case the thread was
+        // interrupted in between
+        tsc::Sample sample() {
+            tsc::Sample result;
+            uint64_t best = ~static_cast<uint64_t>(0);
+            for (int i = 0; i < 5; i++) {
+                uint64_t before = readTicks();
+                int64_t monotonic = readMonotonic();
+                int64_t realtime = readRealtime();
+                uint64_t after = readTicks();
+                if (after - before < best) {
+                    best = after - before;
+                    result.ticks = before + best / 2;
+                    result.monotonic = monotonic;
+                    result.realtime = realtime;
+                }
+            }
+            return result;
+        }
+
+        void storeCalibration(const tsc::Sample& base, uint64_t scale) {
+            _sequence.fetchAdd(1);
+            _baseTicks.store(base.ticks);
+            _baseMonotonic.store(base.monotonic);
+            _baseNanoSeconds.store(base.realtime);
+            _scale.store(scale);
+            _sequence.fetchAdd(1);
+        }
+
+        bool calibrate() {
+            if (!haveInvariantTicks())
+                return false;
+
+            tsc::Sample first = sample();
+            tsc::Sample second;
+            do {
+                second = sample();
+            } while (second.monotonic - first.monotonic < 10000000);
+
+            uint64_t scale = tsc::measureScale(first, second);
+            if (scale == 0)
+                return false;
+
+            // about a second
+            _resyncTicks.store((second.ticks - first.ticks) * 100);
+            storeCalibration(second, scale);
+            return true;
+        }
+
+        // measures the rate again over the time since the last
+        // synchronization, which corrects drift, and anchors the offset to
+        // the wall clock again, which follows its adjustments
+        void resync() {
+            tsc::Sample base;
+            base.ticks = _baseTicks.load();
+            base.monotonic = _baseMonotonic.load();
+            tsc::Sample now = sample();
+            uint64_t scale = tsc::measureScale(base, now);
+            storeCalibration(now, (scale != 0) ? scale : _scale.load());
+        }
+
+        int64_t readCounter() {
+            for (;;) {
+                unsigned long sequence = _sequence.load();
+                tsc::Sample base;
+                base.ticks = _baseTicks.load();
+                base.realtime = _baseNanoSeconds.load();
+                uint64_t scale = _scale.load();
+                if ((sequence & 1) || sequence != _sequence.load())
+                    continue;
+
+                uint64_t ticks = readTicks();
+                if (ticks - base.ticks >= _resyncTicks.loadRelaxed()) {
+                    // extrapolating further may overflow, so threads not
+                    // resynchronizing wait for the one that does
+                    if (!_resyncing.exchange(true)) {
+                        resync();
+                        _resyncing.store(false);
+                    }
+                    continue;
+                }
+                return tsc::toNanoSeconds(base, scale, ticks);
+            }
+        }
 #endif
     }
 
+    LOG4CPP_EXPORT TimeStamp TimeStamp::_startStamp;
+
+    TimeStamp::TimeStamp() {
+        switch (_clock.loadRelaxed()) {
+        case REALTIME_COARSE:
+            _nanoSeconds = readCoarse();
+            break;
+#ifdef LOG4CPP_TIMESTAMP_TSC
+        case TSC:
+            _nanoSeconds = readCounter();
+            break;
+#endif
+        default:
+            _nanoSeconds = readRealtime();
+            break;
+        }
+    }
+
     TimeStamp::TimeStamp(unsigned int seconds, unsigned int microSeconds) :
-        _seconds(seconds),
-        _microSeconds(microSeconds) {
+        _nanoSeconds(seconds * static_cast<int64_t>(1000000000) + microSeconds * static_cast<int64_t>(1000)) {
     }
-}
 
+    TimeStamp TimeStamp::fromNanoSeconds(int64_t nanoSecondsSinceEpoch) {
+        TimeStamp result(0, 0);
+        result._nanoSeconds = nanoSecondsSinceEpoch;
+        return result;
+    }
+
+    TimeStamp::Clock TimeStamp::setClock(Clock clock) {
+        if (clock == TSC) {
+#ifdef LOG4CPP_TIMESTAMP_TSC
+            if (!calibrate())
+                clock = REALTIME;
+#else
+            clock = REALTIME;
+#endif
+        }
+#if !defined(LOG4CPP_HAVE_CLOCK_GETTIME) || !defined(CLOCK_REALTIME_COARSE)
+        if (clock == REALTIME_COARSE)
+            clock = REALTIME;
+#endif
+        _clock.store(clock);
+        return clock;
+    }
 
+    TimeStamp::Clock TimeStamp::getClock() {
+        return static_cast<Clock>(_clock.load());
+    }
+}
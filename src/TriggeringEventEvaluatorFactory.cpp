@@ -11,6 +11,10 @@ namespace log4cpp
 {
    static TriggeringEventEvaluatorFactory* evaluators_factory_ = 0;
    std::auto_ptr<TriggeringEventEvaluator> create_level_evaluator(const FactoryParams& params);
+   std::auto_ptr<TriggeringEventEvaluator> create_count_evaluator(const FactoryParams& params);
+   std::auto_ptr<TriggeringEventEvaluator> create_interval_evaluator(const FactoryParams& params);
+   std::auto_ptr<TriggeringEventEvaluator> create_and_evaluator(const FactoryParams& params);
+   std::auto_ptr<TriggeringEventEvaluator> create_or_evaluator(const FactoryParams& params);
 
    TriggeringEventEvaluatorFactory& TriggeringEventEvaluatorFactory::getInstance()
    {
@@ -18,6 +22,10 @@ namespace log4cpp
       {
          std::auto_ptr<TriggeringEventEvaluatorFactory> af(new TriggeringEventEvaluatorFactory);
          af->registerCreator("level", &create_level_evaluator);
+         af->registerCreator("count", &create_count_evaluator);
+         af->registerCreator("interval", &create_interval_evaluator);
+         af->registerCreator("and", &create_and_evaluator);
+         af->registerCreator("or", &create_or_evaluator);
          evaluators_factory_ = af.release();
       }
 
@@ -0,0 +1,57 @@
+/*
+ * TscCalibration.hh
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef _LOG4CPP_TSCCALIBRATION_HH
+#define _LOG4CPP_TSCCALIBRATION_HH
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4CPP_HAVE_STDINT_H
+#include <stdint.h>
+#endif
+
+namespace log4cpp {
+    namespace tsc {
+
+        // nanoseconds = base + (ticks - baseTicks) * scale / 2^SCALE_SHIFT
+        const int SCALE_SHIFT = 24;
+
+        /*
+         * The time stamp counter, a monotonic clock which wall clock steps
+         * and slewing do not affect, and the wall clock, read at about
+         * the same time.
+         */
+        struct Sample {
+            uint64_t ticks;
+            int64_t monotonic;
+            int64_t realtime;
+        };
+
+        /*
+         * Measures the nanoseconds per tick, shifted by SCALE_SHIFT, against
+         * the monotonic clock, so that stepping the wall clock in between,
+         * e.g. by NTP or settimeofday(), does not skew the rate.
+         * @returns 0 if the samples are not in order.
+         */
+        inline uint64_t measureScale(const Sample& from, const Sample& to) {
+            if (to.ticks <= from.ticks || to.monotonic <= from.monotonic)
+                return 0;
+            return (static_cast<uint64_t>(to.monotonic - from.monotonic) << SCALE_SHIFT) /
+                (to.ticks - from.ticks);
+        }
+
+        /*
+         * Extrapolates the wall clock from the base sample, which anchors
+         * the offset to it.
+         */
+        inline int64_t toNanoSeconds(const Sample& base, uint64_t scale, uint64_t ticks) {
+            return base.realtime + static_cast<int64_t>(((ticks - base.ticks) * scale) >> SCALE_SHIFT);
+        }
+    }
+}
+
+#endif // _LOG4CPP_TSCCALIBRATION_HH
@@ -35,6 +35,10 @@ namespace log4cpp {
     void Win32DebugAppender::close() {
     }
 
+    unsigned int Win32DebugAppender::getRequiredFields() {
+        return _getLayoutFields();
+    }
+
     void Win32DebugAppender::_append(const LoggingEvent& event) {
         std::string message(_getLayout().format(event));
                 ::OutputDebugString(message.c_str());
@@ -0,0 +1,21 @@
+/*
+ * Check.hh
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ */
+
+#ifndef __CHECK_H
+#define __CHECK_H
+
+#include <iostream>
+
+// reports a failed condition; tests chain them as
+// result = check(condition, "what") && result
+inline bool check(bool condition, const char* what)
+{
+   if (!condition)
+      std::cout << "failed: " << what << "\n";
+   return condition;
+}
+
+#endif
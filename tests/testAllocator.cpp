@@ -0,0 +1,202 @@
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Allocator.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/AppenderSkeleton.hh>
+#include <log4cpp/CategoryStream.hh>
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// every allocation of the program, so that memory taken past the
+// Allocator shows up too
+unsigned long heapAllocations = 0;
+
+#if __cplusplus >= 201103L
+#define THROW_BAD_ALLOC
+#else
+#define THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+void* operator new(size_t size) THROW_BAD_ALLOC
+{
+   __sync_fetch_and_add(&heapAllocations, 1);
+   void* block = malloc(size ? size : 1);
+   if (!block)
+      throw std::bad_alloc();
+   return block;
+}
+
+void operator delete(void* block) throw()
+{
+   free(block);
+}
+
+// an appender which formats nothing, so that what logging itself takes shows
+class DiscardingAppender : public AppenderSkeleton
+{
+   public:
+      DiscardingAppender() : AppenderSkeleton("discard"), appended(0) {}
+
+      virtual void close() {}
+      virtual bool requiresLayout() const { return false; }
+      virtual void setLayout(Layout*) {}
+
+      int appended;
+
+   protected:
+      virtual void _append(const LoggingEvent&) { appended++; }
+};
+
+// an allocator counting the blocks it hands out
+class CountingAllocator : public Allocator
+{
+   public:
+      CountingAllocator() : allocations(0), deallocations(0) {}
+
+      virtual void* allocate(size_t size)
+      {
+         allocations++;
+         return malloc(size);
+      }
+
+      virtual void deallocate(void* block, size_t) throw()
+      {
+         deallocations++;
+         free(block);
+      }
+
+      int allocations;
+      int deallocations;
+};
+
+CountingAllocator counting;
+
+const string message(100, 'x');
+
+void makeEvents(vector<LoggingEvent*>& events, size_t count)
+{
+   for (size_t i = 0; i < count; i++)
+      events.push_back(new LoggingEvent(SharedString("pool"), SharedString(message),
+                                        NDC::ContextStack(), Priority::INFO));
+}
+
+void deleteEvents(vector<LoggingEvent*>& events)
+{
+   for (size_t i = 0; i < events.size(); i++)
+      delete events[i];
+   events.clear();
+}
+
+#ifdef LOG4CPP_USE_PTHREADS
+void* consume(void* events)
+{
+   deleteEvents(*static_cast<vector<LoggingEvent*>*>(events));
+   return NULL;
+}
+#endif
+
+int main()
+{
+   Category& category = Category::getInstance("pool");
+   category.setAdditivity(false);
+   StringQueueAppender* appender = new StringQueueAppender("pool");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   category.addAppender(appender);
+
+   // warm up, then logging must not take memory from the system anymore
+   vector<LoggingEvent*> events;
+   makeEvents(events, 100);
+   deleteEvents(events);
+   category.info(message);
+   appender->popMessage();
+
+   Allocator::Statistics before = Allocator::getStatistics();
+   for (int i = 0; i < 1000; i++)
+   {
+      category.info(message);
+      appender->popMessage();
+   }
+   makeEvents(events, 100);
+   deleteEvents(events);
+   Allocator::Statistics after = Allocator::getStatistics();
+   bool result = check(after.allocations - before.allocations >= 100, "events pooled");
+   result = check(after.allocations - before.allocations == after.deallocations - before.deallocations,
+                  "all freed") && result;
+   result = check(after.bytesAllocated - before.bytesAllocated == after.bytesFreed - before.bytesFreed,
+                  "bytes freed") && result;
+   result = check(after.systemAllocations == before.systemAllocations, "steady state") && result;
+
+   // nor from the heap, whichever way the message is made
+   Category& quiet = Category::getInstance("pool.quiet");
+   quiet.setAdditivity(false);
+   DiscardingAppender* discarding = new DiscardingAppender();
+   quiet.addAppender(discarding);
+   quiet.info(message);
+   quiet.info("%s", message.c_str());
+   const char* batch[] = { message.c_str(), message.c_str(), message.c_str() };
+   quiet.logBatch(Priority::INFO, batch, batch + 3);
+   // last, so that the cached string fits the longest message next
+   quiet.infoStream() << message << 999;
+
+   unsigned long heap = heapAllocations;
+   for (int i = 0; i < 1000; i++)
+      quiet.info(message);
+   result = check(heapAllocations == heap, "string path") && result;
+   heap = heapAllocations;
+   for (int i = 0; i < 1000; i++)
+      quiet.info("%s", message.c_str());
+   result = check(heapAllocations == heap, "printf path") && result;
+   heap = heapAllocations;
+   for (int i = 0; i < 1000; i++)
+      quiet.infoStream() << message << i;
+   result = check(heapAllocations == heap, "stream path") && result;
+   heap = heapAllocations;
+   for (int i = 0; i < 1000; i++)
+      quiet.logBatch(Priority::INFO, batch, batch + 3);
+   result = check(heapAllocations == heap, "batch path") && result;
+   result = check(discarding->appended == 6006, "appended") && result;
+
+#ifdef LOG4CPP_USE_PTHREADS
+   // blocks and messages freed by another thread come back
+   before = Allocator::getStatistics();
+   for (int i = 0; i < 10; i++)
+   {
+      makeEvents(events, 100);
+      pthread_t consumer;
+      pthread_create(&consumer, NULL, consume, &events);
+      pthread_join(consumer, NULL);
+   }
+   makeEvents(events, 100);
+   deleteEvents(events);
+   after = Allocator::getStatistics();
+   result = check(after.systemAllocations == before.systemAllocations, "returned across threads") && result;
+#endif
+
+   // an installed allocator, which keeps its blocks after it is replaced
+   Allocator::setAllocator(&counting);
+   result = check(Allocator::getAllocator() == &counting, "installed") && result;
+   LoggingEvent* event = new LoggingEvent(SharedString("pool"), SharedString(message),
+                                          NDC::ContextStack(), Priority::INFO);
+   Allocator::setAllocator(NULL);
+   result = check(counting.allocations > 0 && counting.deallocations == 0, "allocated") && result;
+   delete event;
+   result = check(counting.deallocations == counting.allocations, "freed by its allocator") && result;
+   result = check(Allocator::getAllocator() == NULL, "default") && result;
+
+   return result ? 0 : -1;
+}
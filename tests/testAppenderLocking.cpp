@@ -0,0 +1,241 @@
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/AppenderSkeleton.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// counts events and notices being entered concurrently
+class CheckingAppender : public AppenderSkeleton {
+    public:
+    CheckingAppender(const string& name) :
+        AppenderSkeleton(name), inside(0), overlaps(0), events(0) {
+    }
+
+    virtual void close() {}
+    virtual bool requiresLayout() const { return false; }
+    virtual void setLayout(Layout*) {}
+
+    volatile int inside;
+    int overlaps;
+    int events;
+
+    protected:
+    virtual void _append(const LoggingEvent&) {
+        if (inside++ != 0)
+            overlaps++;
+#ifdef LOG4CPP_USE_PTHREADS
+        sched_yield();
+#endif
+        events++;
+        inside--;
+    }
+};
+
+// removes itself from its category while appending
+class RemovingAppender : public AppenderSkeleton {
+    public:
+    static bool deleted;
+
+    RemovingAppender(Category& category) :
+        AppenderSkeleton("removing"), _category(category) {
+    }
+
+    virtual ~RemovingAppender() {
+        deleted = true;
+    }
+
+    virtual void close() {}
+    virtual bool requiresLayout() const { return false; }
+    virtual void setLayout(Layout*) {}
+
+    bool deletedDuringAppend;
+
+    protected:
+    virtual void _append(const LoggingEvent&) {
+        _category.removeAppender(this);
+        deletedDuringAppend = deleted;
+    }
+
+    Category& _category;
+};
+
+bool RemovingAppender::deleted = false;
+
+// takes its time appending
+class SlowAppender : public AppenderSkeleton {
+    public:
+    static volatile bool deleted;
+
+    SlowAppender() :
+        AppenderSkeleton("slow"), entered(0), inside(0) {
+    }
+
+    virtual ~SlowAppender() {
+        deleted = true;
+    }
+
+    virtual void close() {}
+    virtual bool requiresLayout() const { return false; }
+    virtual void setLayout(Layout*) {}
+
+    volatile int entered;
+    volatile int inside;
+
+    protected:
+    virtual void _append(const LoggingEvent&) {
+        inside = 1;
+        entered = 1;
+#ifdef LOG4CPP_USE_PTHREADS
+        ::usleep(100000);
+#endif
+        inside = 0;
+    }
+};
+
+volatile bool SlowAppender::deleted = false;
+
+// removes its peer from the peer's category once both are appending
+class PeerAppender : public AppenderSkeleton {
+    public:
+    static volatile int entered;
+    static volatile int deleted;
+
+    PeerAppender() :
+        AppenderSkeleton("peer"), peer(NULL), peerCategory(NULL) {
+    }
+
+    virtual ~PeerAppender() {
+        __sync_fetch_and_add(&deleted, 1);
+    }
+
+    virtual void close() {}
+    virtual bool requiresLayout() const { return false; }
+    virtual void setLayout(Layout*) {}
+
+    PeerAppender* peer;
+    Category* peerCategory;
+
+    protected:
+    virtual void _append(const LoggingEvent&) {
+        __sync_fetch_and_add(&entered, 1);
+#ifdef LOG4CPP_USE_PTHREADS
+        for (int i = 0; entered < 2 && i < 1000; i++)
+            ::usleep(1000);
+#endif
+        peerCategory->removeAppender(peer);
+    }
+};
+
+volatile int PeerAppender::entered = 0;
+volatile int PeerAppender::deleted = 0;
+
+#ifdef LOG4CPP_USE_PTHREADS
+const int EVENTS = 20000;
+
+void* log_events(void* category)
+{
+   for (int i = 0; i < EVENTS; i++)
+      static_cast<Category*>(category)->info("event");
+   return NULL;
+}
+
+void* log_event(void* category)
+{
+   static_cast<Category*>(category)->info("event");
+   return NULL;
+}
+#endif
+
+int main()
+{
+   bool result = true;
+
+   Category& removing = Category::getInstance("locking.removing");
+   removing.setAdditivity(false);
+   RemovingAppender* appender = new RemovingAppender(removing);
+   removing.addAppender(appender);
+   removing.error("removes the appender");
+   result = check(!appender->deletedDuringAppend, "deletion deferred") && result;
+   result = check(RemovingAppender::deleted, "deleted after dispatch") && result;
+   result = check(removing.getAppender() == NULL, "removed") && result;
+
+#ifdef LOG4CPP_USE_PTHREADS
+   // one appender shared by two categories
+   CheckingAppender shared("shared");
+   Category& first = Category::getInstance("locking.first");
+   Category& second = Category::getInstance("locking.second");
+   first.setAdditivity(false);
+   second.setAdditivity(false);
+   first.addAppender(shared);
+   second.addAppender(shared);
+
+   pthread_t threads[4];
+   for (int i = 0; i < 4; i++)
+      pthread_create(&threads[i], NULL, &log_events, (i % 2) ? &first : &second);
+   for (int i = 0; i < 4; i++)
+      pthread_join(threads[i], NULL);
+
+   result = check(shared.overlaps == 0, "never entered concurrently") && result;
+   result = check(shared.events == 4 * EVENTS, "all events appended") && result;
+   first.removeAllAppenders();
+   second.removeAllAppenders();
+
+   // removing an appender waits for the appends in flight
+   SlowAppender* slow = new SlowAppender();
+   Category& waiting = Category::getInstance("locking.waiting");
+   waiting.setAdditivity(false);
+   waiting.addAppender(*slow);
+   pthread_t thread;
+   pthread_create(&thread, NULL, &log_event, &waiting);
+   while (!slow->entered)
+      sched_yield();
+   waiting.removeAppender(slow);
+   result = check(!slow->inside, "removal waited") && result;
+   delete slow;
+   pthread_join(thread, NULL);
+
+   // an owned appender is deleted by the append in flight instead
+   slow = new SlowAppender();
+   SlowAppender::deleted = false;
+   waiting.addAppender(slow);
+   pthread_create(&thread, NULL, &log_event, &waiting);
+   while (!slow->entered)
+      sched_yield();
+   waiting.removeAppender(slow);
+   result = check(!SlowAppender::deleted, "removal did not wait") && result;
+   pthread_join(thread, NULL);
+   result = check(SlowAppender::deleted, "deleted by the append") && result;
+
+   // appenders removing each other while both are appending
+   Category& ping = Category::getInstance("locking.ping");
+   Category& pong = Category::getInstance("locking.pong");
+   ping.setAdditivity(false);
+   pong.setAdditivity(false);
+   PeerAppender* pinging = new PeerAppender();
+   PeerAppender* ponging = new PeerAppender();
+   pinging->peer = ponging;
+   pinging->peerCategory = &pong;
+   ponging->peer = pinging;
+   ponging->peerCategory = &ping;
+   ping.addAppender(pinging);
+   pong.addAppender(ponging);
+   pthread_t peers[2];
+   pthread_create(&peers[0], NULL, &log_event, &ping);
+   pthread_create(&peers[1], NULL, &log_event, &pong);
+   pthread_join(peers[0], NULL);
+   pthread_join(peers[1], NULL);
+   result = check(PeerAppender::entered == 2, "both appending") && result;
+   result = check(PeerAppender::deleted == 2, "removed each other") && result;
+#endif
+
+   return result ? 0 : -1;
+}
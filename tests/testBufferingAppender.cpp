@@ -0,0 +1,108 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/BufferingAppender.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/LevelEvaluator.hh>
+#include <log4cpp/CountEvaluator.hh>
+#include <log4cpp/TriggeringEventEvaluatorFactory.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <string>
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// a sink counting the batches it receives
+class BatchCountingAppender : public StringQueueAppender
+{
+   public:
+      BatchCountingAppender() : StringQueueAppender("sink"), batches(0) {}
+
+      int batches;
+
+   protected:
+      virtual void _appendBatch(const LoggingEvent* const* events, size_t count)
+      {
+         batches++;
+         StringQueueAppender::_appendBatch(events, count);
+      }
+};
+
+BufferingAppender* buffer(Category& category, unsigned long size, BatchCountingAppender*& sink,
+                          TriggeringEventEvaluator* evaluator = new LevelEvaluator(Priority::ERROR))
+{
+   sink = new BatchCountingAppender();
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%p %m");
+   sink->setLayout(layout);
+   BufferingAppender* appender = new BufferingAppender("buffer", size, std::auto_ptr<Appender>(sink),
+                                                       std::auto_ptr<TriggeringEventEvaluator>(evaluator));
+   category.setAdditivity(false);
+   category.setPriority(Priority::DEBUG);
+   category.addAppender(appender);
+   return appender;
+}
+
+int main()
+{
+   BatchCountingAppender* sink;
+   Category& triggered = Category::getInstance("buffering.triggered");
+   buffer(triggered, 10, sink);
+   triggered.debug("one");
+   triggered.info("two");
+   bool result = check(sink->queueSize() == 0, "buffered until triggered");
+   triggered.error("three");
+   // the events are passed on one by one, keeping their priorities
+   result = check(sink->batches == 1 && sink->queueSize() == 3, "one batch of three") && result;
+   result = check(sink->popMessage() == "DEBUG one" && sink->popMessage() == "INFO two" &&
+                  sink->popMessage() == "ERROR three", "events preserved in order") && result;
+   triggered.error("four");
+   result = check(sink->batches == 2 && sink->popMessage() == "ERROR four", "emptied after dumping") && result;
+
+   Category& lossy = Category::getInstance("buffering.lossy");
+   buffer(lossy, 3, sink)->setLossy(true);
+   for (int i = 0; i < 5; i++)
+      lossy.info("old");
+   lossy.info("newer");
+   lossy.error("newest");
+   result = check(sink->queueSize() == 3, "lossy keeps the last events") && result;
+   result = check(sink->popMessage() == "INFO old" && sink->popMessage() == "INFO newer" &&
+                  sink->popMessage() == "ERROR newest", "lossy order") && result;
+
+   Category& full = Category::getInstance("buffering.full");
+   buffer(full, 3, sink);
+   for (int i = 0; i < 4; i++)
+      full.info("event");
+   result = check(sink->batches == 1 && sink->queueSize() == 3, "dumped when full") && result;
+   full.error("last");
+   result = check(sink->batches == 2 && sink->queueSize() == 5, "remainder dumped") && result;
+
+   Category& counted = Category::getInstance("buffering.counted");
+   buffer(counted, 100, sink, new CountEvaluator(3));
+   for (int i = 0; i < 7; i++)
+      counted.info("event");
+   result = check(sink->batches == 2 && sink->queueSize() == 6, "batches of three") && result;
+
+   // either an error, 100 events or 100ms
+   FactoryParams params;
+   params["level"] = "ERROR";
+   params["count"] = "100";
+   params["interval"] = "100";
+   Category& either = Category::getInstance("buffering.either");
+   buffer(either, 1000, sink, TriggeringEventEvaluatorFactory::getInstance().create("or", params).release());
+   for (int i = 0; i < 150; i++)
+      either.info("event");
+   result = check(sink->batches == 1 && sink->queueSize() == 100, "count triggered") && result;
+#ifdef LOG4CPP_USE_PTHREADS
+   // flushed by the timer, without another event
+   for (int i = 0; i < 100 && sink->batches < 2; i++)
+      usleep(50000);
+   result = check(sink->batches == 2 && sink->queueSize() == 150, "interval triggered") && result;
+#endif
+
+   Category::shutdown();
+   return result ? 0 : -1;
+}
@@ -0,0 +1,94 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/Format.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <iomanip>
+#include <locale>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// a locale streams must not pick up
+struct CommaDecimals : public numpunct<char> {
+   char do_decimal_point() const { return ','; }
+   char do_thousands_sep() const { return '.'; }
+   string do_grouping() const { return "\3"; }
+};
+
+struct Logged {
+   int value;
+};
+
+ostream& operator<<(ostream& out, const Logged& logged)
+{
+   // logs on its own while being streamed
+   Category::getInstance("stream").infoStream() << "nested " << logged.value;
+   return out << "logged(" << logged.value << ")";
+}
+
+int main()
+{
+   Category& category = Category::getInstance("stream");
+   StringQueueAppender* appender = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   category.setAdditivity(false);
+   category.addAppender(appender);
+   category.setPriority(Priority::INFO);
+
+   locale::global(locale(locale::classic(), new CommaDecimals));
+
+   category.infoStream() << "n=" << 1234567 << " " << -42L << " " << 3000000000UL << " "
+                         << (short)-7 << " " << 1.5 << " " << 0.1 << " " << 2.0 << " " << 0.25f;
+   bool result = check(appender->popMessage() == "n=1234567 -42 3000000000 -7 1.5 0.1 2 0.25", "numbers");
+
+   category.infoStream() << 3.141592653589793 << " " << 1e-7 << " " << 1e300;
+   string doubles = appender->popMessage();
+   result = check(doubles.find("3.141592653589793 1e-07 1e+300") == 0, "round trip") && result;
+
+   category.infoStream() << "[" << width(5) << 42 << "]" << left << "[" << width(4) << 7 << "]"
+                         << tab(1) << "x";
+   result = check(appender->popMessage() == "[   42][7   ]\tx", "manipulators") && result;
+
+   category.infoStream() << hex << 255 << " " << setprecision(3) << 3.14159 << " " << 2.5;
+   result = check(appender->popMessage() == "ff 3.14 2.5", "stream formatting") && result;
+
+   // the reused buffer starts over with default formatting
+   category.infoStream() << 255 << " " << 3.14159;
+   result = check(appender->popMessage() == "255 3.14159", "reset") && result;
+
+   Logged logged = { 5 };
+   category.infoStream() << "outer " << logged << " " << 6;
+   result = check(appender->queueSize() == 2 && appender->popMessage() == "nested 5" &&
+                  appender->popMessage() == "outer logged(5) 6", "nested") && result;
+
+   // pooled buffers start out empty, also after huge messages
+   string huge(100000, 'x');
+   category.infoStream() << huge;
+   category.infoStream() << "small";
+   result = check(appender->popMessage() == huge && appender->popMessage() == "small", "reused") && result;
+   for (int i = 0; i < 10; i++) {
+      Logged deeper = { i };
+      category.infoStream() << deeper << deeper;
+   }
+   result = check(appender->queueSize() == 30, "pooled") && result;
+   while (appender->queueSize() > 0)
+      appender->popMessage();
+
+   category.debugStream() << "disabled " << 1;
+   category.infoStream() << "first" << eol << "second";
+   result = check(appender->queueSize() == 2 && appender->popMessage() == "first" &&
+                  appender->popMessage() == "second", "eol") && result;
+
+   char number[NumberFormat::maxLength];
+   result = check(string(number, NumberFormat::formatUnsigned(number, 7, 3)) == "007" &&
+                  string(number, NumberFormat::formatUnsigned(number, 12345, 3)) == "12345",
+                  "zero padded") && result;
+
+   locale::global(locale::classic());
+   return result ? 0 : -1;
+}
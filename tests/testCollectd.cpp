@@ -0,0 +1,160 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/SocketEventAppender.hh>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+#ifndef COLLECTD_PATH
+#define COLLECTD_PATH "../tools/log4cpp-collectd"
+#endif
+
+static const char* const config_path = "collectd_test.properties";
+static const char* const log_path = "collectd_test.log";
+static const char* const events_path = "collectd_test.events";
+static const char* const syslog_path = "collectd_test.syslog";
+
+pid_t start_collector()
+{
+   ofstream config(config_path);
+   config << "rootCategory=DEBUG, out\n"
+          << "appender.out=FileAppender\n"
+          << "appender.out.fileName=" << log_path << "\n"
+          << "appender.out.layout=PatternLayout\n"
+          << "appender.out.layout.ConversionPattern=%c %p %m%n\n";
+   config.close();
+
+   pid_t pid = fork();
+   if (pid == 0)
+   {
+      string events = string("unix:") + events_path;
+      string syslog = string("unix:") + syslog_path;
+      execl(COLLECTD_PATH, COLLECTD_PATH, "-c", config_path, "-l", events.c_str(),
+            "-s", syslog.c_str(), (char*)NULL);
+      _exit(127);
+   }
+
+   // until it listens
+   for (int i = 0; i < 100 && (access(events_path, F_OK) != 0 || access(syslog_path, F_OK) != 0); i++)
+      usleep(50000);
+   return pid;
+}
+
+void send_syslog(const char* datagram)
+{
+   int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+   struct sockaddr_un address;
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   strncpy(address.sun_path, syslog_path, sizeof(address.sun_path) - 1);
+   sendto(fd, datagram, strlen(datagram), 0, (struct sockaddr*)&address, sizeof(address));
+   close(fd);
+}
+
+// waits up to five seconds for the collector to write the lines
+string read_log(int lines)
+{
+   string text;
+   for (int i = 0; i < 100; i++)
+   {
+      ifstream log(log_path);
+      ostringstream content;
+      content << log.rdbuf();
+      text = content.str();
+      int count = 0;
+      for (string::size_type n = text.find('\n'); n != string::npos; n = text.find('\n', n + 1))
+         count++;
+      if (count >= lines)
+         break;
+      usleep(50000);
+   }
+   return text;
+}
+
+bool logged(const string& text, const char* line)
+{
+   return check(text.find(string(line) + "\n") != string::npos, line);
+}
+
+int main()
+{
+   if (access(COLLECTD_PATH, X_OK) != 0)
+   {
+      cout << "log4cpp-collectd not available in this build.\n";
+      // 77 tells the test harness that the test was skipped
+      return 77;
+   }
+
+   unlink(log_path);
+   pid_t collector = start_collector();
+   bool result = check(collector > 0 && access(events_path, F_OK) == 0, "collector started");
+
+   // events forwarded by SocketEventAppender
+   Category& cat = Category::getInstance("forwarded");
+   cat.setAdditivity(false);
+   cat.setPriority(Priority::DEBUG);
+   SocketEventAppender* appender = new SocketEventAppender("forward", string("unix:") + events_path,
+                                                           EventCodec::NONE);
+   cat.addAppender(appender);
+   Category::getInstance("forwarded.a").info("first");
+   Category::getInstance("forwarded.b").error("second");
+   cat.debug("third");
+   result = check(appender->flush(), "forwarded") && result;
+
+   // syslog severities map to the priorities, without one to NOTICE
+   send_syslog("<11>disk failed");
+   send_syslog("<14>user info\n");
+   send_syslog("<0>panic");
+   send_syslog("<191>debugging");
+   send_syslog("no priority");
+
+   string text = read_log(8);
+   result = logged(text, "forwarded.a INFO first") && result;
+   result = logged(text, "forwarded.b ERROR second") && result;
+   result = logged(text, "forwarded DEBUG third") && result;
+   result = logged(text, "syslog ERROR disk failed") && result;
+   result = logged(text, "syslog INFO user info") && result;
+   result = logged(text, "syslog FATAL panic") && result;
+   result = logged(text, "syslog DEBUG debugging") && result;
+   result = logged(text, "syslog NOTICE no priority") && result;
+
+   Category::shutdown();
+   int status = -1;
+   if (collector > 0)
+   {
+      kill(collector, SIGTERM);
+      waitpid(collector, &status, 0);
+   }
+   result = check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "collector stopped") && result;
+   result = check(access(events_path, F_OK) != 0, "sockets removed") && result;
+
+   unlink(config_path);
+   unlink(log_path);
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_UN_H
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "log4cpp-collectd not available on this platform.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
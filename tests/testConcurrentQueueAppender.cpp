@@ -0,0 +1,173 @@
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/ConcurrentQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#include <poll.h>
+#include <sched.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+bool test_overflow()
+{
+   Category& cat = Category::getInstance("queue.overflow");
+   cat.setAdditivity(false);
+   ConcurrentQueueAppender* appender = new ConcurrentQueueAppender("queue", 6);
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   cat.addAppender(appender);
+
+   char message[16];
+   for (int i = 0; i < 20; i++)
+   {
+      sprintf(message, "%d", i);
+      cat.info(message);
+   }
+
+   bool result = check(appender->getCapacity() == 8, "capacity rounded up");
+   result = check(appender->getOverflows() == 12, "overflows counted") && result;
+   result = check(appender->queueSize() == 8, "queue size") && result;
+
+   vector<string> messages;
+   result = check(appender->drain(messages, 3) == 3 && appender->drain(messages, 100) == 5, "drained") && result;
+   result = check(messages.size() == 8 && messages[0] == "0" && messages[7] == "7", "in order") && result;
+   string last;
+   result = check(!appender->popMessage(last) && appender->queueSize() == 0, "empty") && result;
+
+   cat.info("again");
+   result = check(appender->popMessage(last) && last == "again", "reused") && result;
+   cat.removeAllAppenders();
+   return result;
+}
+
+#ifdef LOG4CPP_USE_PTHREADS
+const int PRODUCERS = 4;
+const int EVENTS = 20000;
+threading::Atomic<bool> producing(true);
+
+struct context
+{
+   ConcurrentQueueAppender* appender;
+   Category* category;
+   int producer;
+   vector<int> counts;
+   bool duplicates;
+};
+
+void* produce(void* argument)
+{
+   context* c = static_cast<context*>(argument);
+   char message[32];
+   for (int i = 0; i < EVENTS; i++)
+   {
+      sprintf(message, "%d %d", c->producer, i);
+      c->category->info(message);
+      if (i % 64 == 0)
+         sched_yield();
+   }
+   return NULL;
+}
+
+// consumes until the producers are done and the queue is empty
+void* consume(void* argument)
+{
+   context* c = static_cast<context*>(argument);
+   vector<int> next(PRODUCERS, 0);
+   vector<string> messages;
+   struct pollfd p;
+   p.fd = c->appender->getEventFd();
+   p.events = POLLIN;
+   for (;;)
+   {
+      messages.clear();
+      if (c->appender->drain(messages, 256) == 0)
+      {
+         if (!producing.load())
+         {
+            // a last look for messages logged meanwhile
+            if (c->appender->drain(messages, 256) == 0)
+               break;
+         }
+         else
+         {
+            poll(&p, 1, 10);
+            continue;
+         }
+      }
+      for (size_t i = 0; i < messages.size(); i++)
+      {
+         int producer = atoi(messages[i].c_str());
+         int sequence = atoi(messages[i].c_str() + messages[i].find(' '));
+         // per producer, messages arrive in order
+         if (sequence < next[producer])
+            c->duplicates = true;
+         next[producer] = sequence + 1;
+         c->counts[producer]++;
+      }
+   }
+   return NULL;
+}
+
+bool test_concurrent()
+{
+   Category& cat = Category::getInstance("queue.concurrent");
+   cat.setAdditivity(false);
+   ConcurrentQueueAppender* appender = new ConcurrentQueueAppender("queue", 1024, true);
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   cat.addAppender(appender);
+
+   context consumer;
+   consumer.appender = appender;
+   consumer.counts.resize(PRODUCERS, 0);
+   consumer.duplicates = false;
+   pthread_t consumer_thread;
+   pthread_create(&consumer_thread, NULL, &consume, &consumer);
+
+   context producers[PRODUCERS];
+   pthread_t threads[PRODUCERS];
+   for (int i = 0; i < PRODUCERS; i++)
+   {
+      producers[i].category = &cat;
+      producers[i].producer = i;
+      pthread_create(&threads[i], NULL, &produce, &producers[i]);
+   }
+   for (int i = 0; i < PRODUCERS; i++)
+      pthread_join(threads[i], NULL);
+   producing.store(false);
+   pthread_join(consumer_thread, NULL);
+
+   int received = 0;
+   for (int i = 0; i < PRODUCERS; i++)
+      received += consumer.counts[i];
+
+   bool result = check(received + appender->getOverflows() == PRODUCERS * EVENTS, "every message accounted for");
+   result = check(!consumer.duplicates, "no duplicates or reordering") && result;
+#ifdef LOG4CPP_HAVE_SYS_EVENTFD_H
+   result = check(appender->getEventFd() >= 0, "eventfd") && result;
+#endif
+   cat.removeAllAppenders();
+   return result;
+}
+#endif
+
+int main()
+{
+   bool result = test_overflow();
+#ifdef LOG4CPP_USE_PTHREADS
+   result = test_concurrent() && result;
+#endif
+   return result ? 0 : -1;
+}
@@ -0,0 +1,54 @@
+#include <log4cpp/ExecutionContext.hh>
+#include <log4cpp/NDC.hh>
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// as a fiber library would, knows which fiber runs
+struct FiberStorage : public ExecutionContext::Storage
+{
+   FiberStorage() : running(NULL) {}
+
+   virtual ExecutionContext* get()
+   {
+      return running;
+   }
+
+   ExecutionContext* running;
+};
+
+int main()
+{
+   NDC::push("thread");
+
+   // two coroutines interleaved on this thread
+   ExecutionContext first, second;
+   ExecutionContext* previous = ExecutionContext::swap(&first);
+   bool result = check(previous == NULL && NDC::get() == "", "fresh context");
+   NDC::push("first");
+   previous = ExecutionContext::swap(&second);
+   result = check(previous == &first, "swapped") && result;
+   NDC::push("second");
+   ExecutionContext::swap(&first);
+   NDC::push("again");
+   result = check(NDC::get() == "first again", "resumed") && result;
+   ExecutionContext::swap(NULL);
+   result = check(NDC::get() == "thread", "thread context untouched") && result;
+   result = check(second.getNDC()._get() == "second", "suspended context kept") && result;
+
+   FiberStorage storage;
+   ExecutionContext::setStorage(&storage);
+   result = check(NDC::get() == "thread", "storage without fiber") && result;
+   storage.running = &second;
+   result = check(NDC::get() == "second" && &ExecutionContext::getCurrent() == &second, "storage") && result;
+   NDC::pop();
+   storage.running = NULL;
+   ExecutionContext::setStorage(NULL);
+   result = check(second.getNDC()._getDepth() == 0 && NDC::get() == "thread", "fiber popped") && result;
+
+   NDC::clear();
+   return result ? 0 : -1;
+}
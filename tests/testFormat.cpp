@@ -0,0 +1,77 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/Format.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+struct Point {
+   int x, y;
+};
+
+ostream& operator<<(ostream& out, const Point& point)
+{
+   return out << "(" << point.x << "," << point.y << ")";
+}
+
+int main()
+{
+   Category& category = Category::getInstance("format");
+   StringQueueAppender* appender = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   category.setAdditivity(false);
+   category.addAppender(appender);
+   category.setPriority(Priority::INFO);
+
+   // printf style, on the stack and beyond it
+   category.info("%s took %dms", "query", 42);
+   bool result = check(appender->popMessage() == "query took 42ms", "printf");
+   std::string huge(3000, 'x');
+   category.info("<%s>", huge.c_str());
+   result = check(appender->popMessage() == "<" + huge + ">", "printf on the heap") && result;
+
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+   category.logf(Priority::INFO, "{} took {}ms", "query", 42);
+   result = check(appender->popMessage() == "query took 42ms", "logf") && result;
+
+   LOG4CPP_LOGF(category, Priority::INFO, "{{{}}} {} {} {}", std::string("braces"), true, 'c', -7L);
+   result = check(appender->popMessage() == "{braces} true c -7", "checked") && result;
+
+   category.logf(Priority::DEBUG, "{}", "disabled");
+   result = check(appender->queueSize() == 0, "not enabled") && result;
+
+   FormatBuffer buffer;
+   const char* null = NULL;
+   formatTo(buffer, "{} {} {} {} {} {}", 0, -9223372036854775807LL - 1, 18446744073709551615ULL,
+            static_cast<unsigned char>(200), null, Point{1, 2});
+   result = check(buffer.str() == "0 -9223372036854775808 18446744073709551615 200 (null) (1,2)",
+                  "integers and others") && result;
+
+   buffer.clear();
+   formatTo(buffer, "{} {} {} {} {}", 1.5, 0.1, 0.1f, 1e20, 3.0);
+   std::string floats = buffer.str();
+   result = check(floats.find("1.5 0.1 0.1 1") == 0 && floats.find("e+20 3") != std::string::npos,
+                  "floats") && result;
+
+   buffer.clear();
+   formatTo(buffer, "{} and {}", 1);
+   result = check(buffer.str() == "1 and {}", "missing argument") && result;
+   buffer.clear();
+   formatTo(buffer, "{}", 1, 2);
+   result = check(buffer.str() == "1 2", "extra argument") && result;
+
+   buffer.clear();
+   formatTo(buffer, "{}{}", huge, huge);
+   result = check(buffer.size() == 2 * huge.size() && buffer.str() == huge + huge, "grown") && result;
+
+   result = check(countPlaceholders("{} {{}} {}") == 2, "counted") && result;
+#endif
+
+   return result ? 0 : -1;
+}
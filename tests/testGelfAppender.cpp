@@ -0,0 +1,186 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/GelfAppender.hh>
+#include <log4cpp/NDC.hh>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#ifdef LOG4CPP_HAVE_LIBZ
+#include <zlib.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+int open_socket(int type, unsigned short& port)
+{
+   int fd = socket(AF_INET, type, 0);
+   struct sockaddr_in address;
+   memset(&address, 0, sizeof(address));
+   address.sin_family = AF_INET;
+   address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   socklen_t length = sizeof(address);
+   if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+       (type == SOCK_STREAM && listen(fd, 1) < 0) ||
+       getsockname(fd, (struct sockaddr*)&address, &length) < 0)
+   {
+      close(fd);
+      return -1;
+   }
+   port = ntohs(address.sin_port);
+   return fd;
+}
+
+// the next datagram, or an empty string
+string receive(int fd)
+{
+   struct pollfd p;
+   p.fd = fd;
+   p.events = POLLIN;
+   char buffer[65536];
+   ssize_t n;
+   if (poll(&p, 1, 1000) <= 0 || (n = recv(fd, buffer, sizeof(buffer), 0)) <= 0)
+      return "";
+   return string(buffer, n);
+}
+
+bool test_udp()
+{
+   unsigned short port;
+   int fd = open_socket(SOCK_DGRAM, port);
+   if (!check(fd >= 0, "udp socket"))
+      return false;
+
+   Category& cat = Category::getInstance("gelf.udp");
+   cat.setAdditivity(false);
+   GelfAppender* appender = new GelfAppender("gelf", "127.0.0.1", port, GelfAppender::UDP,
+                                             GelfAppender::NONE, 1000);
+   appender->setSource("test-host");
+   cat.addAppender(appender);
+
+   NDC::push("request 7");
+   cat.error("short \"quoted\"");
+   NDC::clear();
+   string message = receive(fd);
+   bool result = check(message.compare(0, 51, "{\"version\":\"1.1\",\"host\":\"test-host\",\"short_message\"") == 0,
+                       "gelf header");
+   result = check(message.find("\"short_message\":\"short \\\"quoted\\\"\"") != string::npos, "escaped") && result;
+   result = check(message.find("\"level\":3,\"_category\":\"gelf.udp\",\"_priority\":\"ERROR\"") != string::npos,
+                  "level and fields") && result;
+   result = check(message.find("\"_ndc\":\"request 7\"}") != string::npos, "ndc") && result;
+   string::size_type dot = message.find("\"timestamp\":");
+   result = check(dot != string::npos && message[dot + 22] == '.' && message[dot + 29] == ',',
+                  "microsecond timestamp") && result;
+
+   // chunked: 988 bytes of payload per datagram
+   cat.warn(string(5000, 'x'));
+   string chunks[6], reassembled;
+   for (int i = 0; i < 6; i++)
+      chunks[i] = receive(fd);
+   for (int i = 0; i < 6; i++)
+   {
+      result = check(chunks[i].size() > 12 && chunks[i][0] == '\x1e' && chunks[i][1] == '\x0f' &&
+                     chunks[i][10] == i && chunks[i][11] == 6 &&
+                     chunks[i].compare(2, 8, chunks[0], 2, 8) == 0, "chunk header") && result;
+      if (chunks[i].size() > 12)
+         reassembled += chunks[i].substr(12);
+   }
+   result = check(chunks[0].size() == 1000, "chunk size") && result;
+   result = check(reassembled[0] == '{' && reassembled[reassembled.size() - 1] == '}' &&
+                  reassembled.find(string(5000, 'x')) != string::npos, "reassembled") && result;
+
+   // too many chunks
+   cat.warn(string(200000, 'x'));
+   appender->flush();
+   result = check(appender->getDropped() == 1, "dropped beyond 128 chunks") && result;
+
+#ifdef LOG4CPP_HAVE_LIBZ
+   GelfAppender* compressed = new GelfAppender("gelf-gzip", "127.0.0.1", port, GelfAppender::UDP,
+                                               GelfAppender::GZIP);
+   Category& other = Category::getInstance("gelf.gzip");
+   other.setAdditivity(false);
+   other.addAppender(compressed);
+   other.error("compressed");
+   message = receive(fd);
+   result = check(message.size() > 2 && message[0] == '\x1f' && message[1] == '\x8b', "gzip magic") && result;
+
+   char raw[4096];
+   z_stream stream;
+   memset(&stream, 0, sizeof(stream));
+   inflateInit2(&stream, 15 + 16);
+   stream.next_in = (Bytef*)message.data();
+   stream.avail_in = message.size();
+   stream.next_out = (Bytef*)raw;
+   stream.avail_out = sizeof(raw);
+   result = check(inflate(&stream, Z_FINISH) == Z_STREAM_END &&
+                  string(raw, stream.total_out).find("\"short_message\":\"compressed\"") != string::npos,
+                  "gzip payload") && result;
+   inflateEnd(&stream);
+   other.removeAllAppenders();
+#endif
+
+   cat.removeAllAppenders();
+   close(fd);
+   return result;
+}
+
+bool test_tcp()
+{
+   unsigned short port;
+   int listener = open_socket(SOCK_STREAM, port);
+   if (!check(listener >= 0, "tcp socket"))
+      return false;
+
+   Category& cat = Category::getInstance("gelf.tcp");
+   cat.setAdditivity(false);
+   // compression is ignored over TCP
+   cat.addAppender(new GelfAppender("gelf", "127.0.0.1", port, GelfAppender::TCP, GelfAppender::ZLIB));
+   int connection = accept(listener, NULL, NULL);
+
+   cat.error("first");
+   cat.error("second");
+   cat.removeAllAppenders();
+
+   string stream;
+   char buffer[4096];
+   ssize_t n;
+   while ((n = read(connection, buffer, sizeof(buffer))) > 0)
+      stream.append(buffer, n);
+   close(connection);
+   close(listener);
+
+   string::size_type first = stream.find('\0');
+   bool result = check(first != string::npos && stream.find('\0', first + 1) == stream.size() - 1,
+                       "null byte framing");
+   result = check(stream[0] == '{' && stream.find("\"short_message\":\"first\"") < first &&
+                  stream.find("\"short_message\":\"second\"") > first, "messages") && result;
+   return result;
+}
+
+int main()
+{
+   bool result = test_udp();
+   result = test_tcp() && result;
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_UN_H
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "GelfAppender not available in this build.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
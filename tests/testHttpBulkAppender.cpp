@@ -0,0 +1,259 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#if defined(LOG4CPP_HAVE_SYS_UN_H) && defined(LOG4CPP_USE_PTHREADS)
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/HttpBulkAppender.hh>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#ifdef LOG4CPP_HAVE_LIBZ
+#include <zlib.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// a local HTTP stand-in answering the first request with 503
+struct http_server
+{
+   int listener;
+   unsigned short port;
+   int connections;
+   int requests;
+   vector<string> bodies;
+   vector<string> headers;
+   pthread_mutex_t mutex;
+
+   http_server() : listener(-1), port(0), connections(0), requests(0)
+   {
+      pthread_mutex_init(&mutex, NULL);
+      listener = socket(AF_INET, SOCK_STREAM, 0);
+      struct sockaddr_in address;
+      memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      socklen_t length = sizeof(address);
+      if (bind(listener, (struct sockaddr*)&address, sizeof(address)) == 0 && listen(listener, 4) == 0 &&
+          getsockname(listener, (struct sockaddr*)&address, &length) == 0)
+         port = ntohs(address.sin_port);
+   }
+
+   ~http_server()
+   {
+      close(listener);
+      pthread_mutex_destroy(&mutex);
+   }
+
+   size_t received(const char* what)
+   {
+      pthread_mutex_lock(&mutex);
+      size_t count = 0;
+      for (size_t i = 0; i < bodies.size(); i++)
+         for (string::size_type p = bodies[i].find(what); p != string::npos; p = bodies[i].find(what, p + 1))
+            count++;
+      pthread_mutex_unlock(&mutex);
+      return count;
+   }
+
+   static string gunzip(const string& data)
+   {
+#ifdef LOG4CPP_HAVE_LIBZ
+      string result;
+      z_stream stream;
+      memset(&stream, 0, sizeof(stream));
+      inflateInit2(&stream, 15 + 16);
+      stream.next_in = (Bytef*)data.data();
+      stream.avail_in = data.size();
+      char buffer[4096];
+      int status;
+      do
+      {
+         stream.next_out = (Bytef*)buffer;
+         stream.avail_out = sizeof(buffer);
+         status = inflate(&stream, Z_NO_FLUSH);
+         result.append(buffer, sizeof(buffer) - stream.avail_out);
+      } while (status == Z_OK);
+      inflateEnd(&stream);
+      return result;
+#else
+      return data;
+#endif
+   }
+
+   void serve(int fd)
+   {
+      string input;
+      char buffer[4096];
+      for (;;)
+      {
+         string::size_type end;
+         ssize_t n;
+         while ((end = input.find("\r\n\r\n")) == string::npos)
+         {
+            if ((n = read(fd, buffer, sizeof(buffer))) <= 0)
+               return;
+            input.append(buffer, n);
+         }
+         string header = input.substr(0, end);
+         input.erase(0, end + 4);
+         string::size_type p = header.find("Content-Length: ");
+         size_t length = (p == string::npos) ? 0 : atoi(header.c_str() + p + 16);
+         while (input.size() < length)
+         {
+            if ((n = read(fd, buffer, sizeof(buffer))) <= 0)
+               return;
+            input.append(buffer, n);
+         }
+         string body = input.substr(0, length);
+         input.erase(0, length);
+
+         pthread_mutex_lock(&mutex);
+         bool first = (requests++ == 0);
+         if (!first)
+         {
+            headers.push_back(header);
+            bodies.push_back(header.find("Content-Encoding: gzip") != string::npos ? gunzip(body) : body);
+         }
+         pthread_mutex_unlock(&mutex);
+
+         const char* response = first ?
+            "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n" :
+            "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2\r\n{}\r\n0\r\n\r\n";
+         if (write(fd, response, strlen(response)) < 0)
+            return;
+      }
+   }
+
+   // serves connections one at a time until none comes for a second
+   static void* run(void* server)
+   {
+      http_server* self = static_cast<http_server*>(server);
+      struct pollfd p;
+      p.fd = self->listener;
+      p.events = POLLIN;
+      while (poll(&p, 1, 1000) > 0)
+      {
+         int fd = accept(self->listener, NULL, NULL);
+         if (fd < 0)
+            break;
+         pthread_mutex_lock(&self->mutex);
+         self->connections++;
+         pthread_mutex_unlock(&self->mutex);
+         self->serve(fd);
+         close(fd);
+      }
+      return NULL;
+   }
+};
+
+string url(const http_server& server)
+{
+   char buffer[64];
+   sprintf(buffer, "http://127.0.0.1:%u/_bulk", server.port);
+   return buffer;
+}
+
+bool test_batches()
+{
+   http_server server;
+   pthread_t thread;
+   pthread_create(&thread, NULL, &http_server::run, &server);
+
+   Category& cat = Category::getInstance("http.test");
+   cat.setAdditivity(false);
+   HttpBulkAppender* appender = new HttpBulkAppender("http", url(server), HttpBulkAppender::NDJSON, 512, 50);
+   appender->setActionLine("{\"index\":{}}");
+   appender->setGzip(true);
+   cat.addAppender(appender);
+
+   for (int i = 0; i < 10; i++)
+      cat.warnStream() << "event \"" << i << "\"\n";
+   for (int i = 0; i < 100 && server.received("\"message\":") < 10; i++)
+      usleep(50000);
+
+   cat.removeAllAppenders();
+   pthread_join(thread, NULL);
+
+   bool result = check(server.received("\"message\":") == 10, "all events delivered after a retry");
+   result = check(server.received("{\"index\":{}}\n{\"timestamp\":") == 10, "action lines") && result;
+   result = check(server.received("\"message\":\"event \\\"9\\\"\\n\"") == 1, "message escaped") && result;
+   result = check(server.received("\"priority\":\"WARN\",\"category\":\"http.test\"") == 10, "fields") && result;
+   result = check(server.bodies.size() > 1, "split into batches") && result;
+   result = check(server.connections == 1, "connection kept alive") && result;
+#ifdef LOG4CPP_HAVE_LIBZ
+   result = check(server.headers[0].find("Content-Encoding: gzip") != string::npos, "gzip") && result;
+#endif
+   return result;
+}
+
+bool test_budget()
+{
+   http_server server;
+   // accept the first request right away
+   server.requests = 1;
+   pthread_t thread;
+   pthread_create(&thread, NULL, &http_server::run, &server);
+
+   // room for four events, sent when closing
+   string message(1000, 'x');
+   Category& cat = Category::getInstance("http.budget");
+   cat.setAdditivity(false);
+   cat.setPriority(Priority::DEBUG);
+   HttpBulkAppender* appender = new HttpBulkAppender("http", url(server), HttpBulkAppender::JSON_ARRAY,
+                                                     1024 * 1024, 3600 * 1000, 4 * 1200);
+   cat.addAppender(appender);
+
+   for (int i = 0; i < 4; i++)
+      cat.debug(message);
+   // each replaces a debug event
+   for (int i = 0; i < 4; i++)
+      cat.error(message);
+   // neither is more important than what is waiting
+   cat.debug(message);
+   cat.error(message);
+
+   bool result = check(appender->getDropped() == 6, "dropped by priority");
+   appender->close();
+   cat.removeAllAppenders();
+   pthread_join(thread, NULL);
+
+   result = check(server.bodies.size() == 1, "one batch") && result;
+   if (server.bodies.size() == 1)
+   {
+      result = check(server.bodies[0][0] == '[' && server.bodies[0][server.bodies[0].size() - 1] == ']',
+                     "json array") && result;
+      result = check(server.received("\"ERROR\"") == 4 && server.received("\"DEBUG\"") == 0,
+                     "errors kept") && result;
+   }
+   return result;
+}
+
+int main()
+{
+   bool result = test_batches();
+   result = test_budget() && result;
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_UN_H && LOG4CPP_USE_PTHREADS
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "HttpBulkAppender not available in this build.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H && LOG4CPP_USE_PTHREADS
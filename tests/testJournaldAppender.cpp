@@ -0,0 +1,155 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/JournaldAppender.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/MDC.hh>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+using namespace log4cpp;
+using namespace std;
+
+static const char* const socket_path = "journald_test.socket";
+
+int open_receiver()
+{
+   unlink(socket_path);
+   int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+   if (fd < 0)
+      return -1;
+
+   struct sockaddr_un address;
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+   if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0)
+   {
+      close(fd);
+      return -1;
+   }
+
+   return fd;
+}
+
+// receives one datagram, reading the payload from a passed memfd if any
+bool receive(int fd, string& payload)
+{
+   static char data[65536];
+   union {
+      struct cmsghdr header;
+      char space[CMSG_SPACE(sizeof(int))];
+   } control;
+
+   struct iovec iov;
+   iov.iov_base = data;
+   iov.iov_len = sizeof(data);
+
+   struct msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = &iov;
+   msg.msg_iovlen = 1;
+   msg.msg_control = &control;
+   msg.msg_controllen = sizeof(control);
+
+   ssize_t n = recvmsg(fd, &msg, MSG_DONTWAIT);
+   if (n < 0)
+      return false;
+
+   struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+   if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+   {
+      int memfd;
+      memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+      struct stat st;
+      fstat(memfd, &st);
+      payload.resize(st.st_size);
+      ssize_t r = pread(memfd, &payload[0], st.st_size, 0);
+      close(memfd);
+      return r == st.st_size;
+   }
+
+   payload.assign(data, n);
+   return true;
+}
+
+bool contains(const string& payload, const string& field)
+{
+   if (payload.find(field) == string::npos)
+   {
+      cout << "field '" << field << "' not found\n";
+      return false;
+   }
+   return true;
+}
+
+int main()
+{
+   int receiver = open_receiver();
+   if (receiver < 0)
+   {
+      cout << "Can't bind local receiver socket '" << socket_path << "'.\n";
+      return -1;
+   }
+
+   Category& cat = Category::getInstance("journald.test");
+   cat.setAdditivity(false);
+   cat.addAppender(new JournaldAppender("journald", "testJournald", socket_path));
+
+   bool result = true;
+   string payload;
+
+   NDC::push("ndc1");
+   MDC::put("request.id", "42");
+   cat.error("hello journal");
+   MDC::clear();
+   NDC::clear();
+   result = receive(receiver, payload) &&
+            contains(payload, "MESSAGE=hello journal\n") &&
+            contains(payload, "PRIORITY=3\n") &&
+            contains(payload, "SYSLOG_IDENTIFIER=testJournald\n") &&
+            contains(payload, "LOG4CPP_CATEGORY=journald.test\n") &&
+            contains(payload, "LOG4CPP_NDC=ndc1\n") &&
+            contains(payload, "LOG4CPP_THREAD=") &&
+            contains(payload, "LOG4CPP_MDC_REQUEST_ID=42\n") && result;
+
+   // multi line messages use the binary safe field encoding
+   cat.info("line1\nline2");
+   result = receive(receiver, payload) &&
+            contains(payload, string("MESSAGE\n\x0b\0\0\0\0\0\0\0line1\nline2\n", 23)) &&
+            contains(payload, "PRIORITY=6\n") && result;
+
+   // too large for a single datagram: passed in a memfd
+   string large(1024 * 1024, 'x');
+   cat.warn(large);
+#ifdef LOG4CPP_HAVE_MEMFD_CREATE
+   result = receive(receiver, payload) &&
+            contains(payload, "MESSAGE=" + large + "\n") &&
+            contains(payload, "PRIORITY=4\n") && result;
+#endif
+
+   Category::shutdown();
+   close(receiver);
+   unlink(socket_path);
+
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_UN_H
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "JournaldAppender not available on this platform.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
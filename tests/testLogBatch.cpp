@@ -0,0 +1,83 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/FixedContextCategory.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// an appender counting the batches it receives
+class BatchCountingAppender : public StringQueueAppender
+{
+   public:
+      BatchCountingAppender(const string& name) : StringQueueAppender(name), batches(0) {}
+
+      int batches;
+
+   protected:
+      virtual void _appendBatch(const LoggingEvent* const* events, size_t count)
+      {
+         batches++;
+         StringQueueAppender::_appendBatch(events, count);
+      }
+};
+
+BatchCountingAppender* attach(Category& category, const char* pattern, const char* name)
+{
+   BatchCountingAppender* appender = new BatchCountingAppender(name);
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern(pattern);
+   appender->setLayout(layout);
+   category.addAppender(appender);
+   return appender;
+}
+
+int main()
+{
+   Category& parent = Category::getInstance("batch");
+   Category& child = Category::getInstance("batch.child");
+   parent.setAdditivity(false);
+   parent.setPriority(Priority::INFO);
+   BatchCountingAppender* parentAppender = attach(parent, "%c %p %m", "parent");
+   BatchCountingAppender* childAppender = attach(child, "%m", "child");
+
+   vector<string> lines;
+   for (int i = 0; i < 1000; i++)
+      lines.push_back("line " + string(1, static_cast<char>('a' + i % 26)));
+
+   child.logBatch(Priority::INFO, lines.begin(), lines.end());
+   bool result = check(childAppender->batches == 1 && parentAppender->batches == 1, "one batch each");
+   result = check(childAppender->queueSize() == 1000 && parentAppender->queueSize() == 1000, "all events") && result;
+   result = check(childAppender->popMessage() == "line a" && childAppender->popMessage() == "line b" &&
+                  parentAppender->popMessage() == "batch.child INFO line a", "in order") && result;
+
+   child.logBatch(Priority::DEBUG, lines.begin(), lines.end());
+   result = check(childAppender->batches == 1, "disabled") && result;
+
+   // other iterators and message types, reusing the thread's batch
+   list<const char*> literals;
+   literals.push_back("first");
+   literals.push_back("second");
+   NDC::push("context");
+   child.logBatch(Priority::WARN, literals.begin(), literals.end());
+   NDC::pop();
+   result = check(childAppender->batches == 2 && childAppender->queueSize() == 1000, "literals") && result;
+   result = check(parentAppender->getQueue().back() == "batch.child WARN second", "latest") && result;
+
+   child.logBatch(Priority::INFO, lines.end(), lines.end());
+   result = check(childAppender->batches == 2, "empty") && result;
+
+   // a fixed context category logs to the appenders of its delegate
+   BatchCountingAppender* contextAppender = attach(child, "%x %m", "context");
+   FixedContextCategory fixed("batch.child", "fixed");
+   fixed.logBatch(Priority::ERROR, literals.begin(), literals.end());
+   result = check(contextAppender->batches == 1 && contextAppender->popMessage() == "fixed first",
+                  "fixed context") && result;
+
+   return result ? 0 : -1;
+}
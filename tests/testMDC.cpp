@@ -0,0 +1,59 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/MDC.hh>
+#include <log4cpp/ExecutionContext.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+int main()
+{
+   Category& category = Category::getInstance("mdc");
+   StringQueueAppender* appender = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%X{request} %X{tenant}|%X|%m");
+   appender->setLayout(layout);
+   category.setAdditivity(false);
+   category.addAppender(appender);
+
+   bool result = check(MDC::key("request") == MDC::key(std::string("request")), "interned");
+
+   category.info("none");
+   result = check(appender->popMessage() == " |{}|none", "empty") && result;
+
+   MDC::Key request = MDC::key("request");
+   MDC::put(request, "r1");
+   MDC::put("tenant", "acme");
+   LoggingEvent first("mdc", "first", "", Priority::INFO);
+   category.info("logged");
+   result = check(appender->popMessage() == "r1 acme|{request=r1, tenant=acme}|logged", "formatted") && result;
+
+   // events keep what was put when they were made
+   MDC::put(request, "r2");
+   MDC::remove("tenant");
+   result = check(first.mdc.get(request) == "r1" && first.mdc.get("tenant") == "acme" && first.mdc.size() == 2,
+                  "snapshot unchanged") && result;
+   result = check(MDC::get("request") == "r2" && MDC::get("tenant") == "" && MDC::getSnapshot().size() == 1,
+                  "copied on write") && result;
+
+   // shared until changed
+   LoggingEvent second("mdc", "second", "", Priority::INFO);
+   LoggingEvent third("mdc", "third", "", Priority::INFO);
+   result = check(&second.mdc.get(request) == &third.mdc.get(request), "shared") && result;
+
+   ExecutionContext other;
+   ExecutionContext::swap(&other);
+   result = check(MDC::getSnapshot().empty(), "per context") && result;
+   ExecutionContext::swap(NULL);
+   result = check(MDC::get("request") == "r2", "back") && result;
+
+   MDC::clear();
+   result = check(MDC::getSnapshot().empty() && second.mdc.get("request") == "r2", "cleared") && result;
+
+   Category::shutdown();
+   return result ? 0 : -1;
+}
@@ -0,0 +1,74 @@
+#include <log4cpp/Portability.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include <iostream>
+#include <sstream>
+#include <string>
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+#ifdef LOG4CPP_USE_PTHREADS
+struct handover
+{
+   NDC::ContextStack* stack;
+   std::string seen;
+};
+
+void* worker(void* argument)
+{
+   handover* h = static_cast<handover*>(argument);
+   NDC::inherit(h->stack);
+   NDC::push("worker");
+   h->seen = NDC::get();
+   return NULL;
+}
+#endif
+
+int main()
+{
+   NDC::push("request");
+   NDC::push("user");
+   bool result = check(NDC::get() == "request user" && NDC::getDepth() == 2, "pushed");
+
+   NDC::ContextStack* clone = NDC::cloneStack();
+   LoggingEvent event(SharedString(std::string("category")), SharedString(std::string("message")),
+                      NDC::getStack(), Priority::INFO);
+   result = check(event.ndc.top() == clone->top(), "events share the contexts") && result;
+
+   NDC::pop();
+   NDC::push("other");
+   // what was taken before is unaffected
+   result = check(event.ndc == "request user" && clone->str() == "request user", "snapshots") && result;
+   result = check(event.ndc.size() == 12 && event.ndc.depth() == 2, "size and depth") && result;
+   result = check(NDC::get() == "request other", "replaced") && result;
+   result = check(event.ndc.top()->parent == NDC::getStack().top()->parent, "outer context shared") && result;
+
+   std::ostringstream streamed;
+   streamed << event.ndc;
+   result = check(streamed.str() == "request user", "streamed") && result;
+
+#ifdef LOG4CPP_USE_PTHREADS
+   handover h;
+   h.stack = clone;
+   pthread_t thread;
+   pthread_create(&thread, NULL, &worker, &h);
+   pthread_join(thread, NULL);
+   result = check(h.seen == "request user worker", "inherited") && result;
+#endif
+   delete clone;
+
+   // released without recursing through the levels
+   for (int i = 0; i < 200000; i++)
+      NDC::push("deep");
+   result = check(NDC::getDepth() == 200002, "deep") && result;
+   NDC::clear();
+   result = check(NDC::get() == "" && NDC::getDepth() == 0 && NDC::pop() == "", "cleared") && result;
+
+   result = check(LoggingEvent("category", "message", "", Priority::INFO).ndc.empty(), "no context") && result;
+   return result ? 0 : -1;
+}
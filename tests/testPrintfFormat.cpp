@@ -0,0 +1,93 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/PrintfFormat.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+string compiled(const PrintfFormat* format, ...)
+{
+   FormatBuffer buffer;
+   va_list va;
+   va_start(va, format);
+   format->format(buffer, va);
+   va_end(va);
+   return buffer.str();
+}
+
+string printed(const char* format, ...)
+{
+   char buffer[8192];
+   va_list va;
+   va_start(va, format);
+   vsnprintf(buffer, sizeof(buffer), format, va);
+   va_end(va);
+   return buffer;
+}
+
+// renders the same arguments both ways
+#define CHECK_FORMAT(compiledOnly, format, ...) \
+   do { \
+      PrintfFormat parsed(format); \
+      string expected = printed(format, __VA_ARGS__); \
+      string actual = compiled(&parsed, __VA_ARGS__); \
+      bool same = (actual == expected) && parsed.isCompiled() == compiledOnly; \
+      if (!check(same, format)) \
+         cout << "  expected '" << expected << "', got '" << actual << "'\n"; \
+      result = same && result; \
+   } while (0)
+
+int main()
+{
+   bool result = true;
+   const char* null = NULL;
+   string huge(3000, 'x');
+
+   CHECK_FORMAT(true, "%s: %d items in %.3f s", "batch", 42, 1.23456);
+   CHECK_FORMAT(true, "%d %i %u %d %d", 0, -1, 4294967295U, -2147483647 - 1, 2147483647);
+   CHECK_FORMAT(true, "%hhd %hd %hhu %hu", 300, 70000, 300, 70000);
+   CHECK_FORMAT(true, "%ld %lu %lld %llu", -5L, 5UL, -9223372036854775807LL - 1, 18446744073709551615ULL);
+   CHECK_FORMAT(true, "%zu %zd %td %jd %ju", (size_t)7, (ptrdiff_t)-7, (ptrdiff_t)-3, (intmax_t)-9, (uintmax_t)9);
+   CHECK_FORMAT(true, "%5d|%-5d|%05d|%+d|% d|%x|%X|%#o|%#x", 42, 42, 42, 42, 42, 255, 255, 8, 255);
+   CHECK_FORMAT(true, "%*d|%-*d|%.*d|%*.*d", 6, 1, 6, 2, 4, 3, 8, 5, 4);
+   CHECK_FORMAT(true, "%s|%10s|%-10s|%.2s|%s", "abc", "abc", "abc", "abc", null);
+   CHECK_FORMAT(true, "%c%c%5c|%-3c|", 'a', 'b', 'c', 'd');
+   CHECK_FORMAT(true, "%f %e %g %E %G %.0f %10.4f %a", 3.14159, 31415.9, 0.0001, 2.5, 1e20, 2.5, -1.0, 1.0);
+   CHECK_FORMAT(true, "%Lf %Lg", (long double)1.5, (long double)1e-5);
+   CHECK_FORMAT(true, "%p %p", (void*)&result, null);
+   CHECK_FORMAT(true, "100%% %d%%%s", 5, "done");
+   CHECK_FORMAT(true, "<%s>", huge.c_str());
+   CHECK_FORMAT(true, "%s", "no conversions at all");
+   CHECK_FORMAT(false, "%2$s %1$s", "world", "hello");
+   CHECK_FORMAT(false, "%ls", L"wide");
+
+   // the call site parses the format once
+   Category& category = Category::getInstance("printf");
+   StringQueueAppender* appender = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%m");
+   appender->setLayout(layout);
+   category.setAdditivity(false);
+   category.addAppender(appender);
+   category.setPriority(Priority::INFO);
+
+#ifdef LOG4CPP_HAVE_VARIADIC_MACROS
+   for (int i = 0; i < 3; ++i)
+      LOG4CPP_INFO_F(category, "%s: %d items in %.3f s", "batch", i, 0.5);
+   result = check(appender->queueSize() == 3 && appender->popMessage() == "batch: 0 items in 0.500 s",
+                  "cached call site") && result;
+   LOG4CPP_DEBUG_F(category, "%s", "disabled");
+   LOG4CPP_INFO_F(category, "constant");
+   result = check(appender->queueSize() == 3 && appender->getQueue().back() == "constant",
+                  "no arguments") && result;
+#endif
+
+   return result ? 0 : -1;
+}
@@ -0,0 +1,114 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/LayoutAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/SimpleLayout.hh>
+#include <log4cpp/BasicLayout.hh>
+#include <log4cpp/Filter.hh>
+#include <log4cpp/NDC.hh>
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// an appender remembering the fields of the last event
+class RecordingAppender : public StringQueueAppender
+{
+   public:
+      RecordingAppender(const string& name) : StringQueueAppender(name), seconds(-1) {}
+
+      long long seconds;
+      string threadName;
+      string ndc;
+
+   protected:
+      virtual void _append(const LoggingEvent& event)
+      {
+         seconds = event.timeStamp.getSeconds();
+         threadName = event.threadName;
+         ndc = event.ndc;
+         StringQueueAppender::_append(event);
+      }
+};
+
+// an appender of its own, which may read any field
+class OwnAppender : public LayoutAppender
+{
+   public:
+      OwnAppender() : LayoutAppender("own") {}
+
+      virtual void close() {}
+
+      string threadName;
+
+   protected:
+      virtual void _append(const LoggingEvent& event) { threadName = event.threadName; }
+};
+
+class AcceptingFilter : public Filter
+{
+   protected:
+      virtual Decision _decide(const LoggingEvent&) { return ACCEPT; }
+};
+
+int main()
+{
+   Category& parent = Category::getInstance("fields");
+   Category& child = Category::getInstance("fields.child");
+   parent.setAdditivity(false);
+   parent.setPriority(Priority::INFO);
+
+   RecordingAppender* appender = new RecordingAppender("fields");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%p %m");
+   appender->setLayout(layout);
+   child.addAppender(appender);
+
+   NDC::push("context");
+   child.info("bare");
+   bool result = check(child.getRequiredFields() == 0, "none required");
+   result = check(appender->seconds == 0 && appender->threadName.empty() && appender->ndc.empty(),
+                  "none captured") && result;
+   result = check(appender->popMessage() == "INFO bare", "message") && result;
+
+   layout->setConversionPattern("%d{%H} %t %x %m");
+   child.info("full");
+   result = check(child.getRequiredFields() ==
+                  (LoggingEvent::FIELD_TIMESTAMP | LoggingEvent::FIELD_THREAD | LoggingEvent::FIELD_NDC),
+                  "pattern fields") && result;
+   result = check(appender->seconds > 0 && !appender->threadName.empty() && appender->ndc == "context",
+                  "captured") && result;
+
+   // fields of the ancestors' appenders, while the child is additive
+   appender->setLayout(new SimpleLayout());
+   result = check(child.getRequiredFields() == 0, "simple layout") && result;
+   RecordingAppender* parentAppender = new RecordingAppender("parent");
+   parentAppender->setLayout(new BasicLayout());
+   parent.addAppender(parentAppender);
+   child.info("inherited");
+   result = check(child.getRequiredFields() == (LoggingEvent::FIELD_TIMESTAMP | LoggingEvent::FIELD_NDC),
+                  "inherited fields") && result;
+   result = check(appender->seconds > 0 && appender->ndc == "context" && appender->threadName.empty(),
+                  "inherited captured") && result;
+   child.setAdditivity(false);
+   result = check(child.getRequiredFields() == 0, "not additive") && result;
+
+   // filters may look at anything
+   appender->setFilter(new AcceptingFilter());
+   result = check(child.getRequiredFields() == LoggingEvent::ALL_FIELDS, "filter") && result;
+   appender->setFilter(NULL);
+   result = check(child.getRequiredFields() == 0, "no filter") && result;
+
+   // unless they say otherwise, appenders get all fields
+   OwnAppender* own = new OwnAppender();
+   own->setLayout(new SimpleLayout());
+   child.addAppender(own);
+   child.info("own");
+   result = check(child.getRequiredFields() == LoggingEvent::ALL_FIELDS, "own appender") && result;
+   result = check(!own->threadName.empty(), "own captured") && result;
+   NDC::pop();
+
+   return result ? 0 : -1;
+}
@@ -0,0 +1,133 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/LayoutAppender.hh>
+#include <log4cpp/PropertyConfigurator.hh>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// a layout counting how often it formats
+class CountingLayout : public PatternLayout
+{
+   public:
+      CountingLayout(bool& deleted) : formatted(0), _deleted(deleted)
+      {
+         setConversionPattern("%p %m");
+      }
+
+      virtual ~CountingLayout() { _deleted = true; }
+
+      virtual string format(const LoggingEvent& event)
+      {
+         formatted++;
+         return PatternLayout::format(event);
+      }
+
+      int formatted;
+
+   private:
+      bool& _deleted;
+};
+
+// whether the layout of a configured appender is shared, which formats
+// through the memo rather than with the PatternLayout itself
+class LayoutOf : public LayoutAppender
+{
+   public:
+      static bool shared(const char* name)
+      {
+         LayoutAppender* appender = dynamic_cast<LayoutAppender*>(Appender::getAppender(name));
+         return appender && !dynamic_cast<PatternLayout*>(&(appender->*(&LayoutOf::_getLayout))());
+      }
+};
+
+bool checkConfigured()
+{
+   const char* path = "sharedlayout_test.properties";
+   ofstream config(path);
+   config << "rootCategory=INFO\n"
+          << "category.configured=INFO, a, b, c\n"
+          << "appender.a=FileAppender\n"
+          << "appender.a.fileName=/dev/null\n"
+          << "appender.a.layout=PatternLayout\n"
+          << "appender.a.layout.ConversionPattern=%p %m%n\n"
+          << "appender.b=FileAppender\n"
+          << "appender.b.fileName=/dev/null\n"
+          << "appender.b.layout=PatternLayout\n"
+          << "appender.b.layout.ConversionPattern=%p %m%n\n"
+          << "appender.c=FileAppender\n"
+          << "appender.c.fileName=/dev/null\n"
+          << "appender.c.layout=PatternLayout\n"
+          << "appender.c.layout.ConversionPattern=%m%n\n";
+   config.close();
+   PropertyConfigurator::configure(path);
+   remove(path);
+
+   // the configurator shares identical layouts only
+   bool result = check(LayoutOf::shared("a") && LayoutOf::shared("b"), "configured shared");
+   result = check(!LayoutOf::shared("c"), "configured apart") && result;
+   return result;
+}
+
+int main()
+{
+   Category& parent = Category::getInstance("shared");
+   Category& child = Category::getInstance("shared.child");
+   parent.setAdditivity(false);
+   parent.setPriority(Priority::INFO);
+
+   bool deleted = false;
+   CountingLayout* layout = new CountingLayout(deleted);
+   StringQueueAppender* first = new StringQueueAppender("first");
+   StringQueueAppender* second = new StringQueueAppender("second");
+   StringQueueAppender* inherited = new StringQueueAppender("inherited");
+   first->setLayout(layout);
+   child.addAppender(first);
+   child.addAppender(second);
+   parent.addAppender(inherited);
+
+   // formatted by each appender while not shared
+   second->setLayout(new PatternLayout());
+   child.info("alone");
+   bool result = check(layout->formatted == 1 && !layout->isShared(), "not shared");
+   first->popMessage();
+   second->popMessage();
+   inherited->popMessage();
+
+   // once per event for the appenders sharing it, up to the ancestors
+   second->setLayout(layout->share());
+   inherited->setLayout(layout->share());
+   child.info("once");
+   result = check(layout->formatted == 2, "formatted once") && result;
+   result = check(first->popMessage() == "INFO once" && second->popMessage() == "INFO once" &&
+                  inherited->popMessage() == "INFO once", "same text") && result;
+
+   // and per event of a batch
+   vector<string> messages;
+   messages.push_back("one");
+   messages.push_back("two");
+   messages.push_back("three");
+   child.logBatch(Priority::INFO, messages.begin(), messages.end());
+   result = check(layout->formatted == 5, "batch formatted once") && result;
+   result = check(first->queueSize() == 3 && second->queueSize() == 3 && inherited->queueSize() == 3,
+                  "batch appended") && result;
+   result = check(second->popMessage() == "INFO one" && second->popMessage() == "INFO two" &&
+                  second->popMessage() == "INFO three", "batch text") && result;
+
+   // the last appender releasing it deletes the layout
+   child.removeAllAppenders();
+   result = check(!deleted && !layout->isShared(), "still referenced") && result;
+   inherited->setLayout(NULL);
+   result = check(deleted, "deleted") && result;
+
+   result = checkConfigured() && result;
+
+   return result ? 0 : -1;
+}
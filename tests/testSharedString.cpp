@@ -0,0 +1,104 @@
+#include <log4cpp/Category.hh>
+#include <log4cpp/Appender.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/SharedString.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+// keeps a copy of the last event
+class CopyingAppender : public Appender
+{
+   public:
+      CopyingAppender() : Appender("copying"), last(0) {}
+      ~CopyingAppender() { delete last; }
+
+      virtual void doAppend(const LoggingEvent& event)
+      {
+         delete last;
+         last = new LoggingEvent(event);
+         original = &event.message;
+      }
+      virtual bool reopen() { return true; }
+      virtual void close() {}
+      virtual bool requiresLayout() const { return false; }
+      virtual void setLayout(Layout*) {}
+      virtual void setThreshold(Priority::Value) {}
+      virtual Priority::Value getThreshold() { return Priority::NOTSET; }
+      virtual void setFilter(Filter*) {}
+      virtual Filter* getFilter() { return 0; }
+
+      LoggingEvent* last;
+      const std::string* original;
+};
+
+// overrides the std::string overload, as categories did before messages were shared
+class RecordingCategory : public Category
+{
+   public:
+      RecordingCategory() : Category("recording", NULL, Priority::DEBUG), logged(0) {}
+
+      int logged;
+      string last;
+
+   protected:
+      using Category::_logUnconditionally2;
+
+      virtual void _logUnconditionally2(Priority::Value, const std::string& message) throw()
+      {
+         logged++;
+         last = message;
+      }
+};
+
+int main()
+{
+   string value("shared value");
+   SharedString adopted = SharedString::adopt(value);
+   bool result = check(value.empty() && adopted.str() == "shared value", "adopted");
+   SharedString copy(adopted);
+   result = check(&copy.str() == &adopted.str(), "copies share") && result;
+   copy = SharedString();
+   result = check(copy.empty() && copy.str() == "" && adopted.str() == "shared value", "released") && result;
+
+   Category& category = Category::getInstance("shared.category");
+   CopyingAppender* appender = new CopyingAppender();
+   category.setAdditivity(false);
+   category.addAppender(appender);
+
+   NDC::push("outer");
+   NDC::push("inner");
+   category.warnStream() << "streamed";
+   result = check(appender->last->message == "streamed" && appender->last->ndc == "outer inner",
+                  "event contents") && result;
+   result = check(&appender->last->message == appender->original, "copied event shares its message") && result;
+   result = check(&appender->last->categoryName == &category.getName(), "category name interned") && result;
+   result = check(&appender->last->ndc.str() == &NDC::get(), "ndc shared") && result;
+   const std::string* threadName = &appender->last->threadName;
+
+   NDC::pop();
+   category.warn("%s %d", "formatted", 1);
+   result = check(appender->last->message == "formatted 1" && appender->last->ndc == "outer", "formatted event") && result;
+   result = check(&appender->last->threadName == threadName, "thread name cached") && result;
+   NDC::clear();
+
+   // every path still reaches the override
+   RecordingCategory recording;
+   recording.info("plain");
+   result = check(recording.logged == 1 && recording.last == "plain", "string overridden") && result;
+   recording.info("%s %d", "printf", 2);
+   result = check(recording.logged == 2 && recording.last == "printf 2", "printf overridden") && result;
+   recording.infoStream() << "stream " << 3;
+   result = check(recording.logged == 3 && recording.last == "stream 3", "stream overridden") && result;
+#ifdef LOG4CPP_HAVE_VARIADIC_TEMPLATES
+   recording.logf(Priority::INFO, "{} {}", "logf", 4);
+   result = check(recording.logged == 4 && recording.last == "logf 4", "logf overridden") && result;
+#endif
+
+   Category::shutdown();
+   return result ? 0 : -1;
+}
@@ -0,0 +1,186 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_HAVE_SYS_MMAN_H
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/ShmRingAppender.hh>
+#include <log4cpp/ShmRingReader.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PassThroughLayout.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/AppenderSkeleton.hh>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include "ShmRing.hh"
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+static const char* const ring_path = "shmring_test.ring";
+
+// keeps the thread and time of the last event
+class StampAppender : public AppenderSkeleton
+{
+   public:
+      StampAppender() : AppenderSkeleton("stamp") {}
+
+      virtual void close() {}
+      virtual bool requiresLayout() const { return false; }
+      virtual void setLayout(Layout*) {}
+
+      string threadName;
+      TimeStamp timeStamp;
+
+   protected:
+      virtual void _append(const LoggingEvent& event)
+      {
+         threadName = event.threadName;
+         timeStamp = event.timeStamp;
+      }
+};
+
+int main()
+{
+   unlink(ring_path);
+
+   ShmRingAppender* appender = new ShmRingAppender("ring", ring_path, 4096);
+   appender->setLayout(new PassThroughLayout());
+   Category& cat = Category::getInstance("shmring.test");
+   cat.setAdditivity(false);
+   cat.addAppender(appender);
+
+   ShmRingReader reader(ring_path);
+   bool result = check(reader.isOpen(), "reader attaches");
+
+   // nothing there yet
+   result = check(!reader.wait(10), "wait times out on empty ring") && result;
+
+   cat.error("first");
+   cat.info("second");
+   result = check(reader.wait(1000), "wait sees pending frames") && result;
+
+   const char* data;
+   size_t length;
+   Priority::Value priority;
+   result = check(reader.next(data, length, priority) &&
+                  string(data, length) == "first" && priority == Priority::ERROR,
+                  "first frame") && result;
+   reader.release();
+   const char* category;
+   size_t categoryLength;
+   result = check(reader.next(data, length, priority, category, categoryLength) &&
+                  string(data, length) == "second" && priority == Priority::INFO &&
+                  string(category, categoryLength) == "shmring.test",
+                  "second frame") && result;
+   reader.release();
+   result = check(!reader.next(data, length, priority), "ring drained") && result;
+
+   // a stalled consumer makes the producer drop, never block
+   int logged = 0;
+   for (; logged < 1000; logged++) {
+      ostringstream s;
+      s << "message " << logged;
+      cat.warn(s.str());
+   }
+   result = check(appender->getDropped() > 0, "producer dropped") && result;
+   result = check(reader.getDropped() == appender->getDropped(), "drops visible to reader") && result;
+
+   // frames wrap around the end of the data area
+   StringQueueAppender sink("sink");
+   sink.setLayout(new PassThroughLayout());
+   size_t consumed = reader.drainTo(sink, 1000);
+   result = check(consumed == logged - appender->getDropped(), "drained all kept frames") && result;
+   result = check(!sink.getQueue().empty() && sink.getQueue().front() == "message 0", "order kept") && result;
+
+   for (int i = 0; i < 500; i++) {
+      cat.warn("after wrap");
+      result = check(reader.drainTo(sink) == 1, "frame after wrap") && result;
+      if (!result)
+         break;
+   }
+   result = check(sink.getQueue().back() == "after wrap", "wrapped frame content") && result;
+
+   // events drained keep their category, formatted by the producer's layout
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("[%p] %m");
+   appender->setLayout(layout);
+   StringQueueAppender categorized("categorized");
+   PatternLayout* consumerLayout = new PatternLayout();
+   consumerLayout->setConversionPattern("%c: %m");
+   categorized.setLayout(consumerLayout);
+   cat.warn("formatted");
+   result = check(reader.drainTo(categorized) == 1 &&
+                  categorized.getQueue().back() == "shmring.test: [WARN] formatted", "category kept") && result;
+
+   // and the thread and time they were made at
+   appender->doAppend(LoggingEvent("shmring.test", "stamped", "", Priority::INFO, "producer",
+                                   TimeStamp(1234567890, 123456)));
+   StampAppender stamp;
+   result = check(reader.drainTo(stamp) == 1 && stamp.threadName == "producer" &&
+                  stamp.timeStamp.getSeconds() == 1234567890 &&
+                  stamp.timeStamp.getMicroSeconds() == 123456, "thread and time kept") && result;
+
+   // a capacity which is not a power of two is rejected
+   const char* const bad_path = "shmring_test.bad";
+   int fd = open(bad_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+   shmring::Header header;
+   memset(&header, 0, sizeof(header));
+   header.magic = shmring::MAGIC;
+   header.version = shmring::VERSION;
+   header.capacity = 5000;
+   result = check(fd >= 0 && write(fd, &header, sizeof(header)) == sizeof(header) &&
+                  ftruncate(fd, sizeof(header) + 5000) == 0, "bad ring written") && result;
+   close(fd);
+   ShmRingReader badReader(bad_path);
+   result = check(!badReader.isOpen(), "bad capacity rejected") && result;
+
+   // a frame running past the end of the ring is not read
+   fd = open(bad_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+   header.capacity = 4096;
+   header.head = 64;
+   shmring::FrameHeader frame;
+   memset(&frame, 0, sizeof(frame));
+   frame.length = 100000;
+   result = check(fd >= 0 && write(fd, &header, sizeof(header)) == sizeof(header) &&
+                  write(fd, &frame, sizeof(frame)) == sizeof(frame) &&
+                  ftruncate(fd, sizeof(header) + 4096) == 0, "corrupt ring written") && result;
+   close(fd);
+   ShmRingReader corruptReader(bad_path);
+   result = check(corruptReader.isOpen() && !corruptReader.isCorrupt(), "corrupt ring opened") && result;
+   result = check(!corruptReader.next(data, length, priority) && corruptReader.isCorrupt(),
+                  "corrupt frame rejected") && result;
+   result = check(corruptReader.drainTo(sink) == 0 && !corruptReader.wait(1000), "corrupt ring not drained") && result;
+   unlink(bad_path);
+
+   // anonymous ring handed over by descriptor
+   ShmRingAppender anonymous("anonymous", "");
+   anonymous.setLayout(new PassThroughLayout());
+#ifdef LOG4CPP_HAVE_MEMFD_CREATE
+   ShmRingReader fdReader(anonymous.getFd());
+   anonymous.doAppend(LoggingEvent("cat", "over memfd", "", Priority::NOTICE));
+   result = check(fdReader.next(data, length, priority) &&
+                  string(data, length) == "over memfd" && priority == Priority::NOTICE,
+                  "memfd ring") && result;
+#endif
+
+   Category::shutdown();
+   unlink(ring_path);
+
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_MMAN_H
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "ShmRingAppender not available on this platform.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_MMAN_H
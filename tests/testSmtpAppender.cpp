@@ -0,0 +1,137 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#if defined(LOG4CPP_HAVE_BOOST)
+#include <boost/version.hpp>
+#endif
+
+#if defined(LOG4CPP_HAVE_BOOST) && BOOST_VERSION >= 103500
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/SmtpAppender.hh>
+#include <log4cpp/SimpleLayout.hh>
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+#include <string>
+#include <vector>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+using boost::asio::ip::tcp;
+
+// a local SMTP stand-in, serving a single connection
+struct smtp_server
+{
+   smtp_server() : acceptor_(io_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)), connections_(0) {}
+
+   unsigned short port() { return acceptor_.local_endpoint().port(); }
+
+   void operator()()
+   {
+      try
+      {
+         tcp::iostream s;
+         acceptor_.accept(*s.rdbuf());
+         ++connections_;
+         s << "220 stand-in\r\n" << flush;
+         string line, data;
+         bool in_data = false;
+         while (getline(s, line))
+         {
+            if (in_data)
+            {
+               if (line == ".\r")
+               {
+                  mails_.push_back(data);
+                  data.clear();
+                  in_data = false;
+                  s << "250 queued\r\n" << flush;
+               }
+               else
+               {
+                  data += line + "\n";
+               }
+            }
+            else if (line.compare(0, 4, "EHLO") == 0)
+               s << "250-stand-in\r\n250 PIPELINING\r\n" << flush;
+            else if (line.compare(0, 4, "DATA") == 0)
+            {
+               in_data = true;
+               s << "354 go ahead\r\n" << flush;
+            }
+            else if (line.compare(0, 4, "QUIT") == 0)
+            {
+               s << "221 bye\r\n" << flush;
+               break;
+            }
+            else
+               s << "250 ok\r\n" << flush;
+         }
+      }
+      catch (const std::exception&)
+      {
+      }
+   }
+
+   boost::asio::io_service io_;
+   tcp::acceptor acceptor_;
+   int connections_;
+   vector<string> mails_;
+};
+
+int main()
+{
+   smtp_server server;
+   boost::thread server_thread(boost::ref(server));
+
+   Category& cat = Category::getInstance("smtp.test");
+   cat.setAdditivity(false);
+   SmptAppender* digest = new SmptAppender("digest", "127.0.0.1", "log@localhost", "ops@localhost",
+                                           "alert", server.port());
+   digest->setLayout(new SimpleLayout());
+   digest->setDigest(5, 3600);
+   cat.addAppender(digest);
+
+   SmptAppender* bounded = new SmptAppender("bounded", "127.0.0.1", "log@localhost", "ops@localhost",
+                                            "bounded", server.port());
+   bounded->setLayout(new SimpleLayout());
+   bounded->setDigest(100, 3600);
+   bounded->setMaxQueued(4);
+   Category& other = Category::getInstance("smtp.bounded");
+   other.setAdditivity(false);
+   other.addAppender(bounded);
+
+   for (int i = 0; i < 12; i++)
+      cat.error("event");
+   cat.error("two lines\n.second line starts with a dot");
+   for (int i = 0; i < 10; i++)
+      other.error("bounded event");
+
+   bool result = check(bounded->getDropped() == 6, "queue bounded");
+
+   // the open digests are mailed at shutdown
+   Category::shutdown();
+   server_thread.join();
+
+   result = check(server.mails_.size() == 4, "mail count") && result;
+   result = check(server.connections_ == 1, "connection reused") && result;
+   if (server.mails_.size() == 4)
+   {
+      result = check(server.mails_[0].find("Subject: alert (5 events)") != string::npos, "digest subject") && result;
+      result = check(server.mails_[2].find("\n..second line") != string::npos, "dot stuffing") && result;
+   }
+
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_BOOST
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "SmtpAppender not available in this build.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_BOOST
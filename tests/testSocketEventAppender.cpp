@@ -0,0 +1,226 @@
+#include <log4cpp/Portability.hh>
+#include <iostream>
+
+#ifdef LOG4CPP_HAVE_SYS_UN_H
+
+#include <log4cpp/Category.hh>
+#include <log4cpp/SocketEventAppender.hh>
+#include <log4cpp/EventCodec.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/NDC.hh>
+#include <log4cpp/MDC.hh>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+static const char* const socket_path = "socket_event_test.socket";
+
+int open_listener()
+{
+   unlink(socket_path);
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0)
+      return -1;
+
+   struct sockaddr_un address;
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+   if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(fd, 1) < 0)
+   {
+      close(fd);
+      return -1;
+   }
+
+   return fd;
+}
+
+// reads everything currently available on the connection
+string receive(int fd)
+{
+   string result;
+   char buffer[4096];
+   ssize_t n;
+   fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+   while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+      result.append(buffer, n);
+   return result;
+}
+
+// waits up to a second for data on the connection
+bool wait_readable(int fd)
+{
+   struct pollfd pollfd;
+   pollfd.fd = fd;
+   pollfd.events = POLLIN;
+   return poll(&pollfd, 1, 1000) == 1;
+}
+
+bool test_stream(EventCodec::Compression compression, int listener)
+{
+   Category& cat = Category::getInstance("forwarded.test");
+   cat.setAdditivity(false);
+   cat.setPriority(Priority::DEBUG);
+   SocketEventAppender* appender = new SocketEventAppender("forward", string("unix:") + socket_path,
+                                                           compression, 1024);
+   cat.addAppender(appender);
+   int connection = accept(listener, NULL, NULL);
+   bool result = check(connection >= 0, "connected");
+
+   // batched until the batch size is reached or an error is logged
+   NDC::push("ndc1");
+   MDC::put("tenant", "acme");
+   cat.info("first");
+   MDC::clear();
+   NDC::clear();
+   result = check(receive(connection).empty(), "info is batched") && result;
+   for (int i = 0; i < 20; i++)
+      cat.debug("filler message, filler message, filler message");
+   cat.error("last");
+
+   result = check(appender->flush(), "flushed") && result;
+   string stream = receive(connection);
+   result = check(!stream.empty(), "batch sent") && result;
+
+   // fed in small pieces, as read from a socket
+   EventStreamDecoder decoder;
+   std::auto_ptr<LoggingEvent> event;
+   int count = 0;
+   for (size_t i = 0; i < stream.size(); i += 7) {
+      decoder.feed(stream.data() + i, min<size_t>(7, stream.size() - i));
+      while (decoder.next(event)) {
+         if (count == 0) {
+            result = check(event->categoryName == "forwarded.test" && event->message == "first" &&
+                           event->ndc == "ndc1" && event->mdc.get("tenant") == "acme" &&
+                           event->mdc.size() == 1 && event->priority == Priority::INFO &&
+                           !event->threadName.empty() && event->timeStamp.getSeconds() > 0,
+                           "first event") && result;
+         }
+         count++;
+      }
+   }
+   result = check(!decoder.isCorrupt() && count == 22 && event->message == "last", "all events decoded") && result;
+
+   // small batches are sent once the batch delay passed
+   appender->setBatchDelay(50);
+   cat.info("delayed");
+   result = check(wait_readable(connection), "batch delay") && result;
+   usleep(100000);
+   stream = receive(connection);
+   decoder.feed(stream.data(), stream.size());
+   result = check(decoder.next(event) && event->message == "delayed", "delayed event") && result;
+   result = check(appender->getDropped() == 0, "nothing dropped") && result;
+
+   cat.removeAllAppenders();
+   close(connection);
+   return result;
+}
+
+void put32(string& buffer, size_t value)
+{
+   for (int i = 0; i < 4; i++)
+      buffer += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+void putString(string& buffer, const string& value)
+{
+   put32(buffer, value.size());
+   buffer += value;
+}
+
+// a version 1 block, from before records carried the MDC
+string version1_block()
+{
+   string record;
+   put32(record, Priority::WARN);
+   record.append(8, '\0');
+   put32(record, 0);
+   putString(record, "old.cat");
+   putString(record, "thread");
+   putString(record, "");
+   putString(record, "old message");
+   string records;
+   put32(records, record.size());
+   records += record;
+
+   string block("L4EB\x01\0\0\0", 8);
+   put32(block, records.size());
+   put32(block, records.size());
+   return block + records;
+}
+
+int main()
+{
+   int listener = open_listener();
+   if (listener < 0)
+   {
+      cout << "Can't bind local listener socket '" << socket_path << "'.\n";
+      return -1;
+   }
+
+   bool result = test_stream(EventCodec::NONE, listener);
+   if (EventCodec::isSupported(EventCodec::ZLIB))
+      result = test_stream(EventCodec::ZLIB, listener) && result;
+
+   // decoded events feed the local hierarchy, formatted by its layouts
+   string records, stream;
+   EventCodec::encode(LoggingEvent("remote.cat", "remote message", "", Priority::WARN), records);
+   EventCodec::encode(LoggingEvent("remote.cat", "filtered", "", Priority::DEBUG), records);
+   EventCodec::encodeBlock(records, EventCodec::NONE, stream);
+
+   Category& remote = Category::getInstance("remote.cat");
+   remote.setAdditivity(false);
+   remote.setPriority(Priority::INFO);
+   StringQueueAppender* queue = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%c %p %m");
+   queue->setLayout(layout);
+   remote.addAppender(queue);
+
+   EventStreamDecoder decoder;
+   decoder.feed(stream.data(), stream.size());
+   result = check(decoder.dispatch() == 2, "dispatched") && result;
+   result = check(queue->queueSize() == 1 && queue->getQueue().front() == "remote.cat WARN remote message",
+                  "formatted by receiver") && result;
+
+   // blocks of older senders are still understood
+   string old = version1_block();
+   EventStreamDecoder oldDecoder;
+   std::auto_ptr<LoggingEvent> oldEvent;
+   oldDecoder.feed(old.data(), old.size());
+   result = check(oldDecoder.next(oldEvent) && oldEvent->message == "old message" &&
+                  oldEvent->mdc.empty() && !oldDecoder.isCorrupt(), "version 1 block") && result;
+
+   // garbage is detected
+   EventStreamDecoder garbage;
+   std::auto_ptr<LoggingEvent> event;
+   garbage.feed("0123456789abcdefghij", 20);
+   result = check(!garbage.next(event) && garbage.isCorrupt(), "corrupt stream") && result;
+
+   Category::shutdown();
+   close(listener);
+   unlink(socket_path);
+
+   return result ? 0 : -1;
+}
+
+#else // LOG4CPP_HAVE_SYS_UN_H
+
+// 77 tells the test harness that the test was skipped
+int main()
+{
+   std::cout << "SocketEventAppender not available on this platform.\n";
+   return 77;
+}
+
+#endif // LOG4CPP_HAVE_SYS_UN_H
@@ -0,0 +1,69 @@
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/StringQueueAppender.hh>
+#include <log4cpp/PatternLayout.hh>
+#include <log4cpp/threading/ThreadIdentity.hh>
+#include <iostream>
+#include <sstream>
+#include <string>
+#ifdef LOG4CPP_HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef LOG4CPP_USE_PTHREADS
+#include <pthread.h>
+#endif
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+#ifdef LOG4CPP_USE_PTHREADS
+void* worker(void* argument)
+{
+   threading::setThreadName("worker");
+   static_cast<Category*>(argument)->info("from worker");
+   return NULL;
+}
+#endif
+
+int main()
+{
+   Category& category = Category::getInstance("thread.identity");
+   StringQueueAppender* appender = new StringQueueAppender("queue");
+   PatternLayout* layout = new PatternLayout();
+   layout->setConversionPattern("%t|%t{tid}|%m");
+   appender->setLayout(layout);
+   category.setAdditivity(false);
+   category.addAppender(appender);
+
+   const std::string id = threading::getThreadId();
+   category.info("unnamed");
+   bool result = check(appender->popMessage().find(id + "|") == 0, "defaults to the thread id");
+   result = check(&threading::getThreadName().str() == &threading::getThreadName().str(), "cached") && result;
+
+   threading::setThreadName("main");
+   category.info("named");
+   std::string message = appender->popMessage();
+   result = check(message.find("main|") == 0, "named") && result;
+#if defined(__linux__) && defined(LOG4CPP_HAVE_UNISTD_H)
+   // the main thread has the process id
+   std::ostringstream pid;
+   pid << "|" << getpid() << "|";
+   result = check(message.find(pid.str()) != std::string::npos, "system thread id") && result;
+#endif
+
+#ifdef LOG4CPP_USE_PTHREADS
+   pthread_t thread;
+   pthread_create(&thread, NULL, &worker, &category);
+   pthread_join(thread, NULL);
+   message = appender->popMessage();
+   result = check(message.find("worker|") == 0 && message.find("|from worker") != std::string::npos, "per thread") && result;
+#endif
+
+   threading::setThreadName("");
+   category.info("reset");
+   result = check(appender->popMessage().find(id + "|") == 0, "back to the id") && result;
+
+   Category::shutdown();
+   return result ? 0 : -1;
+}
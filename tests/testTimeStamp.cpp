@@ -0,0 +1,84 @@
+#include <log4cpp/TimeStamp.hh>
+#include <log4cpp/LoggingEvent.hh>
+#include <log4cpp/PatternLayout.hh>
+#include "TscCalibration.hh"
+#include <iostream>
+#include <string>
+#include "Check.hh"
+
+using namespace log4cpp;
+using namespace std;
+
+string format(const char* pattern, const TimeStamp& stamp)
+{
+   PatternLayout layout;
+   layout.setConversionPattern(pattern);
+   return layout.format(LoggingEvent("category", "message", "", Priority::INFO, "thread", stamp));
+}
+
+// stamps read from the current clock are close to the wall clock and in order
+bool checkClock(const char* name, int64_t tolerance)
+{
+   bool result = true;
+   TimeStamp previous;
+   for (int i = 0; i < 100000; i++)
+   {
+      TimeStamp stamp;
+      if (stamp.getNanoSecondsSinceEpoch() < previous.getNanoSecondsSinceEpoch() - tolerance)
+         result = false;
+      previous = stamp;
+   }
+   TimeStamp::Clock clock = TimeStamp::getClock();
+   TimeStamp::setClock(TimeStamp::REALTIME);
+   int64_t difference = TimeStamp().getNanoSecondsSinceEpoch() - previous.getNanoSecondsSinceEpoch();
+   TimeStamp::setClock(clock);
+   result = result && difference > -tolerance && difference < tolerance;
+   if (!result)
+      cout << "failed: " << name << " clock, off by " << difference << "ns\n";
+   return result;
+}
+
+// a wall clock step between two synchronizations moves the offset only
+bool checkStep()
+{
+   // 3 ticks per nanosecond
+   tsc::Sample base = { 1000000000000ULL, 5000000000LL, 1700000000000000000LL };
+   tsc::Sample steady = { base.ticks + 3000000000ULL, base.monotonic + 1000000000LL,
+                          base.realtime + 1000000000LL };
+   tsc::Sample stepped = steady;
+   stepped.realtime -= 3600000000000LL;
+
+   uint64_t scale = tsc::measureScale(base, stepped);
+   bool result = check(scale != 0 && scale == tsc::measureScale(base, steady), "rate unaffected by step");
+   int64_t later = tsc::toNanoSeconds(stepped, scale, stepped.ticks + 3000000);
+   result = check(later - stepped.realtime > 999000 && later - stepped.realtime < 1001000,
+                  "offset follows step") && result;
+   result = check(tsc::measureScale(steady, base) == 0, "out of order") && result;
+   return result;
+}
+
+int main()
+{
+   // beyond 2038
+   TimeStamp late = TimeStamp::fromNanoSeconds(4102444800123456789LL);
+   bool result = check(late.getSeconds() == 4102444800LL && late.getMilliSeconds() == 123 &&
+                       late.getMicroSeconds() == 123456 && late.getNanoSeconds() == 123456789, "nanoseconds");
+   result = check(TimeStamp(1, 2).getNanoSecondsSinceEpoch() == 1000002000LL, "from microseconds") && result;
+
+   result = check(format("%d{%S,%l}", late) == "00,123", "milliseconds") && result;
+   result = check(format("%d{%S.%us}", late) == "00.123456", "microseconds") && result;
+   result = check(format("%d{%S.%ns|%M}", late) == "00.123456789|00", "nanoseconds") && result;
+
+   TimeStamp later = TimeStamp::fromNanoSeconds(TimeStamp::getStartTime().getNanoSecondsSinceEpoch() + 2003004005LL);
+   result = check(format("%r|%r{ms}|%r{us}|%r{ns}", later) == "2003|2003|2003004|2003004005", "since start") && result;
+
+   result = checkStep() && result;
+   result = checkClock("realtime", 1000000) && result;
+   if (TimeStamp::setClock(TimeStamp::REALTIME_COARSE) == TimeStamp::REALTIME_COARSE)
+      result = checkClock("coarse", 100000000) && result;
+   if (TimeStamp::setClock(TimeStamp::TSC) == TimeStamp::TSC)
+      result = checkClock("tsc", 1000000) && result;
+   TimeStamp::setClock(TimeStamp::REALTIME);
+
+   return result ? 0 : -1;
+}
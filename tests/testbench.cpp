@@ -160,7 +160,7 @@ int main(int argc, char* argv[])
 
     {
 	clock.start();
-	for (int i = 0; i < count; i++) fprintf(stderr, "%d ERROR someCategory : %s\n", log4cpp::TimeStamp().getSeconds(), buffer);
+	for (int i = 0; i < count; i++) fprintf(stderr, "%d ERROR someCategory : %s\n", (int)log4cpp::TimeStamp().getSeconds(), buffer);
 	clock.stop();
 	std::cout << std::endl << "  fprintf:        " << ((float)clock.elapsed()) / count << " us" << std::endl;
     }
@@ -0,0 +1,412 @@
+/*
+ * log4cpp-collectd.cpp
+ *
+ * Copyright 2026, Log4cpp Project. All rights reserved.
+ *
+ * See the COPYING file for the terms of usage and distribution.
+ *
+ * A log collector: receives events forwarded by SocketEventAppender over
+ * TCP or Unix domain sockets and syslog messages over UDP, and routes them
+ * into a log4cpp hierarchy configured with the PropertyConfigurator.
+ */
+
+#include <log4cpp/Portability.hh>
+#include <log4cpp/Category.hh>
+#include <log4cpp/EventCodec.hh>
+#include <log4cpp/SocketEventAppender.hh>
+#include <log4cpp/PropertyConfigurator.hh>
+#include <log4cpp/TimeStamp.hh>
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <iostream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+using namespace log4cpp;
+
+namespace {
+
+    volatile sig_atomic_t stopping = 0;
+
+    void stop(int) {
+        stopping = 1;
+    }
+
+    enum SourceType { STREAM_LISTENER, STREAM, SYSLOG };
+
+    struct Source {
+        Source(SourceType type, int fd) : type(type), fd(fd) {}
+        SourceType type;
+        int fd;
+        EventStreamDecoder decoder;
+    };
+
+    /* counts the events routed, for the benchmark */
+    unsigned long long received = 0;
+
+    void setNonBlocking(int fd) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    /* "unix:path" or "[host:]port" */
+    int openSocket(const std::string& address, int type) {
+        int fd = -1;
+        if (address.compare(0, 5, "unix:") == 0) {
+            struct sockaddr_un sun;
+            std::memset(&sun, 0, sizeof(sun));
+            sun.sun_family = AF_UNIX;
+            std::strncpy(sun.sun_path, address.c_str() + 5, sizeof(sun.sun_path) - 1);
+            ::unlink(sun.sun_path);
+            fd = ::socket(AF_UNIX, type, 0);
+            if (fd >= 0 && ::bind(fd, (struct sockaddr*)&sun, sizeof(sun)) < 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        } else {
+            std::string::size_type colon = address.rfind(':');
+            std::string host = (colon == std::string::npos) ? "" : address.substr(0, colon);
+            std::string port = (colon == std::string::npos) ? address : address.substr(colon + 1);
+
+            struct addrinfo hints;
+            std::memset(&hints, 0, sizeof(hints));
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = type;
+            hints.ai_flags = AI_PASSIVE;
+            struct addrinfo* addresses;
+            if (::getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &addresses) != 0)
+                return -1;
+
+            for (struct addrinfo* a = addresses; a && fd < 0; a = a->ai_next) {
+                fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+                int on = 1;
+                if (fd >= 0 && (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0 ||
+                                ::bind(fd, a->ai_addr, a->ai_addrlen) < 0)) {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            ::freeaddrinfo(addresses);
+        }
+
+        if (fd >= 0 && type == SOCK_STREAM && ::listen(fd, SOMAXCONN) < 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        if (fd >= 0) {
+            setNonBlocking(fd);
+        }
+        return fd;
+    }
+
+    /* one epoll loop; several may run, one per thread */
+    class Worker {
+        public:
+        Worker(const std::vector<Source*>& listeners) :
+            _epoll(::epoll_create(64)),
+            _listeners(listeners),
+            _received(0) {
+            for (std::vector<Source*>::const_iterator i = listeners.begin(); i != listeners.end(); ++i) {
+                struct epoll_event event;
+                event.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+                // wake one worker per incoming connection or datagram
+                event.events |= EPOLLEXCLUSIVE;
+#endif
+                event.data.ptr = *i;
+                ::epoll_ctl(_epoll, EPOLL_CTL_ADD, (*i)->fd, &event);
+            }
+        }
+
+        ~Worker() {
+            for (std::map<int, Source*>::iterator i = _streams.begin(); i != _streams.end(); ++i) {
+                ::close(i->first);
+                delete i->second;
+            }
+            ::close(_epoll);
+        }
+
+        void run() {
+            struct epoll_event events[64];
+            while (!stopping) {
+                int n = ::epoll_wait(_epoll, events, 64, 200);
+                for (int i = 0; i < n; i++) {
+                    Source* source = static_cast<Source*>(events[i].data.ptr);
+                    switch (source->type) {
+                    case STREAM_LISTENER:
+                        _accept(source);
+                        break;
+                    case STREAM:
+                        _read(source);
+                        break;
+                    case SYSLOG:
+                        _readSyslog(source);
+                        break;
+                    }
+                }
+                __sync_fetch_and_add(&received, _received);
+                _received = 0;
+            }
+        }
+
+        private:
+        void _accept(Source* listener) {
+            int fd;
+            while ((fd = ::accept(listener->fd, NULL, NULL)) >= 0) {
+                setNonBlocking(fd);
+                Source* source = new Source(STREAM, fd);
+                struct epoll_event event;
+                event.events = EPOLLIN;
+                event.data.ptr = source;
+                ::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event);
+                _streams[fd] = source;
+            }
+        }
+
+        void _close(Source* source) {
+            ::epoll_ctl(_epoll, EPOLL_CTL_DEL, source->fd, NULL);
+            ::close(source->fd);
+            _streams.erase(source->fd);
+            delete source;
+        }
+
+        void _read(Source* source) {
+            // bounded, so that one busy connection does not starve the others
+            for (int i = 0; i < 16; i++) {
+                ssize_t n = ::read(source->fd, _buffer, sizeof(_buffer));
+                if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                    return;
+                if (n <= 0) {
+                    _close(source);
+                    return;
+                }
+
+                source->decoder.feed(_buffer, n);
+                std::auto_ptr<LoggingEvent> event;
+                while (source->decoder.next(event)) {
+                    _route(*event);
+                }
+                if (source->decoder.isCorrupt()) {
+                    _close(source);
+                    return;
+                }
+            }
+        }
+
+        /* RFC 3164 / 5424 datagrams: only the PRI part is interpreted */
+        void _readSyslog(Source* source) {
+            for (int i = 0; i < 64; i++) {
+                ssize_t n = ::recv(source->fd, _buffer, sizeof(_buffer), 0);
+                if (n <= 0)
+                    return;
+
+                const char* p = _buffer;
+                const char* end = _buffer + n;
+                int pri = -1;
+                if (p < end && *p == '<') {
+                    pri = 0;
+                    for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+                        pri = pri * 10 + (*p - '0');
+                    }
+                    if (p < end && *p == '>') {
+                        p++;
+                    } else {
+                        p = _buffer;
+                        pri = -1;
+                    }
+                }
+                while (end > p && (end[-1] == '\n' || end[-1] == '\0')) {
+                    end--;
+                }
+
+                // severities 0 (emerg) .. 7 (debug) map to the log4cpp priorities
+                Priority::Value priority = (pri < 0) ? Priority::NOTICE : (pri & 7) * 100;
+                _route(LoggingEvent("syslog", std::string(p, end - p), "", priority));
+            }
+        }
+
+        void _route(const LoggingEvent& event) {
+            std::map<std::string, Category*>::iterator i = _categories.find(event.categoryName);
+            if (i == _categories.end()) {
+                i = _categories.insert(std::make_pair(event.categoryName,
+                                                      &Category::getInstance(event.categoryName))).first;
+            }
+            if (i->second->isPriorityEnabled(event.priority)) {
+                i->second->callAppenders(event);
+            }
+            _received++;
+        }
+
+        int _epoll;
+        std::vector<Source*> _listeners;
+        std::map<int, Source*> _streams;
+        std::map<std::string, Category*> _categories;
+        unsigned long long _received;
+        char _buffer[65536];
+    };
+
+    void* runWorker(void* worker) {
+        static_cast<Worker*>(worker)->run();
+        return NULL;
+    }
+
+    struct Client {
+        std::string address;
+        long events;
+        EventCodec::Compression compression;
+        unsigned long dropped;
+    };
+
+    void* runClient(void* arg) {
+        Client* client = static_cast<Client*>(arg);
+        SocketEventAppender appender("bench", client->address, client->compression);
+        appender.setFlushPriority(Priority::EMERG - 1);
+        std::string message(100, 'x');
+        for (long i = 0; i < client->events; i++) {
+            appender.doAppend(LoggingEvent("bench.client", message, "", Priority::INFO));
+        }
+        appender.close();
+        client->dropped = appender.getDropped();
+        return NULL;
+    }
+
+    void usage() {
+        std::cerr <<
+            "usage: log4cpp-collectd [options]\n"
+            "  -c file        PropertyConfigurator file defining the hierarchy\n"
+            "  -l address     listen for forwarded events, \"[host:]port\" or \"unix:path\"\n"
+            "  -s address     listen for syslog datagrams, \"[host:]port\" or \"unix:path\"\n"
+            "  -w workers     number of event loops (default 1)\n"
+            "  -b events      benchmark: route events sent by local clients and exit\n"
+            "  -n clients     number of benchmark clients (default 4)\n"
+            "  -z             benchmark clients compress their batches\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string config;
+    std::vector<std::string> streamAddresses, syslogAddresses;
+    int workerCount = 1;
+    long benchEvents = 0;
+    int clientCount = 4;
+    bool compress = false;
+
+    int option;
+    while ((option = ::getopt(argc, argv, "c:l:s:w:b:n:z")) != -1) {
+        switch (option) {
+        case 'c': config = optarg; break;
+        case 'l': streamAddresses.push_back(optarg); break;
+        case 's': syslogAddresses.push_back(optarg); break;
+        case 'w': workerCount = std::atoi(optarg); break;
+        case 'b': benchEvents = std::atol(optarg); break;
+        case 'n': clientCount = std::atoi(optarg); break;
+        case 'z': compress = true; break;
+        default: usage(); return 2;
+        }
+    }
+
+    if (benchEvents > 0 && streamAddresses.empty()) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "unix:/tmp/log4cpp-collectd-bench.%d", static_cast<int>(::getpid()));
+        streamAddresses.push_back(path);
+    }
+    if ((streamAddresses.empty() && syslogAddresses.empty()) || workerCount < 1 || clientCount < 1) {
+        usage();
+        return 2;
+    }
+
+    try {
+        if (!config.empty()) {
+            PropertyConfigurator::configure(config);
+        }
+    } catch (ConfigureFailure& e) {
+        std::cerr << "log4cpp-collectd: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<Source*> listeners;
+    for (size_t i = 0; i < streamAddresses.size() + syslogAddresses.size(); i++) {
+        bool stream = i < streamAddresses.size();
+        const std::string& address = stream ? streamAddresses[i] : syslogAddresses[i - streamAddresses.size()];
+        int fd = openSocket(address, stream ? SOCK_STREAM : SOCK_DGRAM);
+        if (fd < 0) {
+            std::cerr << "log4cpp-collectd: cannot listen on " << address << ": "
+                      << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        listeners.push_back(new Source(stream ? STREAM_LISTENER : SYSLOG, fd));
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<Worker*> workers;
+    std::vector<pthread_t> threads(workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(new Worker(listeners));
+        ::pthread_create(&threads[i], NULL, runWorker, workers[i]);
+    }
+
+    if (benchEvents > 0) {
+        TimeStamp start;
+        std::vector<Client> clients(clientCount);
+        std::vector<pthread_t> clientThreads(clientCount);
+        for (int i = 0; i < clientCount; i++) {
+            clients[i].address = streamAddresses[0];
+            clients[i].events = benchEvents / clientCount;
+            clients[i].compression = compress ? EventCodec::ZLIB : EventCodec::NONE;
+            clients[i].dropped = 0;
+            ::pthread_create(&clientThreads[i], NULL, runClient, &clients[i]);
+        }
+        unsigned long long expected = (benchEvents / clientCount) * clientCount;
+        for (int i = 0; i < clientCount; i++) {
+            ::pthread_join(clientThreads[i], NULL);
+            expected -= clients[i].dropped;
+        }
+
+        for (int i = 0; i < 100 && __sync_fetch_and_add(&received, 0) < expected; i++) {
+            ::usleep(50000);
+        }
+        TimeStamp end;
+        stopping = 1;
+
+        double seconds = (end.getSeconds() - start.getSeconds()) +
+                         (end.getMicroSeconds() - start.getMicroSeconds()) / 1e6;
+        unsigned long long routed = __sync_fetch_and_add(&received, 0);
+        std::cout << routed << " of " << expected << " events routed in " << seconds << " s, "
+                  << static_cast<unsigned long long>(routed / seconds) << " events/s" << std::endl;
+    }
+
+    for (int i = 0; i < workerCount; i++) {
+        ::pthread_join(threads[i], NULL);
+        delete workers[i];
+    }
+    for (size_t i = 0; i < listeners.size(); i++) {
+        ::close(listeners[i]->fd);
+        delete listeners[i];
+    }
+    for (size_t i = 0; i < streamAddresses.size() + syslogAddresses.size(); i++) {
+        const std::string& address = i < streamAddresses.size() ? streamAddresses[i] : syslogAddresses[i - streamAddresses.size()];
+        if (address.compare(0, 5, "unix:") == 0) {
+            ::unlink(address.c_str() + 5);
+        }
+    }
+
+    Category::shutdown();
+    return 0;
+}